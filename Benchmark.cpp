@@ -0,0 +1,1270 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Micro-benchmarks for the bistro data structures. Built by `make bench`.
+ *
+ * Global operator new/delete are replaced in this translation unit so every
+ * benchmark can report heap allocations and bytes per operation next to ns/op.
+ *
+ * Usage: benchmark [--filter TEXT] [--json FILE]
+ *   --filter TEXT  runs only the benchmarks whose name contains TEXT
+ *   --json FILE    also writes the results to FILE as JSON, for diffing runs
+ */
+
+#include "Appetizer.hpp"
+#include "ConcurrentList.hpp"
+#include "Dessert.hpp"
+#include "IntrusiveList.hpp"
+#include "KitchenStation.hpp"
+#include "LinkedList.hpp"
+#include "MainCourse.hpp"
+#include "MpmcQueue.hpp"
+#include "StationManager.hpp"
+#include "UnrolledLinkedList.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<unsigned long long> g_allocations(0);
+std::atomic<unsigned long long> g_allocated_bytes(0);
+
+struct Counter {
+    std::string name;
+    double per_op;
+};
+
+struct BenchResult {
+    double ns_per_op;
+    double allocs_per_op;
+    double bytes_per_op;
+    // optional case-specific counts, each reported as <name>/op
+    std::vector<Counter> counters;
+};
+
+// Runs body(ops) once and reports the time and allocations per operation.
+template <class Body>
+BenchResult measure(long ops, Body body) {
+    unsigned long long allocs_before = g_allocations;
+    unsigned long long bytes_before = g_allocated_bytes;
+    auto start = std::chrono::steady_clock::now();
+    body(ops);
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    return BenchResult{ns / ops, double(g_allocations - allocs_before) / ops,
+                       double(g_allocated_bytes - bytes_before) / ops};
+}
+
+struct NamedResult {
+    std::string name;
+    BenchResult result;
+};
+
+std::vector<NamedResult> g_results;
+std::string g_filter;
+
+// Runs the benchmark `name` unless the filter excludes it, prints its result
+// and keeps it for the JSON report.
+template <class Case>
+void run(const std::string& name, Case bench_case) {
+    if (name.find(g_filter) == std::string::npos) {
+        return;
+    }
+    BenchResult result = bench_case();
+    std::printf("%-40s %10.2f ns/op %8.3f allocs/op %9.1f B/op", name.c_str(), result.ns_per_op,
+                result.allocs_per_op, result.bytes_per_op);
+    for (const Counter& counter : result.counters) {
+        std::printf(" %8.3f %s/op", counter.per_op, counter.name.c_str());
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+    g_results.push_back(NamedResult{name, result});
+}
+
+// Writes every result kept by run() as
+// {"context": {...}, "benchmarks": [{"name", "ns_per_op", "allocs_per_op", "bytes_per_op"}, ...]},
+// plus "<name>_per_op" for each counter a case reports.
+bool writeJson(const std::string& path) {
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (out == nullptr) {
+        return false;
+    }
+#ifdef STATION_LIST_UNROLLED
+    const char* station_list = "unrolled";
+#elif defined(STATION_LIST_INTRUSIVE)
+    const char* station_list = "intrusive";
+#else
+    const char* station_list = "linked";
+#endif
+    std::fprintf(out, "{\n  \"context\": {\"station_list\": \"%s\"},\n  \"benchmarks\": [", station_list);
+    for (std::size_t i = 0; i < g_results.size(); i++) {
+        const BenchResult& result = g_results[i].result;
+        std::fprintf(out, "%s\n    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f, \"bytes_per_op\": %.1f",
+                     i == 0 ? "" : ",", g_results[i].name.c_str(), result.ns_per_op,
+                     result.allocs_per_op, result.bytes_per_op);
+        for (const Counter& counter : result.counters) {
+            std::fprintf(out, ", \"%s_per_op\": %.4f", counter.name.c_str(), counter.per_op);
+        }
+        std::fprintf(out, "}");
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+    return std::fclose(out) == 0;
+}
+
+// Keeps the work of size-parameterized cases bounded: about `budget` element
+// visits in total, but never fewer than 1000 operations.
+long opsFor(long budget, int size) {
+    long ops = budget / (size > 0 ? size : 1);
+    return ops < 1000 ? 1000 : ops;
+}
+
+// Insert and remove at the head of a list that holds `resident` entries.
+template <class List>
+BenchResult frontChurn(int resident, long ops) {
+    List list;
+    for (int i = 0; i < resident; i++) {
+        list.insert(0, i);
+    }
+    return measure(ops, [&](long n) {
+        for (long i = 0; i < n; i += 2) {
+            list.insert(0, int(i));
+            list.remove(0);
+        }
+    });
+}
+
+// Fill a list to `length` entries, then clear it, over and over.
+template <class List>
+BenchResult buildAndClear(int length, long ops) {
+    List list;
+    return measure(ops, [&](long n) {
+        long done = 0;
+        while (done < n) {
+            for (int i = 0; i < length && done < n; i++, done++) {
+                list.insert(0, i);
+            }
+            list.clear();
+        }
+    });
+}
+
+// Walk a list whose nodes were allocated interleaved with other heap traffic.
+template <class List>
+BenchResult traverseAfterChurn(int length, long ops) {
+    List list;
+    std::string* noise[64] = {};
+    for (int i = 0; i < length; i++) {
+        list.insert(0, i);
+        delete noise[i % 64];
+        noise[i % 64] = new std::string(32 + i % 48, 'x');
+    }
+    for (std::string* s : noise) {
+        delete s;
+    }
+    long long sum = 0;
+    BenchResult result = measure(ops, [&](long n) {
+        for (long done = 0; done < n; done += length) {
+            for (Node<int>* cur = list.getHeadNode(); cur != nullptr; cur = cur->getNext()) {
+                sum += cur->getItem();
+            }
+        }
+    });
+    if (sum == 42) {
+        std::printf("\n");  // keep the walk from being optimized out
+    }
+    return result;
+}
+
+// Visit every entry by position, the way StationManager loops used to.
+template <class List>
+BenchResult positionalScan(int length, long ops) {
+    List list;
+    for (int i = 0; i < length; i++) {
+        list.insert(0, i);
+    }
+    long long sum = 0;
+    BenchResult result = measure(ops, [&](long n) {
+        for (long done = 0; done < n; done += length) {
+            for (int i = 0; i < list.getLength(); i++) {
+                sum += list.getEntry(i);
+            }
+        }
+    });
+    if (sum == 42) {
+        std::printf("\n");
+    }
+    return result;
+}
+
+// Visit every entry with a range-for.
+template <class List>
+BenchResult iteratorScan(int length, long ops) {
+    List list;
+    for (int i = 0; i < length; i++) {
+        list.insert(0, i);
+    }
+    long long sum = 0;
+    BenchResult result = measure(ops, [&](long n) {
+        for (long done = 0; done < n; done += length) {
+            for (int item : list) {
+                sum += item;
+            }
+        }
+    });
+    if (sum == 42) {
+        std::printf("\n");
+    }
+    return result;
+}
+
+// Insert long strings at the head, copying them or moving them into the list.
+BenchResult stringInsert(bool move_in, long ops) {
+    LinkedList<std::string> list;
+    const std::string payload(256, 's');
+    return measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            std::string entry = payload;
+            if (move_in) {
+                list.insert(0, std::move(entry));
+            } else {
+                list.insert(0, entry);
+            }
+            if (list.getLength() == 1000) {
+                list.clear();
+            }
+        }
+    });
+}
+
+// Scan a roster of `count` stations for a name that is not there, as routing
+// does when it looks a station up (TouchStation), or only walk the roster. Stations are allocated between other heap
+// objects, as they would be in a long-running kitchen.
+template <class List, bool TouchStation>
+BenchResult routingScan(int count, long ops) {
+    List roster;
+    std::vector<KitchenStation*> stations;
+    std::vector<std::string*> noise;
+    for (int i = 0; i < count; i++) {
+        stations.push_back(new KitchenStation("Station " + std::to_string(i)));
+        noise.push_back(new std::string(40, 'n'));
+        roster.insert(roster.getLength(), stations.back());
+    }
+    const std::string target = "Missing Station";
+    // Read through a volatile so the compiler cannot prove the pointer walk
+    // never matches (an intrusive list's entries are known to be non-null).
+    KitchenStation* volatile missing_station = nullptr;
+    KitchenStation* const missing = missing_station;
+    int hits = 0;
+    BenchResult result = measure(ops, [&](long n) {
+        for (long done = 0; done < n; done += count) {
+            for (KitchenStation* station : roster) {
+                if (TouchStation ? station->getName() == target : station == missing) {
+                    hits++;
+                }
+            }
+        }
+    });
+    for (KitchenStation* station : stations) {
+        delete station;
+    }
+    for (std::string* s : noise) {
+        delete s;
+    }
+    if (hits == 42) {
+        std::printf("\n");
+    }
+    return result;
+}
+
+// Free a manager's stations. The pointers are copied out first: an intrusive
+// roster unlinks a station as it is destroyed, which would end the walk.
+void deleteStations(StationManager& manager) {
+    std::vector<KitchenStation*> stations(manager.begin(), manager.end());
+    for (KitchenStation* station : stations) {
+        delete station;
+    }
+}
+
+// Move stations from the back half of a roster to the front, round robin.
+BenchResult moveStationToFront(int count, long ops) {
+    StationManager manager;
+    std::vector<std::string> names;
+    for (int i = 0; i < count; i++) {
+        names.push_back("Station " + std::to_string(i));
+        manager.addStation(new KitchenStation(names.back()));
+    }
+    BenchResult result = measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            manager.moveStationToFront(names[count / 2 + i % (count / 2)]);
+        }
+    });
+    deleteStations(manager);
+    return result;
+}
+
+// Take a consistent view of a `count`-station roster: a deep copy of the
+// list, or a snapshot of a manager in snapshot mode.
+BenchResult rosterSnapshot(int count, bool persistent, long ops) {
+    StationManager manager;
+    for (int i = 0; i < count; i++) {
+        manager.addStation(new KitchenStation("Station " + std::to_string(i)));
+    }
+    if (persistent) {
+        manager.enableSnapshots();
+    }
+    long seen = 0;
+    BenchResult result = measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            if (persistent) {
+                seen += manager.snapshot().getLength();
+            } else {
+                LinkedList<KitchenStation*> copy;
+                copy.insert(0, manager.begin(), manager.end());
+                seen += copy.getLength();
+            }
+        }
+    });
+    deleteStations(manager);
+    return seen > 0 ? result : BenchResult{0, 0, 0};
+}
+
+// moveStationToFront on a manager in snapshot mode: the live list and the
+// persistent mirror are both updated.
+BenchResult moveStationToFrontWithSnapshots(int count, long ops) {
+    StationManager manager;
+    std::vector<std::string> names;
+    for (int i = 0; i < count; i++) {
+        names.push_back("Station " + std::to_string(i));
+        manager.addStation(new KitchenStation(names.back()));
+    }
+    manager.enableSnapshots();
+    BenchResult result = measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            manager.moveStationToFront(names[count / 2 + i % (count / 2)]);
+        }
+    });
+    deleteStations(manager);
+    return result;
+}
+
+// Thread `count` existing stations into a roster of type List and tear it
+// down again. Reported per station, so bytes/op is the roster's own memory
+// per station (node slabs are amortized for the pool).
+template <class List>
+BenchResult rosterLinks(int count, long rounds) {
+    std::vector<KitchenStation*> stations;
+    for (int i = 0; i < count; i++) {
+        stations.push_back(new KitchenStation("Station " + std::to_string(i)));
+    }
+    BenchResult result = measure(rounds * count, [&](long) {
+        for (long round = 0; round < rounds; round++) {
+            List roster;
+            for (KitchenStation* station : stations) {
+                roster.insert(roster.getLength(), station);
+            }
+        }
+    });
+    for (KitchenStation* station : stations) {
+        delete station;
+    }
+    return result;
+}
+
+// Build a roster of `count` stations, one addStation call per station or one
+// addStations call for all of them. Reported per station added.
+BenchResult buildRoster(int count, bool bulk, long rounds) {
+    std::vector<KitchenStation*> stations;
+    for (int i = 0; i < count; i++) {
+        stations.push_back(new KitchenStation("Station " + std::to_string(i)));
+    }
+    BenchResult result = measure(rounds * count, [&](long) {
+        for (long round = 0; round < rounds; round++) {
+            StationManager manager;
+            if (bulk) {
+                manager.addStations(stations);
+            } else {
+                for (KitchenStation* station : stations) {
+                    manager.addStation(station);
+                }
+            }
+        }
+    });
+    for (KitchenStation* station : stations) {
+        delete station;
+    }
+    return result;
+}
+
+// Insert at `where` (0 front, 1 middle, 2 back) of a list holding `size`
+// entries, then remove it again. Each operation is one insert or one remove.
+template <class List>
+BenchResult insertRemove(int size, int where, long ops) {
+    List list;
+    for (int i = 0; i < size; i++) {
+        list.pushBack(i);
+    }
+    int position = (where == 0) ? 0 : (where == 1) ? size / 2 : size;
+    return measure(ops, [&](long n) {
+        for (long i = 0; i < n; i += 2) {
+            list.insert(position, int(i));
+            list.remove(position);
+        }
+    });
+}
+
+// getEntry at pseudo-random positions, which defeats the cursor.
+template <class List>
+BenchResult randomGetEntry(int size, long ops) {
+    List list;
+    for (int i = 0; i < size; i++) {
+        list.pushBack(i);
+    }
+    std::mt19937 random(size);
+    std::vector<int> positions(1024);
+    for (int& position : positions) {
+        position = int(random() % size);
+    }
+    long sum = 0;
+    BenchResult result = measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            sum += list.getEntry(positions[i & 1023]);
+        }
+    });
+    return sum != 0 ? result : BenchResult{0, 0, 0};
+}
+
+// Dish names may only hold letters and spaces: 0 -> "a", 25 -> "z", 26 -> "ba".
+std::string letterId(int i) {
+    std::string id;
+    do {
+        id.insert(id.begin(), char('a' + i % 26));
+        i /= 26;
+    } while (i > 0);
+    return id;
+}
+
+// A station holding `size` dishes of three ingredients each, with stock for
+// all of them. Dish i is named "Dish " + letterId(i) and uses "Ingredient i", i+1 and i+2.
+KitchenStation* makeStation(const std::string& name, int size) {
+    KitchenStation* station = new KitchenStation(name);
+    for (int i = 0; i < size + 2; i++) {
+        station->replenishStationIngredients(Ingredient("Ingredient " + std::to_string(i), 1000000000, 1, 1.0));
+    }
+    for (int i = 0; i < size; i++) {
+        std::vector<Ingredient> ingredients;
+        for (int k = i; k < i + 3; k++) {
+            ingredients.push_back(Ingredient("Ingredient " + std::to_string(k), 1, 1, 1.0));
+        }
+        station->assignDishToStation(new Appetizer("Dish " + letterId(i), ingredients, 10, 9.99,
+                                                   Dish::OTHER, Appetizer::PLATED, 1, false));
+    }
+    return station;
+}
+
+// canCompleteOrder for the last dish of a station with `size` dishes.
+BenchResult stationCanComplete(int size, long ops) {
+    KitchenStation* station = makeStation("Bench", size);
+    std::string dish_name = "Dish " + letterId(size - 1);
+    long ready = 0;
+    BenchResult result = measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            ready += station->canCompleteOrder(dish_name);
+        }
+    });
+    delete station;
+    return ready > 0 ? result : BenchResult{0, 0, 0};
+}
+
+// prepareDish for the last dish of a station with `size` dishes. Stock is
+// large enough that it never runs out during the run.
+BenchResult stationPrepare(int size, long ops) {
+    KitchenStation* station = makeStation("Bench", size);
+    std::string dish_name = "Dish " + letterId(size - 1);
+    BenchResult result = measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            station->prepareDish(dish_name);
+        }
+    });
+    delete station;
+    return result;
+}
+
+// replenishStationIngredients for the last ingredient of a station's stock.
+BenchResult stationReplenish(int size, long ops) {
+    KitchenStation* station = makeStation("Bench", size);
+    Ingredient restock("Ingredient " + std::to_string(size + 1), 1, 1, 1.0);
+    BenchResult result = measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            station->replenishStationIngredients(restock);
+        }
+    });
+    delete station;
+    return result;
+}
+
+// A dish whose three ingredients sit at the back of a `size`-SKU stock with
+// one unit each: preparing it uses them up and removes them from stock, and
+// restocking adds them back, so each op is one removal and one insertion.
+BenchResult stationStockChurn(int size, long ops) {
+    KitchenStation* station = makeStation("Bench", size);
+    std::vector<Ingredient> ingredients;
+    for (int k = 0; k < 3; k++) {
+        ingredients.push_back(Ingredient("Seasonal " + std::to_string(k), 1, 1, 1.0));
+    }
+    station->assignDishToStation(new Appetizer("Seasonal", ingredients, 10, 9.99,
+                                               Dish::OTHER, Appetizer::PLATED, 1, false));
+    long prepared = 0;
+    BenchResult result = measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            for (const Ingredient& ingredient : ingredients) {
+                station->replenishStationIngredients(ingredient);
+            }
+            prepared += station->prepareDish("Seasonal");
+        }
+    });
+    delete station;
+    return prepared > 0 ? result : BenchResult{0, 0, 0};
+}
+
+// Copy `prototype` and apply every dietary accommodation to the copy.
+template <class DishType>
+BenchResult dietary(const DishType& prototype, long ops) {
+    Dish::DietaryRequest request{true, true, true, true, true, true};
+    return measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            DishType dish(prototype);
+            dish.dietaryAccommodations(request);
+        }
+    });
+}
+
+// `size` ingredients cycling through meats, dairy, nuts and neutral items, so
+// every accommodation has something to replace or remove.
+std::vector<Ingredient> dietaryIngredients(int size) {
+    static const char* names[] = {"Chicken", "Milk", "Almonds", "Flour", "Beef", "Cheese", "Sugar", "Salt"};
+    std::vector<Ingredient> ingredients;
+    for (int i = 0; i < size; i++) {
+        ingredients.push_back(Ingredient(names[i % 8], 10, 1, 1.0));
+    }
+    return ingredients;
+}
+
+// StationManager lookups for the last of `size` stations: findStation
+// (lookup 0), canCompleteOrder (lookup 1), removeStation followed by
+// addStation (lookup 2), or findStation and canCompleteOrder by interned id
+// (lookups 3 and 4).
+BenchResult managerLookup(int size, int lookup, long ops) {
+    StationManager manager;
+    for (int i = 0; i < size; i++) {
+        manager.addStation(makeStation("Station " + std::to_string(i), 1));
+    }
+    std::string last_station = "Station " + std::to_string(size - 1);
+    manager.assignDishToStation(last_station, new Appetizer("Signature", {}, 10, 9.99,
+                                                            Dish::OTHER, Appetizer::PLATED, 1, false));
+    SymbolId last_station_id = SymbolTable::find(last_station);
+    SymbolId signature_id = SymbolTable::find("Signature");
+    long hits = 0;
+    BenchResult result = measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            if (lookup == 3) {
+                hits += manager.findStation(last_station_id) != nullptr;
+            } else if (lookup == 4) {
+                hits += manager.canCompleteOrder(signature_id);
+            } else if (lookup == 0) {
+                hits += manager.findStation(last_station) != nullptr;
+            } else if (lookup == 1) {
+                hits += manager.canCompleteOrder("Signature");
+            } else {
+                KitchenStation* station = manager.findStation(last_station);
+                hits += manager.removeStation(last_station);
+                manager.addStation(station);
+            }
+        }
+    });
+    deleteStations(manager);
+    return hits > 0 ? result : BenchResult{0, 0, 0};
+}
+
+// Discards everything written to it; processAllDishes traces to std::cout.
+struct NullBuffer : std::streambuf {
+    int overflow(int c) override { return c; }
+};
+
+// processAllDishes over `size` stations, each assigned one dish of its own
+// with no ingredients, with the quiet or the verbose trace, `batch` dishes per
+// call on `threads` workers. Reported per dish.
+BenchResult routeDishes(int size, bool verbose, int threads, long batch, long ops) {
+    StationManager manager;
+    std::vector<Dish*> dishes;
+    for (int i = 0; i < size; i++) {
+        std::string name = "Station " + std::to_string(i);
+        manager.addStation(new KitchenStation(name));
+        dishes.push_back(new Appetizer("Dish " + letterId(i), {}, 10, 9.99, Dish::OTHER, Appetizer::PLATED, 1, false));
+        manager.assignDishToStation(name, dishes.back());
+    }
+    manager.setVerboseRouting(verbose);
+    manager.setWorkerThreads(threads);
+    manager.reserveDishQueue(batch);
+    NullBuffer null_buffer;
+    std::streambuf* console = std::cout.rdbuf(&null_buffer);
+    BenchResult result = measure(ops, [&](long n) {
+        for (long done = 0; done < n; done += batch) {
+            for (long i = done; i < done + batch; i++) {
+                manager.addDishToQueue(dishes[(i * 7) % size]);
+            }
+            manager.processAllDishes();
+        }
+    });
+    std::cout.rdbuf(console);
+    deleteStations(manager);
+    return manager.getDishQueue().empty() ? result : BenchResult{0, 0, 0};
+}
+
+// processAllDishes over a queue holding a tail of 1024 orders no station can
+// fill (their stations' recipe needs Saffron, which nobody stocks), 64 Soups
+// per call, on eight stations, with failed dishes retried on every pass or
+// parked until Saffron arrives. Reported per Soup, with the station attempts
+// that failed and the backup draws per Soup.
+BenchResult routeBlockedTail(bool parking, long ops) {
+    const long batch = 64;
+    StationManager manager;
+    for (int i = 0; i < 8; i++) {
+        std::string name = "Station " + std::to_string(i);
+        manager.addStation(new KitchenStation(name));
+        manager.assignDishToStation(name, new Appetizer("Soup", {Ingredient("Broth", 1, 1, 1.0)}, 10, 9.99,
+                                                        Dish::OTHER, Appetizer::PLATED, 1, false));
+        manager.assignDishToStation(name, new Appetizer("Paella", {Ingredient("Rice", 1, 1, 1.0), Ingredient("Saffron", 1, 1, 1.0)},
+                                                        30, 19.99, Dish::OTHER, Appetizer::PLATED, 1, false));
+        manager.replenishIngredientAtStation(name, Ingredient("Broth", 1000000000, 1, 1.0));
+    }
+    Appetizer soup("Soup", {Ingredient("Broth", 1, 1, 1.0)}, 10, 9.99, Dish::OTHER, Appetizer::PLATED, 1, false);
+    Appetizer paella("Paella", {Ingredient("Rice", 1, 1, 1.0)}, 30, 19.99, Dish::OTHER, Appetizer::PLATED, 1, false);
+    manager.setRetryParking(parking);
+    for (int i = 0; i < 1024; i++) {
+        manager.addDishToQueue(&paella);
+    }
+    NullBuffer null_buffer;
+    std::streambuf* console = std::cout.rdbuf(&null_buffer);
+    manager.processAllDishes();
+    manager.resetRoutingStats();
+    BenchResult result = measure(ops, [&](long n) {
+        for (long done = 0; done < n; done += batch) {
+            for (long i = 0; i < batch; i++) {
+                manager.addDishToQueue(&soup);
+            }
+            manager.processAllDishes();
+        }
+    });
+    std::cout.rdbuf(console);
+    StationManager::RoutingStats stats = manager.getRoutingStats();
+    manager.setRetryParking(false);
+    manager.setDishQueue(std::queue<Dish*>());
+    deleteStations(manager);
+    if (stats.dishes_prepared == 0) {
+        return BenchResult{0, 0, 0};
+    }
+    result.counters.push_back(Counter{"failed_probes", double(stats.failed_probes) / stats.dishes_prepared});
+    result.counters.push_back(Counter{"backup_draws", double(stats.backup_draws) / stats.dishes_prepared});
+    return result;
+}
+
+// prepareNextDish for one dish assigned to `size` stations, of which only the
+// last has stock, in roster or adaptive order. Counts failed probes per dish.
+BenchResult routeAdaptive(int size, bool adaptive, long ops) {
+    StationManager manager;
+    std::vector<Dish*> dishes;
+    for (int i = 0; i < size; i++) {
+        std::string name = "Station " + std::to_string(i);
+        manager.addStation(new KitchenStation(name));
+        dishes.push_back(new Appetizer("Soup", {Ingredient("Broth", 1, 1, 1.0)}, 10, 9.99,
+                                       Dish::OTHER, Appetizer::PLATED, 1, false));
+        manager.assignDishToStation(name, dishes.back());
+    }
+    manager.replenishIngredientAtStation("Station " + std::to_string(size - 1),
+                                         Ingredient("Broth", 1000000000, 1, 1.0));
+    manager.setAdaptiveRouting(adaptive);
+    BenchResult result = measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            manager.addDishToQueue(dishes[0]);
+            manager.prepareNextDish();
+        }
+    });
+    StationManager::RoutingStats stats = manager.getRoutingStats();
+    deleteStations(manager);
+    if (stats.dishes_prepared != ops) {
+        return BenchResult{0, 0, 0};
+    }
+    result.counters.push_back(Counter{"failed_probes", double(stats.failed_probes) / stats.dishes_prepared});
+    return result;
+}
+
+// prepareNextDish in rush hours: `size` orders for a dish every station can
+// make arrive at once, then the kitchen starts over at minute 0. Counts the
+// mean simulated minutes from order to finished dish.
+BenchResult routeRushHour(int size, StationManager::RoutingMode mode, long ops) {
+    StationManager manager;
+    std::vector<Dish*> dishes;
+    for (int i = 0; i < size; i++) {
+        std::string name = "Station " + std::to_string(i);
+        manager.addStation(new KitchenStation(name));
+        dishes.push_back(new Appetizer("Soup", {Ingredient("Broth", 1, 1, 1.0)}, 10, 9.99,
+                                       Dish::OTHER, Appetizer::PLATED, 1, false));
+        manager.assignDishToStation(name, dishes.back());
+        manager.replenishIngredientAtStation(name, Ingredient("Broth", 1000000000, 1, 1.0));
+    }
+    manager.setRoutingMode(mode);
+    BenchResult result = measure(ops, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            if (i % size == 0) {
+                manager.resetSimulatedTime();
+            }
+            manager.addDishToQueue(dishes[0]);
+            manager.prepareNextDish();
+        }
+    });
+    StationManager::RoutingStats stats = manager.getRoutingStats();
+    deleteStations(manager);
+    if (stats.dishes_prepared == 0) {
+        return BenchResult{0, 0, 0};
+    }
+    result.counters.push_back(Counter{"latency_minutes", double(stats.total_latency) / stats.dishes_prepared});
+    return result;
+}
+
+// processAllDishes (quiet) over four stations that can all make Soup (Broth)
+// and Stew (Broth, Beef) but are restocked unevenly, 32 dishes per round.
+// Each round's deliveries cover its dishes. Counts backup draws and dishes
+// sent back to the queue per dish, under each routing mode.
+BenchResult routeWithPolicy(StationManager::RoutingMode mode, long ops) {
+    StationManager manager;
+    const int delivery[4][2] = {{16, 0}, {8, 8}, {4, 8}, {4, 0}};  // Broth, Beef per round
+    for (int i = 0; i < 4; i++) {
+        std::string name = "Station " + std::to_string(i);
+        manager.addStation(new KitchenStation(name));
+        manager.assignDishToStation(name, new Appetizer("Soup", {Ingredient("Broth", 1, 1, 1.0)}, 10, 9.99,
+                                                        Dish::OTHER, Appetizer::PLATED, 1, false));
+        manager.assignDishToStation(name, new Appetizer("Stew", {Ingredient("Broth", 1, 1, 1.0), Ingredient("Beef", 1, 1, 1.0)},
+                                                        20, 14.99, Dish::OTHER, Appetizer::PLATED, 1, false));
+    }
+    Appetizer soup("Soup", {Ingredient("Broth", 1, 1, 1.0)}, 10, 9.99, Dish::OTHER, Appetizer::PLATED, 1, false);
+    Appetizer stew("Stew", {Ingredient("Broth", 1, 1, 1.0), Ingredient("Beef", 1, 1, 1.0)}, 20, 14.99,
+                   Dish::OTHER, Appetizer::PLATED, 1, false);
+    InventoryCostPolicy cost_policy;
+    if (mode == StationManager::POLICY) {
+        manager.setRoutingPolicy(&cost_policy);
+    } else {
+        manager.setRoutingMode(mode);
+    }
+    NullBuffer null_buffer;
+    std::streambuf* console = std::cout.rdbuf(&null_buffer);
+    const long batch = 32;
+    BenchResult result = measure(ops, [&](long n) {
+        for (long done = 0; done < n; done += batch) {
+            for (int i = 0; i < 4; i++) {
+                std::string name = "Station " + std::to_string(i);
+                manager.replenishIngredientAtStation(name, Ingredient("Broth", delivery[i][0], 1, 1.0));
+                if (delivery[i][1] > 0) {
+                    manager.replenishIngredientAtStation(name, Ingredient("Beef", delivery[i][1], 1, 1.0));
+                }
+            }
+            for (long i = 0; i < batch; i++) {
+                manager.addDishToQueue(i % 4 == 3 ? static_cast<Dish*>(&stew) : &soup);
+            }
+            manager.processAllDishes();
+        }
+    });
+    std::cout.rdbuf(console);
+    StationManager::RoutingStats stats = manager.getRoutingStats();
+    deleteStations(manager);
+    long dishes = stats.dishes_prepared + stats.queue_failures;
+    result.counters.push_back(Counter{"backup_draws", double(stats.backup_draws) / dishes});
+    result.counters.push_back(Counter{"queue_failures", double(stats.queue_failures) / dishes});
+    return result;
+}
+
+// Roster readers scanning while writers remove and re-add stations. The
+// reported time is per completed scan, summed over all reader threads.
+struct MutexRoster {
+    std::mutex lock;
+    LinkedList<int> list;
+};
+
+int countStation(MutexRoster& roster, int wanted) {
+    std::lock_guard<std::mutex> hold(roster.lock);
+    int hits = 0;
+    for (int id : roster.list) {
+        hits += (id == wanted);
+    }
+    return hits;
+}
+
+void churnStation(MutexRoster& roster, int id) {
+    std::lock_guard<std::mutex> hold(roster.lock);
+    int position = 0;
+    for (int entry : roster.list) {
+        if (entry == id) {
+            roster.list.remove(position);
+            roster.list.insert(roster.list.getLength(), id);
+            return;
+        }
+        position++;
+    }
+}
+
+int countStation(ConcurrentList<int>& roster, int wanted) {
+    int hits = 0;
+    roster.forEach([&](int id) {
+        hits += (id == wanted);
+        return true;
+    });
+    return hits;
+}
+
+void churnStation(ConcurrentList<int>& roster, int id) {
+    if (roster.removeEntry(id)) {
+        roster.pushBack(id);
+    }
+}
+
+// The same through a StationManager: readers walk forEachStation while
+// writers move stations to the front under the routing lock.
+struct ManagerRoster {
+    StationManager manager;
+    std::vector<KitchenStation*> stations;
+    std::vector<std::string> names;
+};
+
+int countStation(ManagerRoster& roster, int wanted) {
+    int hits = 0;
+    const KitchenStation* station = roster.stations[wanted];
+    roster.manager.forEachStation([&](const KitchenStation* entry) {
+        hits += (entry == station);
+        return true;
+    });
+    return hits;
+}
+
+void churnStation(ManagerRoster& roster, int id) {
+    roster.manager.moveStationToFront(roster.names[id]);
+}
+
+template <class Roster>
+BenchResult scanUnderChurn(Roster& roster, int count, int readers, int writers, long scans) {
+    std::atomic<long> scans_left(scans);
+    std::atomic<bool> stop(false);
+    std::atomic<long> sink(0);
+    return measure(scans, [&](long) {
+        std::vector<std::thread> threads;
+        for (int w = 0; w < writers; w++) {
+            threads.emplace_back([&, w] {
+                for (long i = w; !stop.load(std::memory_order_relaxed); i += writers) {
+                    churnStation(roster, int(i % count));
+                }
+            });
+        }
+        std::vector<std::thread> scanners;
+        for (int r = 0; r < readers; r++) {
+            scanners.emplace_back([&, r] {
+                long hits = 0;
+                while (scans_left.fetch_sub(1, std::memory_order_relaxed) > 0) {
+                    hits += countStation(roster, r % count);
+                }
+                sink += hits;
+            });
+        }
+        for (std::thread& scanner : scanners) {
+            scanner.join();
+        }
+        stop = true;
+        for (std::thread& writer : threads) {
+            writer.join();
+        }
+    });
+}
+
+BenchResult lockedRosterScan(int count, int readers, int writers, long scans) {
+    MutexRoster roster;
+    for (int i = 0; i < count; i++) {
+        roster.list.insert(i, i);
+    }
+    return scanUnderChurn(roster, count, readers, writers, scans);
+}
+
+BenchResult lockFreeRosterScan(int count, int readers, int writers, long scans) {
+    ConcurrentList<int> roster;
+    for (int i = 0; i < count; i++) {
+        roster.pushBack(i);
+    }
+    return scanUnderChurn(roster, count, readers, writers, scans);
+}
+
+BenchResult managerRosterScan(int count, int readers, int writers, long scans) {
+    ManagerRoster roster;
+    for (int i = 0; i < count; i++) {
+        roster.names.push_back("Station " + std::to_string(i));
+        roster.stations.push_back(new KitchenStation(roster.names.back()));
+        roster.manager.addStation(roster.stations.back());
+    }
+    roster.manager.enableConcurrentReads();
+    BenchResult result = scanUnderChurn(roster, count, readers, writers, scans);
+    for (KitchenStation* station : roster.stations) {
+        delete station;
+    }
+    return result;
+}
+
+// One station serving a stream of orders under each queue discipline, at
+// about 90% load: 80% of orders take 2-6 minutes and 20% take 20-40, they
+// arrive on average every 10.2 minutes, and each is due 0-60 minutes after
+// its prep time would have it done. An order is taken whenever the station
+// comes free. The simulated clock counts ticks of 1/4096 minute and an
+// order's prep time carries its slot in the low ticks, so the time the
+// station moves on tells which order it made. Reports the mean and p99
+// minutes from arrival to done, and the share of orders finished late.
+BenchResult scheduleOrders(StationManager::QueueDiscipline discipline, long ops) {
+    const long tick = 4096;
+    const int slots = static_cast<int>(StationManager::DISH_QUEUE_CAPACITY);
+    StationManager manager;
+    KitchenStation* station = new KitchenStation("Station 0");
+    manager.addStation(station);
+    manager.assignDishToStation("Station 0", new Appetizer("Soup", {Ingredient("Broth", 1, 1, 1.0)}, 10, 9.99,
+                                                           Dish::OTHER, Appetizer::PLATED, 1, false));
+    manager.replenishIngredientAtStation("Station 0", Ingredient("Broth", 1000000000, 1, 1.0));
+    std::vector<Dish*> orders;
+    std::vector<int> free_slots;
+    for (int i = 0; i < slots; i++) {
+        orders.push_back(new Appetizer("Soup", {Ingredient("Broth", 1, 1, 1.0)}, 0, 9.99,
+                                       Dish::OTHER, Appetizer::PLATED, 1, false));
+        free_slots.push_back(slots - 1 - i);
+    }
+    std::vector<long> arrived(slots), due(slots);
+    std::vector<double> latencies;
+    latencies.reserve(ops);
+    long late = 0;
+    std::mt19937 rng(235);
+    std::exponential_distribution<double> gap(1.0 / 10.2);
+    manager.setQueueDiscipline(discipline);
+
+    // makes the next order, once the station is free
+    auto serveNext = [&]() {
+        manager.advanceSimulatedTime(std::max(0L, station->getBusyUntil() - manager.getSimulatedTime()));
+        long started = manager.getSimulatedTime();
+        manager.prepareNextDish();
+        long finish = station->getBusyUntil();
+        int slot = static_cast<int>((finish - started) % tick);
+        latencies.push_back(double(finish - arrived[slot]) / tick);
+        late += finish > due[slot];
+        free_slots.push_back(slot);
+    };
+
+    BenchResult result = measure(ops, [&](long n) {
+        long next_arrival = 0;
+        for (long i = 0; i < n; i++) {
+            next_arrival += static_cast<long>(gap(rng) * tick);
+            while (manager.getDishQueueSize() > 0 &&
+                   (station->getBusyUntil() <= next_arrival || free_slots.empty())) {
+                serveNext();
+            }
+            manager.advanceSimulatedTime(std::max(0L, next_arrival - manager.getSimulatedTime()));
+            int slot = free_slots.back();
+            free_slots.pop_back();
+            long minutes = rng() % 5 < 4 ? 2 + rng() % 5 : 20 + rng() % 21;
+            orders[slot]->setPrepTime(static_cast<int>(minutes * tick + slot));
+            arrived[slot] = manager.getSimulatedTime();
+            due[slot] = arrived[slot] + (minutes + rng() % 61) * tick;
+            manager.addDishToQueue(orders[slot], due[slot]);
+        }
+        while (manager.getDishQueueSize() > 0) {
+            serveNext();
+        }
+    });
+    deleteStations(manager);
+    for (Dish* order : orders) {
+        delete order;
+    }
+    if (latencies.empty()) {
+        return BenchResult{0, 0, 0};
+    }
+    double total = 0;
+    for (double latency : latencies) {
+        total += latency;
+    }
+    std::vector<double>::iterator p99 = latencies.begin() + latencies.size() * 99 / 100;
+    std::nth_element(latencies.begin(), p99, latencies.end());
+    result.counters.push_back(Counter{"latency_minutes", total / latencies.size()});
+    result.counters.push_back(Counter{"p99_latency_minutes", *p99});
+    result.counters.push_back(Counter{"late_orders", double(late) / latencies.size()});
+    return result;
+}
+
+// The order queue under contention: each of `threads` threads pushes an
+// entry and pops one, `pairs` times in all. ops counts pushes and pops.
+struct LockedQueue {
+    std::mutex lock;
+    std::queue<long> entries;
+    bool tryPush(long entry) {
+        std::lock_guard<std::mutex> hold(lock);
+        entries.push(entry);
+        return true;
+    }
+    bool tryPop(long& entry) {
+        std::lock_guard<std::mutex> hold(lock);
+        if (entries.empty()) {
+            return false;
+        }
+        entry = entries.front();
+        entries.pop();
+        return true;
+    }
+};
+
+template <class Queue>
+BenchResult queueThroughput(Queue& queue, int threads, long pairs) {
+    std::atomic<long> pairs_left(pairs);
+    std::atomic<long> sink(0);
+    return measure(2 * pairs, [&](long) {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                long sum = 0;
+                long entry;
+                while (pairs_left.fetch_sub(1, std::memory_order_relaxed) > 0) {
+                    while (!queue.tryPush(t)) {
+                        std::this_thread::yield();
+                    }
+                    while (!queue.tryPop(entry)) {
+                        std::this_thread::yield();
+                    }
+                    sum += entry;
+                }
+                sink += sum;
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    });
+}
+
+BenchResult lockFreeQueue(int threads, long pairs) {
+    MpmcQueue<long> queue(StationManager::DISH_QUEUE_CAPACITY);
+    return queueThroughput(queue, threads, pairs);
+}
+
+BenchResult lockedQueue(int threads, long pairs) {
+    LockedQueue queue;
+    return queueThroughput(queue, threads, pairs);
+}
+
+// One station's stock shared by `threads` cooks, who prepare `ops` dishes
+// in all: every cook the same dish, or each its own dish with its own three
+// ingredients (disjoint). Stock never runs out. The station is guarded by a
+// mutex, or uses atomic stock and no lock.
+BenchResult stationContention(bool atomic, bool disjoint, int threads, long ops) {
+    KitchenStation station("Grill");
+    std::vector<SymbolId> dish_ids;
+    for (int d = 0; d < threads; d++) {
+        std::vector<Ingredient> ingredients;
+        for (int k = 3 * d; k < 3 * d + 3; k++) {
+            ingredients.push_back(Ingredient("Ingredient " + std::to_string(k), 1, 1, 1.0));
+            station.replenishStationIngredients(Ingredient("Ingredient " + std::to_string(k), 1000000000, 1, 1.0));
+        }
+        station.assignDishToStation(new Appetizer("Dish " + letterId(d), ingredients, 10, 9.99,
+                                                  Dish::OTHER, Appetizer::PLATED, 1, false));
+        dish_ids.push_back(SymbolTable::find("Dish " + letterId(d)));
+    }
+    station.setAtomicStock(atomic);
+    std::mutex lock;
+    std::atomic<long> ops_left(ops);
+    std::atomic<long> prepared(0);
+    BenchResult result = measure(ops, [&](long) {
+        std::vector<std::thread> cooks;
+        for (int t = 0; t < threads; t++) {
+            cooks.emplace_back([&, t] {
+                SymbolId dish_id = dish_ids[disjoint ? t : 0];
+                long done = 0;
+                while (ops_left.fetch_sub(1, std::memory_order_relaxed) > 0) {
+                    if (atomic) {
+                        done += station.tryConsume(dish_id).status == KitchenStation::PREPARED;
+                    } else {
+                        std::lock_guard<std::mutex> hold(lock);
+                        done += station.tryConsume(dish_id).status == KitchenStation::PREPARED;
+                    }
+                }
+                prepared += done;
+            });
+        }
+        for (std::thread& cook : cooks) {
+            cook.join();
+        }
+    });
+    return prepared == ops ? result : BenchResult{0, 0, 0};
+}
+
+}  // namespace
+
+// GCC cannot tell that the replaced operator delete below pairs with the
+// replaced operator new, and warns about free() on a new'd pointer.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char* argv[]) {
+    std::string json_path;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            g_filter = argv[++i];
+        } else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter TEXT] [--json FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    typedef LinkedList<int, HeapNodeAllocator<int>> HeapList;
+    typedef LinkedList<int, PoolNodeAllocator<int>> PoolList;
+
+    const long ops = 2000000;
+    run("list_front_churn/heap", [&] { return frontChurn<HeapList>(1000, ops); });
+    run("list_front_churn/pool", [&] { return frontChurn<PoolList>(1000, ops); });
+    run("list_build_clear/heap", [&] { return buildAndClear<HeapList>(1000, ops); });
+    run("list_build_clear/pool", [&] { return buildAndClear<PoolList>(1000, ops); });
+    run("list_traverse_after_churn/heap", [&] { return traverseAfterChurn<HeapList>(100000, ops * 10); });
+    run("list_traverse_after_churn/pool", [&] { return traverseAfterChurn<PoolList>(100000, ops * 10); });
+    run("list_positional_scan/1000", [&] { return positionalScan<PoolList>(1000, ops * 10); });
+    run("list_iterator_scan/1000", [&] { return iteratorScan<PoolList>(1000, ops * 10); });
+    run("list_string_insert/copy", [&] { return stringInsert(false, ops); });
+    run("list_string_insert/move", [&] { return stringInsert(true, ops); });
+    for (int count : {10, 1000, 100000}) {
+        std::string size = std::to_string(count);
+        run("roster_walk/linked/" + size, [&] { return routingScan<LinkedList<KitchenStation*>, false>(count, ops * 5); });
+        run("roster_walk/unrolled/" + size, [&] { return routingScan<UnrolledLinkedList<KitchenStation*>, false>(count, ops * 5); });
+        run("routing_scan/linked/" + size, [&] { return routingScan<LinkedList<KitchenStation*>, true>(count, ops * 5); });
+        run("routing_scan/unrolled/" + size, [&] { return routingScan<UnrolledLinkedList<KitchenStation*>, true>(count, ops * 5); });
+        run("roster_walk/intrusive/" + size, [&] { return routingScan<IntrusiveList<KitchenStation>, false>(count, ops * 5); });
+        run("routing_scan/intrusive/" + size, [&] { return routingScan<IntrusiveList<KitchenStation>, true>(count, ops * 5); });
+    }
+    run("roster_links/linked_heap/1000", [&] { return rosterLinks<LinkedList<KitchenStation*, HeapNodeAllocator<KitchenStation*>>>(1000, 1000); });
+    run("roster_links/linked_pool/1000", [&] { return rosterLinks<LinkedList<KitchenStation*>>(1000, 1000); });
+    run("roster_links/unrolled/1000", [&] { return rosterLinks<UnrolledLinkedList<KitchenStation*>>(1000, 1000); });
+    run("roster_links/intrusive/1000", [&] { return rosterLinks<IntrusiveList<KitchenStation>>(1000, 1000); });
+    run("station_move_to_front/1000", [&] { return moveStationToFront(1000, ops / 100); });
+    run("station_move_to_front/snapshots/1000", [&] { return moveStationToFrontWithSnapshots(1000, ops / 100); });
+    run("roster_snapshot/deep_copy/100000", [&] { return rosterSnapshot(100000, false, 20); });
+    run("roster_snapshot/persistent/100000", [&] { return rosterSnapshot(100000, true, ops); });
+    run("roster_build/add_station/5000", [&] { return buildRoster(5000, false, 100); });
+    run("roster_build/add_stations/5000", [&] { return buildRoster(5000, true, 100); });
+    run("roster_scan_under_churn/mutex/4r2w", [&] { return lockedRosterScan(1000, 4, 2, ops / 20); });
+    run("roster_scan_under_churn/lockfree/4r2w", [&] { return lockFreeRosterScan(1000, 4, 2, ops / 20); });
+    run("roster_scan_under_churn/manager/4r2w", [&] { return managerRosterScan(1000, 4, 2, ops / 20); });
+
+    const char* places[] = {"front", "middle", "back"};
+    for (int size : {10, 1000, 10000}) {
+        std::string n = std::to_string(size);
+        for (int where = 0; where < 3; where++) {
+            std::string place = places[where];
+            run("list_insert_remove/" + place + "/linked/" + n, [&] { return insertRemove<LinkedList<int>>(size, where, opsFor(ops * 20, size)); });
+            run("list_insert_remove/" + place + "/unrolled/" + n, [&] { return insertRemove<UnrolledLinkedList<int>>(size, where, opsFor(ops * 20, size)); });
+        }
+        run("list_get_entry/random/linked/" + n, [&] { return randomGetEntry<LinkedList<int>>(size, opsFor(ops * 20, size)); });
+        run("list_get_entry/random/unrolled/" + n, [&] { return randomGetEntry<UnrolledLinkedList<int>>(size, opsFor(ops * 20, size)); });
+    }
+    for (int size : {1, 10, 100, 1000}) {
+        std::string n = std::to_string(size);
+        run("station_can_complete/" + n, [&] { return stationCanComplete(size, opsFor(ops, size)); });
+        run("station_prepare_dish/" + n, [&] { return stationPrepare(size, opsFor(ops, size)); });
+        run("station_replenish/" + n, [&] { return stationReplenish(size, opsFor(ops, size)); });
+        run("station_stock_churn/" + n, [&] { return stationStockChurn(size, opsFor(ops, size)); });
+    }
+    for (int size : {4, 16, 64}) {
+        std::string n = std::to_string(size);
+        std::vector<Ingredient> ingredients = dietaryIngredients(size);
+        Appetizer appetizer("Sampler", ingredients, 10, 9.99, Dish::OTHER, Appetizer::PLATED, 1, false);
+        MainCourse main_course("Roast", ingredients, 30, 24.99, Dish::OTHER, MainCourse::BAKED, "Chicken", {}, false);
+        Dessert dessert("Tart", ingredients, 20, 7.99, Dish::OTHER, Dessert::SWEET, 8, true);
+        run("dish_dietary/appetizer/" + n, [&] { return dietary(appetizer, opsFor(ops, size)); });
+        run("dish_dietary/main_course/" + n, [&] { return dietary(main_course, opsFor(ops, size)); });
+        run("dish_dietary/dessert/" + n, [&] { return dietary(dessert, opsFor(ops, size)); });
+    }
+    for (int size : {10, 100, 1000}) {
+        std::string n = std::to_string(size);
+        run("manager_find_station/" + n, [&] { return managerLookup(size, 0, opsFor(ops * 5, size)); });
+        run("manager_can_complete_order/" + n, [&] { return managerLookup(size, 1, opsFor(ops * 5, size)); });
+        run("manager_find_station/by_id/" + n, [&] { return managerLookup(size, 3, opsFor(ops * 5, size)); });
+        run("manager_can_complete_order/by_id/" + n, [&] { return managerLookup(size, 4, opsFor(ops * 5, size)); });
+        run("manager_remove_station/" + n, [&] { return managerLookup(size, 2, opsFor(ops * 5, size)); });
+        run("manager_route/roster_order/" + n, [&] { return routeAdaptive(size, false, ops / 10); });
+        run("manager_route/adaptive/" + n, [&] { return routeAdaptive(size, true, ops / 10); });
+        run("manager_rush_hour/roster_order/" + n,
+            [&] { return routeRushHour(size, StationManager::ROSTER_ORDER, ops / 10); });
+        run("manager_rush_hour/earliest_finish/" + n,
+            [&] { return routeRushHour(size, StationManager::EARLIEST_FINISH, ops / 10); });
+        run("manager_process_dishes/quiet/" + n, [&] { return routeDishes(size, false, 1, 64, ops / 10); });
+        run("manager_process_dishes/verbose/" + n, [&] { return routeDishes(size, true, 1, 64, opsFor(ops / 10, size)); });
+    }
+    for (int threads : {1, 2, 4, 16}) {
+        run("manager_process_dishes/parallel/64/threads_" + std::to_string(threads),
+            [&] { return routeDishes(64, false, threads, 65536, 1L << 20); });
+    }
+    run("manager_blocked_tail/retry", [&] { return routeBlockedTail(false, ops / 100); });
+    run("manager_blocked_tail/park", [&] { return routeBlockedTail(true, ops / 100); });
+    run("order_schedule/fifo", [&] { return scheduleOrders(StationManager::FIFO, ops / 10); });
+    run("order_schedule/shortest_prep_first",
+        [&] { return scheduleOrders(StationManager::SHORTEST_PREP_FIRST, ops / 10); });
+    run("order_schedule/earliest_deadline_first",
+        [&] { return scheduleOrders(StationManager::EARLIEST_DEADLINE_FIRST, ops / 10); });
+    for (int threads : {1, 2, 4, 8, 16, 32}) {
+        std::string t = std::to_string(threads);
+        run("order_queue/mutex/threads_" + t, [&] { return lockedQueue(threads, ops / 2); });
+        run("order_queue/mpmc/threads_" + t, [&] { return lockFreeQueue(threads, ops / 2); });
+    }
+    for (int threads : {1, 2, 4, 8, 16, 32}) {
+        std::string t = std::to_string(threads);
+        for (bool disjoint : {false, true}) {
+            std::string dishes = disjoint ? "disjoint" : "same";
+            run("station_contention/" + dishes + "/mutex/threads_" + t,
+                [&] { return stationContention(false, disjoint, threads, ops / 2); });
+            run("station_contention/" + dishes + "/atomic/threads_" + t,
+                [&] { return stationContention(true, disjoint, threads, ops / 2); });
+        }
+    }
+    run("manager_route_stock/roster_order", [&] { return routeWithPolicy(StationManager::ROSTER_ORDER, ops / 10); });
+    run("manager_route_stock/adaptive", [&] { return routeWithPolicy(StationManager::ADAPTIVE, ops / 10); });
+    run("manager_route_stock/earliest_finish", [&] { return routeWithPolicy(StationManager::EARLIEST_FINISH, ops / 10); });
+    run("manager_route_stock/inventory_cost", [&] { return routeWithPolicy(StationManager::POLICY, ops / 10); });
+
+    if (!json_path.empty() && !writeJson(json_path)) {
+        std::fprintf(stderr, "could not write %s\n", json_path.c_str());
+        return 1;
+    }
+    return 0;
+}
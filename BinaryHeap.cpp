@@ -0,0 +1,135 @@
+/** ADT priority queue: array-based binary heap.
+
+ Implementation file for the class BinaryHeap.
+ @file BinaryHeap.cpp */
+
+#include "BinaryHeap.hpp"  // Header file
+#include <string>
+#include <utility>
+
+
+// constructor
+template<class T, class Compare>
+BinaryHeap<T, Compare>::BinaryHeap(const Compare& before) : before_(before)
+{
+}  // end constructor
+
+
+template<class T, class Compare>
+bool BinaryHeap<T, Compare>::isEmpty() const
+{
+   return items_.empty();
+}  // end isEmpty
+
+
+template<class T, class Compare>
+std::size_t BinaryHeap<T, Compare>::size() const
+{
+   return items_.size();
+}  // end size
+
+
+/** @return the entry that comes first under Compare */
+template<class T, class Compare>
+const T& BinaryHeap<T, Compare>::peekTop() const
+{
+   // Enforce precondition
+   if (items_.empty())
+   {
+      std::string message = "peekTop() called with an empty heap.";
+      throw(PrecondViolatedExcep(message));
+   }  // end if
+   return items_.front();
+}  // end peekTop
+
+
+/** @post new_entry is in the heap */
+template<class T, class Compare>
+void BinaryHeap<T, Compare>::add(const T& new_entry)
+{
+   items_.push_back(new_entry);
+   siftUp(items_.size() - 1);
+}  // end add
+
+
+/** @post the top entry is removed */
+template<class T, class Compare>
+bool BinaryHeap<T, Compare>::remove()
+{
+   if (items_.empty())
+   {
+      return false;
+   }
+   // the last leaf takes the root's place and sinks to where it belongs
+   items_.front() = std::move(items_.back());
+   items_.pop_back();
+   if (!items_.empty())
+   {
+      siftDown(0);
+   }
+   return true;
+}  // end remove
+
+
+template<class T, class Compare>
+void BinaryHeap<T, Compare>::clear()
+{
+   items_.clear();
+}  // end clear
+
+
+template<class T, class Compare>
+void BinaryHeap<T, Compare>::reserve(std::size_t capacity)
+{
+   items_.reserve(capacity);
+}  // end reserve
+
+
+template<class T, class Compare>
+const std::vector<T>& BinaryHeap<T, Compare>::entries() const
+{
+   return items_;
+}  // end entries
+
+
+// Holds the entry aside and moves parents down into the hole instead of swapping
+template<class T, class Compare>
+void BinaryHeap<T, Compare>::siftUp(std::size_t index)
+{
+   T moving = std::move(items_[index]);
+   while (index > 0)
+   {
+      std::size_t parent = (index - 1) / 2;
+      if (!before_(moving, items_[parent]))
+      {
+         break;
+      }
+      items_[index] = std::move(items_[parent]);
+      index = parent;
+   }  // end while
+   items_[index] = std::move(moving);
+}  // end siftUp
+
+
+// Moves the child that comes first up into the hole until the entry fits
+template<class T, class Compare>
+void BinaryHeap<T, Compare>::siftDown(std::size_t index)
+{
+   std::size_t count = items_.size();
+   T moving = std::move(items_[index]);
+   while (2 * index + 1 < count)
+   {
+      std::size_t child = 2 * index + 1;
+      if (child + 1 < count && before_(items_[child + 1], items_[child]))
+      {
+         child++;
+      }
+      if (!before_(items_[child], moving))
+      {
+         break;
+      }
+      items_[index] = std::move(items_[child]);
+      index = child;
+   }  // end while
+   items_[index] = std::move(moving);
+}  // end siftDown
@@ -0,0 +1,63 @@
+/** ADT priority queue: array-based binary heap.
+    The entry at the top is the one that comes first under Compare (the
+    smallest, with the default std::less), so this is a min-heap by default.
+    Entries live in a vector laid out level by level: the children of the
+    entry at index i are at 2i + 1 and 2i + 2. add and remove move one entry
+    up or down a single path, O(log n); peekTop is O(1).
+    Entries that compare equal come out in no particular order; callers that
+    need ties broken by arrival put a sequence number in the entry.
+    @file BinaryHeap.hpp */
+
+#ifndef BINARY_HEAP_
+#define BINARY_HEAP_
+
+#include "PrecondViolatedExcep.hpp"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+template<class T, class Compare = std::less<T>>
+class BinaryHeap
+{
+public:
+   explicit BinaryHeap(const Compare& before = Compare()); // constructor
+
+   /**@return true if the heap has no entries */
+   bool isEmpty() const;
+
+   /**@return the number of entries */
+   std::size_t size() const;
+
+   /**@return the entry that comes first under Compare. If the heap is empty
+      throws PrecondViolatedExcep */
+   const T& peekTop() const;
+
+   /**@post new_entry is in the heap */
+   void add(const T& new_entry);
+
+   /**@post the top entry is removed
+      @return true if the heap was not empty */
+   bool remove();
+
+   /**@post the heap is empty; its storage is kept for reuse */
+   void clear();
+
+   /**@post the heap can hold capacity entries without reallocating */
+   void reserve(std::size_t capacity);
+
+   /**@return the entries in heap order (only the first is in its final place) */
+   const std::vector<T>& entries() const;
+
+private:
+   std::vector<T> items_;
+   Compare before_;
+
+   // @post the entry at index moved up until its parent comes before it
+   void siftUp(std::size_t index);
+
+   // @post the entry at index moved down until it comes before its children
+   void siftDown(std::size_t index);
+}; // end BinaryHeap
+
+#include "BinaryHeap.cpp"
+#endif
@@ -0,0 +1,276 @@
+/** Lock-free concurrent list for rosters that change while they are read.
+
+ Implementation file for the class ConcurrentList.
+ @file ConcurrentList.cpp */
+
+#include "ConcurrentList.hpp"  // Header file
+
+
+// constructor
+template<class T>
+ConcurrentList<T>::ConcurrentList() : head_(0), tail_(0), item_count_(0)
+{
+}  // end default constructor
+
+
+// destructor: every node still in the chain was never retired, so free it here
+template<class T>
+ConcurrentList<T>::~ConcurrentList()
+{
+   ListNode* cur_ptr = toNode(head_.load());
+   while (cur_ptr != nullptr)
+   {
+      ListNode* next_ptr = toNode(cur_ptr->next_.load());
+      delete cur_ptr;
+      cur_ptr = next_ptr;
+   }  // end while
+}  // end destructor
+
+
+/** @post new_entry is the first entry */
+template<class T>
+void ConcurrentList<T>::pushFront(const T& new_entry)
+{
+   ListNode* new_node_ptr = new ListNode(new_entry, 0);
+   std::uintptr_t first = head_.load();
+   do
+   {
+      new_node_ptr->next_.store(first, std::memory_order_relaxed);
+   } while (!head_.compare_exchange_weak(first, reinterpret_cast<std::uintptr_t>(new_node_ptr)));
+   item_count_++;
+}  // end pushFront
+
+
+/** @post new_entry is the last entry */
+template<class T>
+void ConcurrentList<T>::pushBack(const T& new_entry)
+{
+   ListNode* new_node_ptr = new ListNode(new_entry, 0);
+   EpochReclaimer::Guard guard(reclaimer_);
+
+   // Pinned before reading the hint, so its node cannot be freed under us
+   std::uint64_t hint = tail_.load();
+   ListNode* hint_ptr = tailNode(hint);
+   std::atomic<std::uintptr_t>* link = hint_ptr != nullptr ? &hint_ptr->next_ : &head_;
+   while (true)
+   {
+      std::uintptr_t value = link->load();
+      if (isMarked(value))
+      {
+         // The node owning link was removed under us; start over
+         link = &head_;
+      }
+      else if (value == 0)
+      {
+         // link ends the chain: claim it (fails if a node was appended or its owner removed)
+         if (link->compare_exchange_weak(value, reinterpret_cast<std::uintptr_t>(new_node_ptr)))
+            break;
+      }
+      else
+      {
+         link = &toNode(value)->next_;
+      }  // end if
+   }  // end while
+   item_count_++;
+
+   // Advance the hint unless a node was retired since it was read (the tag
+   // moved), in which case the new node might already be one of them
+   tail_.compare_exchange_strong(hint, packTail(new_node_ptr, hint >> TAIL_TAG_SHIFT));
+}  // end pushBack
+
+
+/** @return true if this call removed the first entry equal to an_entry */
+template<class T>
+bool ConcurrentList<T>::removeEntry(const T& an_entry)
+{
+   return removeIf([&an_entry](const T& entry) { return entry == an_entry; });
+}  // end removeEntry
+
+
+/** @return true if this call removed the first entry satisfying pred */
+template<class T>
+template<class Predicate>
+bool ConcurrentList<T>::removeIf(Predicate pred)
+{
+   EpochReclaimer::Guard guard(reclaimer_);
+   while (true)
+   {
+      std::atomic<std::uintptr_t>* prev_link = nullptr;
+      ListNode* cur_ptr = find(pred, prev_link);
+      if (cur_ptr == nullptr)
+         return false;
+
+      // Logical delete: mark cur's next pointer so nothing can be linked after it
+      std::uintptr_t succ = cur_ptr->next_.load();
+      if (isMarked(succ) || !cur_ptr->next_.compare_exchange_strong(succ, succ | MARK))
+         continue;  // another writer got there first; look again
+      item_count_--;
+
+      // Physical delete: unlink it, or leave it to the next find() that passes by
+      std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(cur_ptr);
+      if (prev_link->compare_exchange_strong(expected, succ))
+         retireNode(cur_ptr);
+      else
+         find([](const T&) { return false; }, prev_link);
+      return true;
+   }  // end while
+}  // end removeIf
+
+
+/** @return true if the entry was found and moved to the front */
+template<class T>
+bool ConcurrentList<T>::moveToFront(const T& an_entry)
+{
+   if (!removeEntry(an_entry))
+      return false;
+
+   pushFront(an_entry);
+   return true;
+}  // end moveToFront
+
+
+/**@return true if some entry equals an_entry */
+template<class T>
+bool ConcurrentList<T>::contains(const T& an_entry) const
+{
+   bool found = false;
+   forEach([&](const T& entry) {
+      found = (entry == an_entry);
+      return !found;
+   });
+   return found;
+}  // end contains
+
+
+/** Calls visit(entry) for each entry present when the walk reaches it */
+template<class T>
+template<class Visitor>
+int ConcurrentList<T>::forEach(Visitor visit) const
+{
+   EpochReclaimer::Guard guard(reclaimer_);
+   int visited = 0;
+   ListNode* cur_ptr = toNode(head_.load(std::memory_order_acquire));
+   while (cur_ptr != nullptr)
+   {
+      std::uintptr_t succ = cur_ptr->next_.load(std::memory_order_acquire);
+      if (!isMarked(succ))
+      {
+         visited++;
+         if (!visit(static_cast<const T&>(cur_ptr->item_)))
+            break;
+      }  // end if
+      cur_ptr = toNode(succ);
+   }  // end while
+   return visited;
+}  // end forEach
+
+
+/**@return the number of entries */
+template<class T>
+int ConcurrentList<T>::getLength() const
+{
+   return item_count_.load();
+}  // end getLength
+
+
+/**@return true if getLength() == 0 */
+template<class T>
+bool ConcurrentList<T>::isEmpty() const
+{
+   return getLength() == 0;
+}  // end isEmpty
+
+
+
+/************* PRIVATE METHODS ************/
+
+
+template<class T>
+typename ConcurrentList<T>::ListNode* ConcurrentList<T>::toNode(std::uintptr_t link)
+{
+   return reinterpret_cast<ListNode*>(link & ~MARK);
+}  // end toNode
+
+
+template<class T>
+bool ConcurrentList<T>::isMarked(std::uintptr_t link)
+{
+   return (link & MARK) != 0;
+}  // end isMarked
+
+
+template<class T>
+void ConcurrentList<T>::deleteNode(void* node)
+{
+   delete static_cast<ListNode*>(node);
+}  // end deleteNode
+
+
+// A node that does not fit below the tag leaves the hint empty, so pushBack
+// walks from the head instead
+template<class T>
+std::uint64_t ConcurrentList<T>::packTail(ListNode* node_ptr, std::uint64_t tag)
+{
+   std::uint64_t address = reinterpret_cast<std::uintptr_t>(node_ptr);
+   if ((address >> TAIL_TAG_SHIFT) != 0)
+      address = 0;
+   return (tag << TAIL_TAG_SHIFT) | address;
+}  // end packTail
+
+
+template<class T>
+typename ConcurrentList<T>::ListNode* ConcurrentList<T>::tailNode(std::uint64_t tail)
+{
+   return reinterpret_cast<ListNode*>(static_cast<std::uintptr_t>(tail & ((std::uint64_t(1) << TAIL_TAG_SHIFT) - 1)));
+}  // end tailNode
+
+
+// Drops the hint if it names node_ptr and bumps the tag either way, then retires the node
+template<class T>
+void ConcurrentList<T>::retireNode(ListNode* node_ptr)
+{
+   std::uint64_t tail = tail_.load();
+   std::uint64_t updated;
+   do
+   {
+      ListNode* hint_ptr = tailNode(tail) == node_ptr ? nullptr : tailNode(tail);
+      updated = packTail(hint_ptr, (tail >> TAIL_TAG_SHIFT) + 1);
+   } while (!tail_.compare_exchange_weak(tail, updated));
+   reclaimer_.retire(node_ptr, &ConcurrentList<T>::deleteNode);
+}  // end retireNode
+
+
+// Locates the first unmarked node satisfying pred, unlinking marked nodes on the way.
+template<class T>
+template<class Predicate>
+typename ConcurrentList<T>::ListNode* ConcurrentList<T>::find(Predicate pred, std::atomic<std::uintptr_t>*& prev_link)
+{
+retry:
+   prev_link = &head_;
+   ListNode* cur_ptr = toNode(prev_link->load());
+   while (cur_ptr != nullptr)
+   {
+      std::uintptr_t succ = cur_ptr->next_.load();
+      if (isMarked(succ))
+      {
+         // cur is logically deleted: help unlink it
+         std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(cur_ptr);
+         if (!prev_link->compare_exchange_strong(expected, succ & ~MARK))
+            goto retry;  // prev changed or was removed itself
+         retireNode(cur_ptr);
+         cur_ptr = toNode(succ);
+         continue;
+      }  // end if
+
+      if (pred(static_cast<const T&>(cur_ptr->item_)))
+         return cur_ptr;
+
+      prev_link = &cur_ptr->next_;
+      cur_ptr = toNode(succ);
+   }  // end while
+
+   return nullptr;
+}  // end find
+
+
+//  End of implementation file.
@@ -0,0 +1,112 @@
+/** Lock-free concurrent list for rosters that change while they are read.
+    Nodes are linked through atomic next pointers. Removal first marks the
+    removed node's next pointer (logical delete) and then unlinks it
+    (Harris-Michael), and unlinked nodes are freed through an EpochReclaimer,
+    so readers never block and never see freed memory while writers insert
+    and remove concurrently.
+
+    Unlike LinkedList this list is not positional: entries are added at the
+    front or back and removed by value or predicate, which is what a live
+    roster needs. StationManager can mirror its roster into one
+    (enableConcurrentReads): a read-only copy that threads other than the
+    roster's writer walk without locks (forEachStation).
+    @file ConcurrentList.hpp */
+
+#ifndef CONCURRENT_LIST_
+#define CONCURRENT_LIST_
+
+#include "EpochReclaimer.hpp"
+#include <atomic>
+#include <cstdint>
+
+template<class T>
+class ConcurrentList
+{
+public:
+   ConcurrentList();  // constructor
+   ~ConcurrentList(); // destructor; no other thread may use the list any more
+
+   ConcurrentList(const ConcurrentList<T>&) = delete;
+   ConcurrentList<T>& operator=(const ConcurrentList<T>&) = delete;
+
+   /** @post new_entry is the first entry. Lock-free. */
+   void pushFront(const T& new_entry);
+
+   /** @post new_entry is the last entry. Lock-free, and O(1) while the tail
+       hint holds: the walk starts at the last node appended instead of the
+       head, which it falls back to when a removal has dropped the hint. */
+   void pushBack(const T& new_entry);
+
+   /** Removes the first entry equal to an_entry.
+       @return true if this call removed it */
+   bool removeEntry(const T& an_entry);
+
+   /** Removes the first entry satisfying pred.
+       @return true if this call removed an entry */
+   template<class Predicate>
+   bool removeIf(Predicate pred);
+
+   /** Moves the first entry equal to an_entry to the front. Implemented as a
+       removal followed by pushFront: a forEach that overlaps the move may skip
+       the entry (it is never visited twice), while one that starts after the
+       move returns sees it at the front.
+       @return true if the entry was found and moved */
+   bool moveToFront(const T& an_entry);
+
+   /**@return true if some entry equals an_entry. Wait-free with respect to writers. */
+   bool contains(const T& an_entry) const;
+
+   /** Calls visit(entry) for each entry present when the walk reaches it,
+       front to back, without taking any lock. Returning false from visit stops
+       the walk early.
+       @return the number of entries visited */
+   template<class Visitor>
+   int forEach(Visitor visit) const;
+
+   /**@return the number of entries; exact when no writer is active */
+   int getLength() const;
+
+   /**@return true if getLength() == 0 */
+   bool isEmpty() const;
+
+private:
+   struct ListNode
+   {
+      T item_;
+      std::atomic<std::uintptr_t> next_;  // successor, low bit set once this node is removed
+
+      ListNode(const T& an_item, std::uintptr_t next) : item_(an_item), next_(next) {}
+   };
+
+   std::atomic<std::uintptr_t> head_;  // first node; never marked
+   // Hint for pushBack: a node at or before the end of the chain, packed with
+   // a tag in the top TAIL_TAG_SHIFT bits. Every retirement bumps the tag and
+   // drops the hint if it names the retired node, so a pushBack that raced
+   // with one cannot publish a node that is already freed (see retireNode).
+   std::atomic<std::uint64_t> tail_;
+   std::atomic<int> item_count_;
+   mutable EpochReclaimer reclaimer_;
+
+   static const std::uintptr_t MARK = 1;
+   static const int TAIL_TAG_SHIFT = 48;  // user-space pointers fit below this
+
+   static ListNode* toNode(std::uintptr_t link);
+   static bool isMarked(std::uintptr_t link);
+   static void deleteNode(void* node);
+   static std::uint64_t packTail(ListNode* node_ptr, std::uint64_t tag);
+   static ListNode* tailNode(std::uint64_t tail);
+
+   // Hands an unlinked node to the reclaimer, first making sure tail_ no
+   // longer names it. @pre the caller is pinned
+   void retireNode(ListNode* node_ptr);
+
+   // Locates the first unmarked node satisfying pred, unlinking marked nodes on
+   // the way. @pre the caller is pinned
+   // @param prev_link set to the link that points at the result (head_ or a next_)
+   // @return the node found, or nullptr
+   template<class Predicate>
+   ListNode* find(Predicate pred, std::atomic<std::uintptr_t>*& prev_link);
+}; // end ConcurrentList
+
+#include "ConcurrentList.cpp"
+#endif
@@ -2,24 +2,37 @@
 
 // Default Constructor
 Dish::Dish() 
-    : name_("UNKNOWN"), ingredients_({}), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER) {
+    : name_("UNKNOWN"), name_id_(SymbolTable::intern(name_)), ingredients_({}), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER), ingredients_version_(0) {
 }
 
 // Parameterized Constructor
 Dish::Dish(const std::string& name, const std::vector<Ingredient>& ingredients, int prep_time, double price, CuisineType cuisine_type)
-    : ingredients_(ingredients), prep_time_(prep_time), price_(price), cuisine_type_(cuisine_type) {
+    : prep_time_(prep_time), price_(price), cuisine_type_(cuisine_type), ingredients_version_(0) {
     setName(name);  // Use setName to validate the name
+    setIngredients(ingredients);  // Use setIngredients to intern the ingredient names
 }
 
 // Accessor Functions
-std::string Dish::getName() const {
+const std::string& Dish::getName() const {
     return name_;
 }
 
-std::vector<Ingredient> Dish::getIngredients() const {
+SymbolId Dish::getNameId() const {
+    return name_id_;
+}
+
+const std::vector<Ingredient>& Dish::getIngredients() const {
     return ingredients_;
 }
 
+const std::vector<SymbolId>& Dish::getIngredientIds() const {
+    return ingredient_ids_;
+}
+
+unsigned long Dish::getIngredientsVersion() const {
+    return ingredients_version_;
+}
+
 int Dish::getPrepTime() const {
     return prep_time_;
 }
@@ -47,10 +60,16 @@ void Dish::setName(const std::string& name) {
     } else {
         name_ = "UNKNOWN";
     }
+    name_id_ = SymbolTable::intern(name_);
 }
 
 void Dish::setIngredients(const std::vector<Ingredient>& ingredients) {
     ingredients_ = ingredients;
+    ingredient_ids_.clear();
+    for (const Ingredient& ingredient : ingredients_) {
+        ingredient_ids_.push_back(SymbolTable::intern(ingredient.name));
+    }
+    ingredients_version_++;
 }
 
 void Dish::setPrepTime(const int& prep_time) {
@@ -92,7 +111,7 @@ bool Dish::isValidName(const std::string& name) const {
 }
 
 bool Dish::operator==(const Dish& rhs) const {
-    return name_ == rhs.name_ && prep_time_ == rhs.prep_time_ && 
+    return name_id_ == rhs.name_id_ && prep_time_ == rhs.prep_time_ && 
     price_ == rhs.price_ && cuisine_type_ == rhs.cuisine_type_;
 }
 
@@ -7,6 +7,7 @@
 #include <iomanip> // For std::fixed and std::setprecision
 #include <cctype>  // For std::isalpha, std::isspace
 #include <queue>
+#include "SymbolTable.hpp"
 
 /**
  * Struct representing an ingredient.
@@ -66,12 +67,29 @@ public:
     /**
      * @return The name of the dish.
      */
-    std::string getName() const;
+    const std::string& getName() const;
+
+    /**
+     * @return The interned id of the dish's name.
+     */
+    SymbolId getNameId() const;
 
     /**
      * @return The list of ingredients used in the dish.
      */
-    std::vector<Ingredient> getIngredients() const;
+    const std::vector<Ingredient>& getIngredients() const;
+
+    /**
+     * @return The interned ids of the ingredients' names, in the same order
+     * as getIngredients().
+     */
+    const std::vector<SymbolId>& getIngredientIds() const;
+
+    /**
+     * @return A counter that changes whenever the ingredients are set, so
+     * anything derived from them can tell when it is out of date.
+     */
+    unsigned long getIngredientsVersion() const;
 
     /**
      * @return The preparation time in minutes.
@@ -166,10 +184,13 @@ public:
 
 private:
     std::string name_;
+    SymbolId name_id_;
     std::vector<Ingredient> ingredients_;
+    std::vector<SymbolId> ingredient_ids_;  // kept in step with ingredients_
     int prep_time_;
     double price_;
     CuisineType cuisine_type_;
+    unsigned long ingredients_version_;  // bumped by every setIngredients
 
     // Helper function to check if the name is valid
     /**
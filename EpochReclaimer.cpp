@@ -0,0 +1,124 @@
+/**
+ * @file EpochReclaimer.cpp
+ * @brief Implementation of epoch-based memory reclamation.
+ *
+ * @date December 1, 2024
+ * @author kufunei
+ */
+
+#include "EpochReclaimer.hpp"
+#include <stdexcept>
+
+namespace {
+
+// Slots are claimed by threads on first use and released at thread exit, so
+// any number of threads can come and go as long as at most MAX_THREADS
+// use reclaimers at the same time.
+std::atomic<bool> g_slot_taken[EpochReclaimer::MAX_THREADS];
+
+struct SlotOwner {
+    int slot;
+    SlotOwner() : slot(-1) {
+        for (int i = 0; i < EpochReclaimer::MAX_THREADS; i++) {
+            bool expected = false;
+            if (g_slot_taken[i].compare_exchange_strong(expected, true)) {
+                slot = i;
+                return;
+            }
+        }
+        throw std::runtime_error("EpochReclaimer: too many threads");
+    }
+    ~SlotOwner() {
+        g_slot_taken[slot].store(false);
+    }
+};
+
+}  // namespace
+
+// Default Constructor
+EpochReclaimer::EpochReclaimer() : global_epoch_(0) {
+    for (ThreadRecord& record : records_) {
+        record.state.store(0);
+        record.nesting = 0;
+        record.pending.store(0);
+    }
+}
+
+// Destructor
+EpochReclaimer::~EpochReclaimer() {
+    for (ThreadRecord& record : records_) {
+        for (const Retired& retired : record.retired) {
+            retired.deleter(retired.object);
+        }
+    }
+}
+
+// Pins the calling thread to the current epoch
+void EpochReclaimer::enter() {
+    ThreadRecord& record = records_[threadSlot()];
+    if (record.nesting++ == 0) {
+        std::uint64_t epoch = global_epoch_.load();
+        record.state.store((epoch << 1) | 1);  // seq_cst: visible before any shared load that follows
+    }
+}
+
+// Unpins the calling thread
+void EpochReclaimer::exit() {
+    ThreadRecord& record = records_[threadSlot()];
+    if (--record.nesting == 0) {
+        record.state.store(0, std::memory_order_release);
+    }
+}
+
+// Schedules an object for deletion
+void EpochReclaimer::retire(void* object, void (*deleter)(void*)) {
+    ThreadRecord& record = records_[threadSlot()];
+    record.retired.push_back(Retired{object, deleter, global_epoch_.load()});
+    record.pending.store(record.retired.size(), std::memory_order_relaxed);
+    if (record.retired.size() >= RECLAIM_THRESHOLD) {
+        tryAdvance();
+        reclaim(record);
+    }
+}
+
+// Number of retired objects not freed yet
+std::size_t EpochReclaimer::getPendingCount() const {
+    std::size_t pending = 0;
+    for (const ThreadRecord& record : records_) {
+        pending += record.pending.load(std::memory_order_relaxed);
+    }
+    return pending;
+}
+
+// helper: the calling thread's slot
+int EpochReclaimer::threadSlot() {
+    static thread_local SlotOwner owner;
+    return owner.slot;
+}
+
+// helper: advances the global epoch if every pinned thread has seen it
+void EpochReclaimer::tryAdvance() {
+    std::uint64_t epoch = global_epoch_.load();
+    for (const ThreadRecord& record : records_) {
+        std::uint64_t state = record.state.load();
+        if ((state & 1) != 0 && (state >> 1) != epoch) {
+            return;  // a pinned thread still runs in an older epoch
+        }
+    }
+    global_epoch_.compare_exchange_strong(epoch, epoch + 1);
+}
+
+// helper: frees the objects in record that are two epochs old
+void EpochReclaimer::reclaim(ThreadRecord& record) {
+    std::uint64_t epoch = global_epoch_.load();
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < record.retired.size(); i++) {
+        if (record.retired[i].epoch + 2 <= epoch) {
+            record.retired[i].deleter(record.retired[i].object);
+        } else {
+            record.retired[kept++] = record.retired[i];
+        }
+    }
+    record.retired.resize(kept);
+    record.pending.store(kept, std::memory_order_relaxed);
+}
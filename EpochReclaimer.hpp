@@ -0,0 +1,108 @@
+/**
+ * @file EpochReclaimer.hpp
+ * @brief Epoch-based memory reclamation for lock-free structures.
+ *
+ * A thread pins the current epoch (enter/exit, or an EpochReclaimer::Guard)
+ * while it may hold pointers into a shared structure. Unlinked objects are
+ * handed to retire() and freed only once every pinned thread has moved two
+ * epochs past the one in which they were retired, so readers never touch
+ * freed memory and never wait for writers.
+ *
+ * @date December 1, 2024
+ * @author kufunei
+ */
+
+#ifndef EPOCHRECLAIMER_HPP
+#define EPOCHRECLAIMER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class EpochReclaimer {
+public:
+    // Upper bound on threads that use reclaimers at the same time.
+    static const int MAX_THREADS = 128;
+
+    /**
+     * Default Constructor
+     * @post: Epoch 0, no thread pinned, nothing retired.
+     */
+    EpochReclaimer();
+
+    /**
+     * Destructor
+     * @pre: No thread is pinned.
+     * @post: Every retired object has been freed.
+     */
+    ~EpochReclaimer();
+
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+    /**
+     * Pins the calling thread to the current epoch. Calls may nest.
+     * @post: Objects retired from now on stay valid for this thread until exit().
+     */
+    void enter();
+
+    /**
+     * Unpins the calling thread once the outermost enter() is matched.
+     */
+    void exit();
+
+    /**
+     * Schedules an object for deletion once no pinned thread can still reach it.
+     * @param object A pointer that is already unreachable for newly arriving threads.
+     * @param deleter The function that frees object.
+     */
+    void retire(void* object, void (*deleter)(void*));
+
+    /**
+     * @return: The number of retired objects not freed yet (for diagnostics).
+     */
+    std::size_t getPendingCount() const;
+
+    /**
+     * Pins the thread for the lifetime of the guard.
+     */
+    class Guard {
+    public:
+        explicit Guard(EpochReclaimer& reclaimer) : reclaimer_(reclaimer) { reclaimer_.enter(); }
+        ~Guard() { reclaimer_.exit(); }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    private:
+        EpochReclaimer& reclaimer_;
+    };
+
+private:
+    struct Retired {
+        void* object;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+    // One record per thread slot, padded so pins do not false-share.
+    struct alignas(64) ThreadRecord {
+        std::atomic<std::uint64_t> state;  // (epoch << 1) | 1 while pinned, 0 otherwise
+        int nesting;                       // owner-only
+        std::vector<Retired> retired;      // owner-only
+        std::atomic<std::size_t> pending;  // retired.size(), readable by others
+    };
+
+    static const std::size_t RECLAIM_THRESHOLD = 64;
+
+    std::atomic<std::uint64_t> global_epoch_;
+    ThreadRecord records_[MAX_THREADS];
+
+    // helper: the calling thread's slot, shared by every reclaimer
+    static int threadSlot();
+    // helper: advances the global epoch if every pinned thread has seen it
+    void tryAdvance();
+    // helper: frees the objects in record that are two epochs old
+    void reclaim(ThreadRecord& record);
+};
+
+#endif // EPOCHRECLAIMER_HPP
@@ -0,0 +1,241 @@
+/** ADT dictionary: open-addressing flat hash map that keeps insertion order.
+
+ Implementation file for the class FlatHashMap.
+ @file FlatHashMap.cpp */
+
+#include "FlatHashMap.hpp"  // Header file
+#include <utility>
+
+
+// constructor
+template<class K, class V, class Hash>
+FlatHashMap<K, V, Hash>::FlatHashMap() : slots_(8, EMPTY), live_count_(0)
+{
+}  // end constructor
+
+
+template<class K, class V, class Hash>
+std::size_t FlatHashMap<K, V, Hash>::size() const
+{
+   return live_count_;
+}  // end size
+
+
+template<class K, class V, class Hash>
+bool FlatHashMap<K, V, Hash>::isEmpty() const
+{
+   return live_count_ == 0;
+}  // end isEmpty
+
+
+// Fibonacci hashing spreads keys whose hashes are small consecutive
+// integers, like interned ids, over the whole table
+template<class K, class V, class Hash>
+std::size_t FlatHashMap<K, V, Hash>::homeSlot(const K& key) const
+{
+   std::uint64_t mixed = static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+   return static_cast<std::size_t>(mixed >> 32) & (slots_.size() - 1);
+}  // end homeSlot
+
+
+template<class K, class V, class Hash>
+std::size_t FlatHashMap<K, V, Hash>::probe(const K& key) const
+{
+   std::size_t mask = slots_.size() - 1;
+   std::size_t slot = homeSlot(key);
+   while (slots_[slot] != EMPTY && !(entries_[slots_[slot]].key_ == key))
+   {
+      slot = (slot + 1) & mask;
+   }  // end while
+   return slot;
+}  // end probe
+
+
+/** @return the value stored under key, or nullptr */
+template<class K, class V, class Hash>
+V* FlatHashMap<K, V, Hash>::find(const K& key)
+{
+   std::int32_t position = slots_[probe(key)];
+   return position == EMPTY ? nullptr : &entries_[position].value_;
+}  // end find
+
+
+template<class K, class V, class Hash>
+const V* FlatHashMap<K, V, Hash>::find(const K& key) const
+{
+   std::int32_t position = slots_[probe(key)];
+   return position == EMPTY ? nullptr : &entries_[position].value_;
+}  // end find
+
+
+/** @return where key's entry sits, or -1 */
+template<class K, class V, class Hash>
+int FlatHashMap<K, V, Hash>::indexOf(const K& key) const
+{
+   return slots_[probe(key)];
+}  // end indexOf
+
+
+template<class K, class V, class Hash>
+std::size_t FlatHashMap<K, V, Hash>::indexLimit() const
+{
+   return entries_.size();
+}  // end indexLimit
+
+
+template<class K, class V, class Hash>
+V& FlatHashMap<K, V, Hash>::valueAt(int index)
+{
+   return entries_[index].value_;
+}  // end valueAt
+
+
+template<class K, class V, class Hash>
+const V& FlatHashMap<K, V, Hash>::valueAt(int index) const
+{
+   return entries_[index].value_;
+}  // end valueAt
+
+
+/** @post value is stored under key, unless key already had a value */
+template<class K, class V, class Hash>
+std::pair<V*, bool> FlatHashMap<K, V, Hash>::insert(const K& key, const V& value)
+{
+   std::size_t slot = probe(key);
+   if (slots_[slot] != EMPTY)
+   {
+      return std::make_pair(&entries_[slots_[slot]].value_, false);
+   }
+   if (2 * (entries_.size() + 1) > slots_.size())
+   {
+      // out of room at half load: compact, or grow if most entries are live
+      rebuild(live_count_ + 1);
+      slot = probe(key);
+   }
+   slots_[slot] = static_cast<std::int32_t>(entries_.size());
+   entries_.push_back(Entry{key, value, true});
+   live_count_++;
+   return std::make_pair(&entries_.back().value_, true);
+}  // end insert
+
+
+/** @post key has no value */
+template<class K, class V, class Hash>
+bool FlatHashMap<K, V, Hash>::erase(const K& key)
+{
+   std::size_t slot = probe(key);
+   if (slots_[slot] == EMPTY)
+   {
+      return false;
+   }
+   entries_[slots_[slot]].live_ = false;
+   live_count_--;
+
+   // Backward shift: a later key in the run may move into the hole if the
+   // hole lies between its home slot and where it sits now
+   std::size_t mask = slots_.size() - 1;
+   std::size_t hole = slot;
+   for (std::size_t next = (hole + 1) & mask; slots_[next] != EMPTY; next = (next + 1) & mask)
+   {
+      std::size_t home = homeSlot(entries_[slots_[next]].key_);
+      if (((next - home) & mask) >= ((next - hole) & mask))
+      {
+         slots_[hole] = slots_[next];
+         hole = next;
+      }
+   }  // end for
+   slots_[hole] = EMPTY;
+
+   if (entries_.size() - live_count_ > live_count_ && entries_.size() > 8)
+   {
+      rebuild(live_count_);
+   }
+   return true;
+}  // end erase
+
+
+template<class K, class V, class Hash>
+void FlatHashMap<K, V, Hash>::clear()
+{
+   entries_.clear();
+   slots_.assign(slots_.size(), EMPTY);
+   live_count_ = 0;
+}  // end clear
+
+
+template<class K, class V, class Hash>
+void FlatHashMap<K, V, Hash>::reserve(std::size_t count)
+{
+   if (2 * count > slots_.size())
+   {
+      rebuild(count);
+   }
+   entries_.reserve(count);
+}  // end reserve
+
+
+template<class K, class V, class Hash>
+void FlatHashMap<K, V, Hash>::rebuild(std::size_t count)
+{
+   std::size_t capacity = slots_.size();
+   while (2 * count > capacity)
+   {
+      capacity *= 2;
+   }  // end while
+
+   std::size_t kept = 0;
+   for (std::size_t i = 0; i < entries_.size(); i++)
+   {
+      if (entries_[i].live_)
+      {
+         if (kept != i)
+         {
+            entries_[kept] = std::move(entries_[i]);
+         }
+         kept++;
+      }
+   }  // end for
+   entries_.erase(entries_.begin() + kept, entries_.end());
+
+   slots_.assign(capacity, EMPTY);
+   std::size_t mask = capacity - 1;
+   for (std::size_t i = 0; i < entries_.size(); i++)
+   {
+      std::size_t slot = homeSlot(entries_[i].key_);
+      while (slots_[slot] != EMPTY)
+      {
+         slot = (slot + 1) & mask;
+      }  // end while
+      slots_[slot] = static_cast<std::int32_t>(i);
+   }  // end for
+}  // end rebuild
+
+
+/** Calls visit(key, value) for each entry, in insertion order */
+template<class K, class V, class Hash>
+template<class Visitor>
+void FlatHashMap<K, V, Hash>::forEach(Visitor visit) const
+{
+   for (const Entry& entry : entries_)
+   {
+      if (entry.live_)
+      {
+         visit(entry.key_, entry.value_);
+      }
+   }  // end for
+}  // end forEach
+
+
+/** Calls visit(index, key, value) for each entry, in insertion order */
+template<class K, class V, class Hash>
+template<class Visitor>
+void FlatHashMap<K, V, Hash>::forEachIndexed(Visitor visit) const
+{
+   for (std::size_t i = 0; i < entries_.size(); i++)
+   {
+      if (entries_[i].live_)
+      {
+         visit(static_cast<int>(i), entries_[i].key_, entries_[i].value_);
+      }
+   }  // end for
+}  // end forEachIndexed
@@ -0,0 +1,101 @@
+/** ADT dictionary: open-addressing flat hash map that keeps insertion order.
+    Entries live in one array in the order they were first inserted. A
+    second, power-of-two sized table of array positions is probed linearly
+    from each key's hash, so a lookup reads a few adjacent ints and then one
+    entry, with no per-entry allocation. The table is kept at most half full.
+
+    erase marks the entry dead in place instead of shifting the array, and
+    closes the gap in the probe table by moving later keys of the same run
+    back (no tombstones in the table). Once dead entries outnumber live
+    ones, the array is compacted and the table rebuilt, so every operation
+    is O(1) amortized. forEach visits live entries in insertion order; a key
+    that is erased and inserted again goes to the end.
+    @file FlatHashMap.hpp */
+
+#ifndef FLAT_HASH_MAP_
+#define FLAT_HASH_MAP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+template<class K, class V, class Hash = std::hash<K>>
+class FlatHashMap
+{
+public:
+   FlatHashMap(); // constructor
+
+   /**@return the number of entries */
+   std::size_t size() const;
+
+   /**@return true if the map has no entries */
+   bool isEmpty() const;
+
+   /**@return the value stored under key, or nullptr if there is none */
+   V* find(const K& key);
+   const V* find(const K& key) const;
+
+   /**@return where key's entry sits, or -1 if there is none. Positions stay
+      valid until the next insert of a new key or erase */
+   int indexOf(const K& key) const;
+
+   /**@return a bound on positions: every one from indexOf is below it */
+   std::size_t indexLimit() const;
+
+   /**@return the value of the entry at a position from indexOf */
+   V& valueAt(int index);
+   const V& valueAt(int index) const;
+
+   /**@post value is stored under key, unless key already had a value
+      @return the value stored under key, and true if it was inserted */
+   std::pair<V*, bool> insert(const K& key, const V& value);
+
+   /**@post key has no value
+      @return true if it had one */
+   bool erase(const K& key);
+
+   /**@post the map is empty */
+   void clear();
+
+   /**@post the map holds count entries without growing its table */
+   void reserve(std::size_t count);
+
+   /** Calls visit(key, value) for each entry, in insertion order. The map
+       may not be changed meanwhile. */
+   template<class Visitor>
+   void forEach(Visitor visit) const;
+
+   /** Same as forEach, but calls visit(index, key, value), index being the
+       entry's position as indexOf would return it. */
+   template<class Visitor>
+   void forEachIndexed(Visitor visit) const;
+
+private:
+   struct Entry
+   {
+      K key_;
+      V value_;
+      bool live_;
+   };
+
+   static constexpr std::int32_t EMPTY = -1;
+
+   std::vector<Entry> entries_;       // insertion order, dead ones included
+   std::vector<std::int32_t> slots_;  // positions in entries_, or EMPTY
+   std::size_t live_count_;
+   Hash hash_;
+
+   // the slot a key's probe starts at
+   std::size_t homeSlot(const K& key) const;
+
+   // the slot holding key, or the empty slot ending its run
+   std::size_t probe(const K& key) const;
+
+   // @post slots_ has room for count entries at half load and indexes every
+   // live entry; dead entries are dropped from entries_
+   void rebuild(std::size_t count);
+}; // end FlatHashMap
+
+#include "FlatHashMap.cpp"
+#endif
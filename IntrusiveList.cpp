@@ -0,0 +1,554 @@
+/** ADT list: intrusive doubly linked implementation.
+
+ Implementation file for the class IntrusiveList.
+ @file IntrusiveList.cpp */
+
+#include "IntrusiveList.hpp"  // Header file
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+
+/************* HOOK ************/
+
+
+template<class T>
+IntrusiveListHook<T>::IntrusiveListHook() : prev_(nullptr), next_(nullptr), owner_(nullptr)
+{
+}  // end default constructor
+
+template<class T>
+IntrusiveListHook<T>::IntrusiveListHook(const IntrusiveListHook<T>&) : prev_(nullptr), next_(nullptr), owner_(nullptr)
+{
+}  // end copy constructor
+
+template<class T>
+IntrusiveListHook<T>& IntrusiveListHook<T>::operator=(const IntrusiveListHook<T>&)
+{
+   return *this;
+}  // end operator=
+
+// An entry destroyed while in a list takes itself out, so the list never
+// holds a dangling entry
+template<class T>
+IntrusiveListHook<T>::~IntrusiveListHook()
+{
+   if (owner_ != nullptr)
+   {
+      IntrusiveList<T>* owner_ptr = owner_;
+      owner_ptr->unlinkHook(this);
+      owner_ptr->resetCursor();
+   }  // end if
+}  // end destructor
+
+template<class T>
+bool IntrusiveListHook<T>::isLinked() const
+{
+   return owner_ != nullptr;
+}  // end isLinked
+
+
+
+/************* ITERATOR ************/
+
+
+template<class T>
+IntrusiveListIterator<T>::IntrusiveListIterator() : hook_ptr_(nullptr)
+{
+}  // end default constructor
+
+template<class T>
+IntrusiveListIterator<T>::IntrusiveListIterator(IntrusiveListHook<T>* hook_ptr) : hook_ptr_(hook_ptr)
+{
+}  // end constructor
+
+template<class T>
+typename IntrusiveListIterator<T>::reference IntrusiveListIterator<T>::operator*() const
+{
+   return static_cast<T*>(hook_ptr_);
+}  // end operator*
+
+template<class T>
+IntrusiveListIterator<T>& IntrusiveListIterator<T>::operator++()
+{
+   hook_ptr_ = hook_ptr_->next_;
+   return *this;
+}  // end operator++
+
+template<class T>
+IntrusiveListIterator<T> IntrusiveListIterator<T>::operator++(int)
+{
+   IntrusiveListIterator<T> previous = *this;
+   hook_ptr_ = hook_ptr_->next_;
+   return previous;
+}  // end operator++
+
+template<class T>
+bool IntrusiveListIterator<T>::operator==(const IntrusiveListIterator<T>& rhs) const
+{
+   return hook_ptr_ == rhs.hook_ptr_;
+}  // end operator==
+
+template<class T>
+bool IntrusiveListIterator<T>::operator!=(const IntrusiveListIterator<T>& rhs) const
+{
+   return hook_ptr_ != rhs.hook_ptr_;
+}  // end operator!=
+
+
+
+/************* LIST ************/
+
+
+// constructor
+template<class T>
+IntrusiveList<T>::IntrusiveList()
+   : head_ptr_(nullptr), tail_ptr_(nullptr), item_count_(0), cursor_ptr_(nullptr), cursor_pos_(0)
+{
+}  // end default constructor
+
+
+// move constructor
+template<class T>
+IntrusiveList<T>::IntrusiveList(IntrusiveList<T>&& a_list) noexcept : IntrusiveList()
+{
+   swap(a_list);
+}  // end move constructor
+
+
+// destructor
+template<class T>
+IntrusiveList<T>::~IntrusiveList()
+{
+   clear();
+}  // end destructor
+
+
+// move assignment
+template<class T>
+IntrusiveList<T>& IntrusiveList<T>::operator=(IntrusiveList<T>&& a_list) noexcept
+{
+   if (this != &a_list)
+   {
+      clear();
+      swap(a_list);
+   }  // end if
+   return *this;
+}  // end operator=
+
+
+// Every entry records its list, so both chains are walked to update them
+template<class T>
+void IntrusiveList<T>::swap(IntrusiveList<T>& a_list) noexcept
+{
+   std::swap(head_ptr_, a_list.head_ptr_);
+   std::swap(tail_ptr_, a_list.tail_ptr_);
+   std::swap(item_count_, a_list.item_count_);
+   std::swap(cursor_ptr_, a_list.cursor_ptr_);
+   std::swap(cursor_pos_, a_list.cursor_pos_);
+   for (HookType* hook_ptr = head_ptr_; hook_ptr != nullptr; hook_ptr = hook_ptr->next_)
+      hook_ptr->owner_ = this;
+   for (HookType* hook_ptr = a_list.head_ptr_; hook_ptr != nullptr; hook_ptr = hook_ptr->next_)
+      hook_ptr->owner_ = &a_list;
+}  // end swap
+
+
+template<class T>
+bool IntrusiveList<T>::isEmpty() const
+{
+   return item_count_ == 0;
+}  // end isEmpty
+
+
+template<class T>
+int IntrusiveList<T>::getLength() const
+{
+   return item_count_;
+}  // end getLength
+
+
+template<class T>
+bool IntrusiveList<T>::insert(int position, T* new_entry)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_) &&
+                         (new_entry != nullptr) && !new_entry->isLinked();
+   if (able_to_insert)
+   {
+      HookType* next_ptr = (position == item_count_) ? nullptr : getHookAt(position);
+      linkBefore(next_ptr, new_entry);
+
+      // The cached hook is unchanged, but it moves one position back
+      if (cursor_ptr_ != nullptr && position <= cursor_pos_)
+         cursor_pos_++;
+   }  // end if
+
+   return able_to_insert;
+}  // end insert
+
+
+template<class T>
+bool IntrusiveList<T>::pushBack(T* new_entry)
+{
+   return insert(item_count_, new_entry);
+}  // end pushBack
+
+
+// Entries are linked one by one; if one turns out not to be free, the ones
+// linked so far are taken out again so the list is unchanged
+template<class T>
+template<class InputIterator, class>
+bool IntrusiveList<T>::insert(int position, InputIterator first, InputIterator last)
+{
+   if (position < 0 || position > item_count_)
+      return false;
+
+   int next_position = position;
+   for (; first != last; ++first, ++next_position)
+   {
+      if (!insert(next_position, *first))
+      {
+         while (next_position-- > position)
+            remove(position);
+         return false;
+      }  // end if
+   }  // end for
+   return true;
+}  // end insert
+
+
+template<class T>
+bool IntrusiveList<T>::insert(int position, std::initializer_list<T*> entries)
+{
+   return insert(position, entries.begin(), entries.end());
+}  // end insert
+
+
+template<class T>
+void IntrusiveList<T>::append(IntrusiveList<T>&& a_list)
+{
+   if (this == &a_list || a_list.isEmpty())
+      return;
+
+   for (HookType* hook_ptr = a_list.head_ptr_; hook_ptr != nullptr; hook_ptr = hook_ptr->next_)
+      hook_ptr->owner_ = this;
+   if (tail_ptr_ == nullptr)
+   {
+      head_ptr_ = a_list.head_ptr_;
+   }
+   else
+   {
+      tail_ptr_->next_ = a_list.head_ptr_;
+      a_list.head_ptr_->prev_ = tail_ptr_;
+   }  // end if
+   tail_ptr_ = a_list.tail_ptr_;
+   item_count_ += a_list.item_count_;
+
+   a_list.head_ptr_ = nullptr;
+   a_list.tail_ptr_ = nullptr;
+   a_list.item_count_ = 0;
+   a_list.resetCursor();
+}  // end append
+
+
+template<class T>
+bool IntrusiveList<T>::remove(int position)
+{
+   bool able_to_remove = (position >= 0) && (position < item_count_);
+   if (able_to_remove)
+   {
+      HookType* hook_ptr = getHookAt(position);
+
+      // Keep the cursor valid: step it back to the previous entry if its own goes away
+      if (cursor_ptr_ == hook_ptr && hook_ptr->prev_ == nullptr)
+      {
+         resetCursor();
+      }
+      else if (cursor_ptr_ == hook_ptr)
+      {
+         cursor_ptr_ = hook_ptr->prev_;
+         cursor_pos_ = position - 1;
+      }
+      else if (cursor_ptr_ != nullptr && position < cursor_pos_)
+      {
+         cursor_pos_--;
+      }  // end if
+      unlinkHook(hook_ptr);
+   }  // end if
+
+   return able_to_remove;
+}  // end remove
+
+
+template<class T>
+bool IntrusiveList<T>::removeEntry(T* an_entry)
+{
+   HookType* hook_ptr = an_entry;
+   bool able_to_remove = (an_entry != nullptr) && (hook_ptr->owner_ == this);
+   if (able_to_remove)
+   {
+      // The entry's position is not known, so neither is the cursor's any more
+      unlinkHook(hook_ptr);
+      resetCursor();
+   }  // end if
+
+   return able_to_remove;
+}  // end removeEntry
+
+
+template<class T>
+void IntrusiveList<T>::clear()
+{
+   HookType* hook_ptr = head_ptr_;
+   while (hook_ptr != nullptr)
+   {
+      HookType* next_ptr = hook_ptr->next_;
+      hook_ptr->prev_ = nullptr;
+      hook_ptr->next_ = nullptr;
+      hook_ptr->owner_ = nullptr;
+      hook_ptr = next_ptr;
+   }  // end while
+   head_ptr_ = nullptr;
+   tail_ptr_ = nullptr;
+   item_count_ = 0;
+   resetCursor();
+}  // end clear
+
+
+template<class T>
+bool IntrusiveList<T>::moveToFront(int position)
+{
+   bool able_to_move = (position >= 0) && (position < item_count_);
+   if (able_to_move && position > 0)
+   {
+      HookType* hook_ptr = getHookAt(position);
+      unlinkHook(hook_ptr);
+      linkBefore(head_ptr_, hook_ptr);
+      resetCursor();
+   }  // end if
+
+   return able_to_move;
+}  // end moveToFront
+
+
+template<class T>
+bool IntrusiveList<T>::moveAfter(int position, int target_position)
+{
+   bool able_to_move = (position >= 0) && (position < item_count_) &&
+                       (target_position >= 0) && (target_position < item_count_) &&
+                       (position != target_position);
+   if (able_to_move)
+   {
+      HookType* hook_ptr = getHookAt(position);
+      HookType* dest_ptr = getHookAt(target_position);
+      if (dest_ptr->next_ != hook_ptr)
+      {
+         unlinkHook(hook_ptr);
+         linkBefore(dest_ptr->next_, hook_ptr);
+      }  // end if
+      resetCursor();
+   }  // end if
+
+   return able_to_move;
+}  // end moveAfter
+
+
+template<class T>
+bool IntrusiveList<T>::swapEntries(int position_a, int position_b)
+{
+   bool able_to_swap = (position_a >= 0) && (position_a < item_count_) &&
+                       (position_b >= 0) && (position_b < item_count_);
+   if (able_to_swap && position_a != position_b)
+   {
+      if (position_b < position_a)
+         std::swap(position_a, position_b);
+      HookType* a_ptr = getHookAt(position_a);
+      HookType* b_ptr = getHookAt(position_b);
+
+      // Take b out and put it where a was, then put a where b was (already
+      // the case when they were neighbours)
+      HookType* after_a = a_ptr->next_;
+      HookType* after_b = b_ptr->next_;
+      unlinkHook(b_ptr);
+      linkBefore(a_ptr, b_ptr);
+      if (after_a != b_ptr)
+      {
+         unlinkHook(a_ptr);
+         linkBefore(after_b, a_ptr);
+      }  // end if
+      resetCursor();
+   }  // end if
+
+   return able_to_swap;
+}  // end swapEntries
+
+
+template<class T>
+template<class Predicate>
+int IntrusiveList<T>::moveToFrontIf(Predicate pred)
+{
+   int position = 0;
+   for (HookType* hook_ptr = head_ptr_; hook_ptr != nullptr; hook_ptr = hook_ptr->next_, position++)
+   {
+      if (pred(entryOf(hook_ptr)))
+      {
+         if (position > 0)
+         {
+            unlinkHook(hook_ptr);
+            linkBefore(head_ptr_, hook_ptr);
+            resetCursor();
+         }  // end if
+         return position;
+      }  // end if
+   }  // end for
+
+   return -1;
+}  // end moveToFrontIf
+
+
+template<class T>
+T* IntrusiveList<T>::getEntry(int position) const
+{
+   if (position < 0 || position >= item_count_)
+   {
+      std::string message = "getEntry() called with an empty list or ";
+      message = message + "invalid position.";
+      throw(PrecondViolatedExcep(message));
+   }  // end if
+   return entryOf(getHookAt(position));
+}  // end getEntry
+
+
+template<class T>
+T* IntrusiveList<T>::getEntry(int position)
+{
+   if (position < 0 || position >= item_count_)
+   {
+      // the const lookup throws the same exception
+      const IntrusiveList<T>& self = *this;
+      self.getEntry(position);
+   }  // end if
+   return entryOf(getHookAt(position));
+}  // end getEntry
+
+
+template<class T>
+typename IntrusiveList<T>::iterator IntrusiveList<T>::begin() const
+{
+   return iterator(head_ptr_);
+}  // end begin
+
+template<class T>
+typename IntrusiveList<T>::const_iterator IntrusiveList<T>::cbegin() const
+{
+   return const_iterator(head_ptr_);
+}  // end cbegin
+
+template<class T>
+typename IntrusiveList<T>::iterator IntrusiveList<T>::end() const
+{
+   return iterator();
+}  // end end
+
+template<class T>
+typename IntrusiveList<T>::const_iterator IntrusiveList<T>::cend() const
+{
+   return const_iterator();
+}  // end cend
+
+
+
+/************* PROTECTED METHODS ************/
+
+
+// Locates the hook at position and leaves the cursor on it.
+template<class T>
+typename IntrusiveList<T>::HookType* IntrusiveList<T>::getHookAt(int position)
+{
+   const IntrusiveList<T>& self = *this;
+   HookType* hook_ptr = self.getHookAt(position);
+   cursor_ptr_ = hook_ptr;
+   cursor_pos_ = position;
+   return hook_ptr;
+}  // end getHookAt
+
+
+// Walks from whichever of head, tail and cursor is nearest to position.
+template<class T>
+typename IntrusiveList<T>::HookType* IntrusiveList<T>::getHookAt(int position) const
+{
+   HookType* hook_ptr = head_ptr_;
+   int at = 0;
+   int distance = position;
+   if (item_count_ - 1 - position < distance)
+   {
+      hook_ptr = tail_ptr_;
+      at = item_count_ - 1;
+      distance = at - position;
+   }  // end if
+   if (cursor_ptr_ != nullptr && std::abs(cursor_pos_ - position) < distance)
+   {
+      hook_ptr = cursor_ptr_;
+      at = cursor_pos_;
+   }  // end if
+
+   for (; at < position; at++)
+      hook_ptr = hook_ptr->next_;
+   for (; at > position; at--)
+      hook_ptr = hook_ptr->prev_;
+   return hook_ptr;
+}  // end getHookAt
+
+
+template<class T>
+void IntrusiveList<T>::linkBefore(HookType* next_ptr, HookType* hook_ptr)
+{
+   HookType* prev_ptr = (next_ptr == nullptr) ? tail_ptr_ : next_ptr->prev_;
+   hook_ptr->prev_ = prev_ptr;
+   hook_ptr->next_ = next_ptr;
+   hook_ptr->owner_ = this;
+   if (prev_ptr == nullptr)
+      head_ptr_ = hook_ptr;
+   else
+      prev_ptr->next_ = hook_ptr;
+   if (next_ptr == nullptr)
+      tail_ptr_ = hook_ptr;
+   else
+      next_ptr->prev_ = hook_ptr;
+   item_count_++;
+}  // end linkBefore
+
+
+template<class T>
+void IntrusiveList<T>::unlinkHook(HookType* hook_ptr)
+{
+   if (hook_ptr->prev_ == nullptr)
+      head_ptr_ = hook_ptr->next_;
+   else
+      hook_ptr->prev_->next_ = hook_ptr->next_;
+   if (hook_ptr->next_ == nullptr)
+      tail_ptr_ = hook_ptr->prev_;
+   else
+      hook_ptr->next_->prev_ = hook_ptr->prev_;
+   hook_ptr->prev_ = nullptr;
+   hook_ptr->next_ = nullptr;
+   hook_ptr->owner_ = nullptr;
+   item_count_--;
+}  // end unlinkHook
+
+
+template<class T>
+void IntrusiveList<T>::resetCursor()
+{
+   cursor_ptr_ = nullptr;
+   cursor_pos_ = 0;
+}  // end resetCursor
+
+
+template<class T>
+T* IntrusiveList<T>::entryOf(HookType* hook_ptr)
+{
+   return static_cast<T*>(hook_ptr);
+}  // end entryOf
+
+
+//  End of implementation file.
@@ -0,0 +1,194 @@
+/** ADT list: intrusive doubly linked implementation.
+    Instead of wrapping each entry in a separately allocated node, the links
+    live inside the entries: a class T joins lists by deriving from
+    IntrusiveListHook<T>. The list stores T* entries, so it offers the same
+    positional interface as LinkedList<T*> and can stand in for it as the
+    base of StationManager, with no allocation per entry and O(1) removal of
+    a given entry.
+
+    The list does not own its entries. An entry belongs to at most one list
+    at a time, and destroying an entry unlinks it from its list.
+    @file IntrusiveList.hpp */
+
+#ifndef INTRUSIVE_LIST_
+#define INTRUSIVE_LIST_
+
+#include "PrecondViolatedExcep.hpp"
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+
+template<class T> class IntrusiveList;
+template<class T> class IntrusiveListIterator;
+
+// Links embedded in each entry. Copying an entry does not copy its membership.
+template<class T>
+class IntrusiveListHook
+{
+public:
+   IntrusiveListHook();
+   IntrusiveListHook(const IntrusiveListHook<T>& a_hook);  // the copy starts unlinked
+   IntrusiveListHook<T>& operator=(const IntrusiveListHook<T>& a_hook);  // keeps this entry's own links
+   ~IntrusiveListHook();  // unlinks the entry from its list, if any
+
+   /**@return true if the entry is in a list */
+   bool isLinked() const;
+
+private:
+   friend class IntrusiveList<T>;
+   friend class IntrusiveListIterator<T>;
+
+   IntrusiveListHook<T>* prev_;
+   IntrusiveListHook<T>* next_;
+   IntrusiveList<T>* owner_;  // list holding the entry, nullptr if none
+}; // end IntrusiveListHook
+
+
+// Forward iterator over an intrusive list. Entries are T* values.
+template<class T>
+class IntrusiveListIterator
+{
+public:
+   typedef std::forward_iterator_tag iterator_category;
+   typedef T* value_type;
+   typedef std::ptrdiff_t difference_type;
+   typedef T* const* pointer;
+   typedef T* reference;
+
+   IntrusiveListIterator(); // past-the-end iterator
+   explicit IntrusiveListIterator(IntrusiveListHook<T>* hook_ptr);
+
+   reference operator*() const;
+   IntrusiveListIterator<T>& operator++();   // pre-increment
+   IntrusiveListIterator<T> operator++(int); // post-increment
+
+   bool operator==(const IntrusiveListIterator<T>& rhs) const;
+   bool operator!=(const IntrusiveListIterator<T>& rhs) const;
+
+private:
+   IntrusiveListHook<T>* hook_ptr_;
+}; // end IntrusiveListIterator
+
+
+template<class T>
+class IntrusiveList
+{
+public:
+   typedef IntrusiveListIterator<T> iterator;
+   typedef IntrusiveListIterator<T> const_iterator;
+
+   IntrusiveList(); // constructor
+   IntrusiveList(IntrusiveList<T>&& a_list) noexcept; // move constructor; O(n), entries learn their new list
+   virtual ~IntrusiveList(); // destructor; unlinks every entry
+
+   // An entry can be in one list only, so lists are not copyable
+   IntrusiveList(const IntrusiveList<T>&) = delete;
+   IntrusiveList<T>& operator=(const IntrusiveList<T>&) = delete;
+
+   IntrusiveList<T>& operator=(IntrusiveList<T>&& a_list) noexcept;
+   void swap(IntrusiveList<T>& a_list) noexcept;
+
+   /**@return true if list is empty - item_count_ == 0 */
+   bool isEmpty() const;
+
+   /**@return the number of items in the list - item_count_ */
+   int getLength() const;
+
+   /**
+    @param position indicating point of insertion
+    @param new_entry to be inserted in list; must not be in any list
+    @post new_entry is at position in list
+    @return true if valid position (0 <= position <= item_count_) and new_entry
+            is a free entry */
+   bool insert(int position, T* new_entry);
+
+   /**@post new_entry is the last entry. O(1)
+      @return true if new_entry was a free entry */
+   bool pushBack(T* new_entry);
+
+   /** Same as insert, for the entries [first, last), in order. If one of them
+       is not free, none is inserted and false is returned. */
+   template<class InputIterator, class = typename std::iterator_traits<InputIterator>::iterator_category>
+   bool insert(int position, InputIterator first, InputIterator last);
+   bool insert(int position, std::initializer_list<T*> entries);
+
+   /**@post a_list's entries follow this list's entries and a_list is empty.
+      O(length of a_list): each entry records its new list */
+   void append(IntrusiveList<T>&& a_list);
+
+   /**
+    @param position indicating point of deletion
+    @post entry at position is unlinked, if any
+    @return true if there is an entry at position to be removed */
+   bool remove(int position);
+
+   /**
+    @param an_entry to be unlinked, found through its own links in O(1)
+    @return true if an_entry was in this list */
+   bool removeEntry(T* an_entry);
+
+   /**@post the list is empty and item_count_ == 0; the entries are free */
+   void clear();
+
+   /** Reordering operations, matching LinkedList. Only links change.
+       @return true if the positions are valid (see LinkedList) */
+   bool moveToFront(int position);
+   bool moveAfter(int position, int target_position);
+   bool swapEntries(int position_a, int position_b);
+
+   /**@return the former position of the first entry satisfying pred, moved
+      to the front, or -1 if there is none */
+   template<class Predicate>
+   int moveToFrontIf(Predicate pred);
+
+   /**@return the entry at position. If position is not a valid position
+      < item_count_ throws PrecondViolatedExcep */
+   T* getEntry(int position) const;
+
+   /** Same as above, but the cursor is moved to the entry. */
+   T* getEntry(int position);
+
+   iterator begin() const;
+   const_iterator cbegin() const;
+   iterator end() const;
+   const_iterator cend() const;
+
+protected:
+   typedef IntrusiveListHook<T> HookType;
+
+   HookType* head_ptr_;  // first entry's hook
+   HookType* tail_ptr_;  // last entry's hook
+   int item_count_;
+
+   // Cached hook last located by the non-const getHookAt() and its position,
+   // as in LinkedList; const lookups only read it.
+   HookType* cursor_ptr_;
+   int cursor_pos_;
+
+   // @pre 0 <= position < item_count_
+   // @return the hook at position, reached from the head, the tail or the
+   //         cursor, whichever is nearest
+   // @post the cursor refers to the returned hook
+   HookType* getHookAt(int position);
+
+   // Same as above, leaving the cursor where it is
+   HookType* getHookAt(int position) const;
+
+   // @pre hook_ptr is free; next_ptr is a hook of this list or nullptr for the end
+   // @post hook_ptr is linked right before next_ptr; the cursor is left to the caller
+   void linkBefore(HookType* next_ptr, HookType* hook_ptr);
+
+   // @pre hook_ptr is in this list
+   // @post hook_ptr is free; the cursor is left to the caller
+   void unlinkHook(HookType* hook_ptr);
+
+   void resetCursor();
+
+   static T* entryOf(HookType* hook_ptr);
+
+   friend class IntrusiveListHook<T>;
+}; // end IntrusiveList
+
+#include "IntrusiveList.cpp"
+#endif
@@ -1,11 +1,12 @@
 #include "KitchenStation.hpp"
+#include <algorithm>
 
 KitchenStation::KitchenStation() 
-    : station_name_("UNKNOWN"), dishes_({}), ingredients_stock_({}) {
+    : station_name_("UNKNOWN"), station_name_id_(SymbolTable::intern(station_name_)), dishes_({}), ingredients_stock_(), stock_layout_(1), atomic_stock_(false), busy_until_(0), stock_listener_(nullptr) {
 }
 
 KitchenStation::KitchenStation(const std::string& station_name) 
-    : station_name_(station_name), dishes_({}), ingredients_stock_({}) {
+    : station_name_(station_name), station_name_id_(SymbolTable::intern(station_name_)), dishes_({}), ingredients_stock_(), stock_layout_(1), atomic_stock_(false), busy_until_(0), stock_listener_(nullptr) {
 }
 
 KitchenStation::~KitchenStation() {
@@ -13,11 +14,15 @@ KitchenStation::~KitchenStation() {
         delete dish;
     }
 }
-std::string KitchenStation::getName() const {
+const std::string& KitchenStation::getName() const {
     return station_name_;
 }
+SymbolId KitchenStation::getNameId() const {
+    return station_name_id_;
+}
 void KitchenStation::setName(const std::string& station_name) {
     station_name_ = station_name;
+    station_name_id_ = SymbolTable::intern(station_name_);
 }
 
 // get dishes
@@ -28,130 +33,446 @@ std::vector<Dish*> KitchenStation::getDishes() const
 // get ingredients stock
 std::vector<Ingredient> KitchenStation::getIngredientsStock() const
 {
-    return ingredients_stock_;
+    std::vector<Ingredient> stock;
+    stock.reserve(ingredients_stock_.size());
+    // by position, so atomic stock is read straight from its counters; one
+    // at 0 keeps its position but is not listed, as it would be gone
+    // without atomic stock
+    ingredients_stock_.forEachIndexed([this, &stock](int stock_index, SymbolId, const Ingredient& ingredient) {
+        int quantity = quantityAt(stock_index);
+        if (atomic_stock_ && quantity == 0) {
+            return;
+        }
+        stock.push_back(ingredient);
+        stock.back().quantity = quantity;
+    });
+    return stock;
+}
+// get stock of one ingredient
+int KitchenStation::getStockQuantity(SymbolId ingredient_id) const
+{
+    int stock_index = ingredients_stock_.indexOf(ingredient_id);
+    return stock_index < 0 ? 0 : quantityAt(stock_index);
+}
+// get/set simulated backlog
+long KitchenStation::getBusyUntil() const
+{
+    return busy_until_;
+}
+void KitchenStation::setBusyUntil(long busy_until)
+{
+    busy_until_ = busy_until;
+}
+
+// set restock listener
+void KitchenStation::setStockListener(StockListener* listener)
+{
+    stock_listener_ = listener;
+}
+
+// collect the ingredients a dish is short of
+void KitchenStation::appendMissingIngredients(SymbolId dish_id, std::vector<SymbolId>& missing) const
+{
+    Dish* dish = findDish(dish_id);
+    if (dish == nullptr) {
+        return;
+    }
+    const std::vector<Ingredient>& ingredients = dish->getIngredients();
+    const std::vector<SymbolId>& ingredient_ids = dish->getIngredientIds();
+    for (size_t i = 0; i < ingredients.size(); i++) {
+        int stocked = getStockQuantity(ingredient_ids[i]);
+        if (stocked < ingredients[i].required_quantity || stocked < ingredients[i].quantity) {
+            missing.push_back(ingredient_ids[i]);
+        }
+    }
 }
 
 bool KitchenStation::assignDishToStation(Dish* dish) {
     if (dish == nullptr) {
         return false;
     }
-    if (isPresent(dish->getName())) {
+    if (isPresent(dish->getNameId())) {
         return false;
     }
     else {  
         dishes_.push_back(dish);
+        recipes_.push_back(CompiledRecipe());
+        rebindRecipe(static_cast<int>(dishes_.size()) - 1);
         return true;
     }
 }
 
-bool KitchenStation::isPresent(const std::string& dish_name) const {
-    for (Dish* dish : dishes_) {
-        if (dish->getName() == dish_name) {
-            return true;
+bool KitchenStation::isPresent(SymbolId dish_id) const {
+    return findDish(dish_id) != nullptr;
+}
+
+Dish* KitchenStation::findDish(SymbolId dish_id) const {
+    int dish_position = dishPosition(dish_id);
+    return dish_position < 0 ? nullptr : dishes_[dish_position];
+}
+
+int KitchenStation::dishPosition(SymbolId dish_id) const {
+    for (size_t i = 0; i < dishes_.size(); i++) {
+        if (dishes_[i]->getNameId() == dish_id) {
+            return static_cast<int>(i);
         }
     }
-    return false;
+    return -1;
+}
+
+bool KitchenStation::isBound(int dish_position) const {
+    const CompiledRecipe& recipe = recipes_[dish_position];
+    return recipe.stock_layout == stock_layout_
+        && recipe.ingredients_version == dishes_[dish_position]->getIngredientsVersion();
+}
+
+void KitchenStation::bindRecipe(int dish_position) {
+    const Dish* dish = dishes_[dish_position];
+    const std::vector<Ingredient>& ingredients = dish->getIngredients();
+    const std::vector<SymbolId>& ingredient_ids = dish->getIngredientIds();
+    CompiledRecipe& recipe = recipes_[dish_position];
+    recipe.stock_layout = stock_layout_;
+    recipe.ingredients_version = dish->getIngredientsVersion();
+    recipe.stocked = true;
+    recipe.steps.clear();
+    for (size_t i = 0; i < ingredients.size(); i++) {
+        int stock_index = ingredients_stock_.indexOf(ingredient_ids[i]);
+        recipe.stocked = recipe.stocked && stock_index >= 0;
+        recipe.steps.push_back(RecipeStep{stock_index, ingredients[i].required_quantity, ingredients[i].quantity});
+    }
+}
+
+// Under atomic stock a dish may bring ingredients that have no counter yet,
+// so the counters are rebuilt, which lists those at 0 and binds every recipe
+void KitchenStation::rebindRecipe(int dish_position) {
+    if (atomic_stock_) {
+        storeAtomicStock();
+        loadAtomicStock();
+    } else {
+        bindRecipe(dish_position);
+    }
+}
+
+const Ingredient* KitchenStation::findStock(SymbolId ingredient_id) const {
+    return ingredients_stock_.find(ingredient_id);
 }
 
 void KitchenStation::replenishStationIngredients(const Ingredient& ingredient) {
+    SymbolId ingredient_id = SymbolTable::intern(ingredient.name);
+    addStock(ingredient_id, ingredient);
+    if (stock_listener_ != nullptr) {
+        stock_listener_->stockAdded(*this, ingredient_id);
+    }
+}
+
+void KitchenStation::addStock(SymbolId ingredient_id, const Ingredient& ingredient) {
     //check if ingredient is already in stock
-    for (Ingredient& stock_ingredient : ingredients_stock_) {
-        if (stock_ingredient.name == ingredient.name) {
-            // std::cout<< "Found ingredient "<< stock_ingredient.name << std::endl;
-            // std::cout<< "We have "<< stock_ingredient.quantity << " of "<< stock_ingredient.name << std::endl;
-            // std::cout<< "We are adding "<< ingredient.quantity << " of "<< ingredient.name << std::endl;
-            stock_ingredient.quantity += ingredient.quantity;
-            // std::cout<< "We now have "<< stock_ingredient.quantity << " of "<< stock_ingredient.name << std::endl;
-            return;
+    int stock_index = atomic_stock_ ? ingredients_stock_.indexOf(ingredient_id) : -1;
+    if (stock_index >= 0) {
+        atomic_quantities_[stock_index].fetch_add(ingredient.quantity, std::memory_order_relaxed);
+    } else if (atomic_stock_) {
+        // a new ingredient may move the others, so the counters are rebuilt
+        storeAtomicStock();
+        ingredients_stock_.insert(ingredient_id, ingredient);
+        stock_layout_++;
+        loadAtomicStock();
+    } else {
+        std::pair<Ingredient*, bool> stocked = ingredients_stock_.insert(ingredient_id, ingredient);
+        if (!stocked.second) {
+            stocked.first->quantity += ingredient.quantity;
+        } else {
+            stock_layout_++;
         }
     }
-    ingredients_stock_.push_back(ingredient);
 }
 
+// The string versions look the dish's name up once and compare ids from there
 bool KitchenStation::canCompleteOrder(const std::string& dish_name) const {
-    for (Dish* dish : dishes_) {
-        // std::cout<< "Dish name: "<< dish->getName()<<std::endl;
-        if (dish->getName() == dish_name) {
-            // std::cout << "Checking if we can complete order for " << dish_name << std::endl;
-            for (Ingredient ingredient : dish->getIngredients()) {
-                // std::cout << "Checking for ingredient " << ingredient.name << std::endl;
-                bool found = false;
-                for (Ingredient stock_ingredient : ingredients_stock_) {
-                    if (stock_ingredient.name == ingredient.name) {
-                        // std::cout<< "Found ingredient "<< stock_ingredient.name << " and we have "<< stock_ingredient.quantity << std::endl;
-                        if (stock_ingredient.quantity >= ingredient.required_quantity) {
-                            // std::cout<<"YAY We need "<< ingredient.required_quantity << " of "<< ingredient.name << " and we have "<< stock_ingredient.quantity << std::endl;
-                            // std::cout << "Found enough quantity of " << stock_ingredient.name << std::endl;
-                            found = true;
-                        }
-                        else {
-                            // std::cout << "Did not find enough quantity of " << stock_ingredient.name << std::endl;
-                            // std::cout<<"NO We need "<< ingredient.required_quantity << " of "<< ingredient.name << " and we have "<< stock_ingredient.quantity << std::endl;
-                            return false;
-                        }
-                    }
-                }
-                if (!found) {
-                    // std::cout<< "Did not find " << ingredient.name << std::endl;
-                    return false;
-                }
+    SymbolId dish_id = SymbolTable::find(dish_name);
+    return dish_id != SymbolTable::NO_SYMBOL && canCompleteOrder(dish_id);
+}
+
+bool KitchenStation::prepareDish(const std::string& dish_name) {
+    SymbolId dish_id = SymbolTable::find(dish_name);
+    return dish_id != SymbolTable::NO_SYMBOL && prepareDish(dish_id);
+}
+
+// A bound recipe is checked by indexing into stock; an unbound one (stock
+// or the dish changed since) falls back to looking each ingredient up, as
+// this may not rebind it
+bool KitchenStation::canCompleteOrder(SymbolId dish_id) const {
+    int dish_position = dishPosition(dish_id);
+    if (dish_position < 0) {
+        return false;
+    }
+    if (isBound(dish_position)) {
+        const CompiledRecipe& recipe = recipes_[dish_position];
+        if (!recipe.stocked) {
+            return false;
+        }
+        for (const RecipeStep& step : recipe.steps) {
+            if (quantityAt(step.stock_index) < step.required_quantity) {
+                return false;
             }
-            return true;
+        }
+        return true;
+    }
+    const std::vector<Ingredient>& ingredients = dishes_[dish_position]->getIngredients();
+    const std::vector<SymbolId>& ingredient_ids = dishes_[dish_position]->getIngredientIds();
+    for (size_t i = 0; i < ingredients.size(); i++) {
+        // every ingredient must be in stock with at least the required quantity
+        int stock_index = ingredients_stock_.indexOf(ingredient_ids[i]);
+        if (stock_index < 0 || quantityAt(stock_index) < ingredients[i].required_quantity) {
+            return false;
         }
     }
-    return false;
+    return true;
 }
 
-bool KitchenStation::prepareDish(const std::string& dish_name) {
-    if (!canCompleteOrder(dish_name)) {
-        return false;
+bool KitchenStation::prepareDish(SymbolId dish_id) {
+    return tryConsume(dish_id).status == PREPARED;
+}
+
+// Each ingredient must have at least its required quantity and the dish's
+// listed quantity in stock; required_quantity is what gets deducted. An
+// ingredient listed twice must cover both uses.
+KitchenStation::ConsumeResult KitchenStation::tryConsume(SymbolId dish_id) {
+    int dish_position = dishPosition(dish_id);
+    if (dish_position < 0) {
+        return ConsumeResult{NOT_ASSIGNED, SymbolTable::NO_SYMBOL};
     }
-    else{
-        //std::cout<< "Preparing dish: "<< dish_name << std::endl;
+    if (!isBound(dish_position)) {
+        rebindRecipe(dish_position);
     }
-    for (Dish* dish : dishes_) {
-        if (dish->getName() == dish_name) {
-            // Check if we have all the ingredients and the right quantity before doing anything else
-            for (Ingredient ingredient : dish->getIngredients()) {
-                bool found = false;
-                for (Ingredient& stock_ingredient : ingredients_stock_) {
-                    if (stock_ingredient.name == ingredient.name) {
-                        // Check if we have enough stock
-                        if (stock_ingredient.quantity >= ingredient.quantity) {
-                            found = true;
-                            break; // breaks out of the inner loop, so we check the next ingredient
-                        }
-                    }
-                }
-                if (!found) { // one of the ingredients is missing or not enough
-                    return false;
-                }
-                // If we reach this point, we have all the ingredients in stock. Hooray!
+    if (atomic_stock_) {
+        return tryConsumeAtomic(dish_position, {}, {});
+    }
+    const CompiledRecipe& recipe = recipes_[dish_position];
+    const std::vector<SymbolId>& ingredient_ids = dishes_[dish_position]->getIngredientIds();
+    bool any_used_up = false;
+    for (size_t i = 0; i < recipe.steps.size(); i++) {
+        const RecipeStep& step = recipe.steps[i];
+        if (step.stock_index < 0) {
+            restoreStock(recipe, i);
+            return ConsumeResult{MISSING_INGREDIENT, ingredient_ids[i]};
+        }
+        Ingredient& stocked = ingredients_stock_.valueAt(step.stock_index);
+        if (stocked.quantity < step.required_quantity || stocked.quantity < step.quantity) {
+            restoreStock(recipe, i);
+            return ConsumeResult{INSUFFICIENT_INGREDIENT, ingredient_ids[i]};
+        }
+        stocked.quantity -= step.required_quantity;
+        any_used_up = any_used_up || stocked.quantity == 0;
+    }
+    if (any_used_up) {
+        // if we have 0 quantity of an ingredient, we should remove it from
+        // stock; only now, since removing one may move the others
+        for (SymbolId ingredient_id : ingredient_ids) {
+            const Ingredient* stocked = findStock(ingredient_id);
+            if (stocked != nullptr && stocked->quantity == 0) {
+                ingredients_stock_.erase(ingredient_id);
             }
-            // Deduct the ingredients from stock
-            for (Ingredient ingredient : dish->getIngredients()) {
-                for (Ingredient& stock_ingredient : ingredients_stock_) {
-                    if (stock_ingredient.name == ingredient.name) {
-                        stock_ingredient.quantity -= ingredient.required_quantity;
-                        // if we have 0 quantity of an ingredient, we should remove it from stock
-                        if (stock_ingredient.quantity == 0) {
-                            removeIngredient(stock_ingredient.name);
-                        }
-                    }
-                }
+        }
+        stock_layout_++;
+    }
+    return ConsumeResult{PREPARED, SymbolTable::NO_SYMBOL};
+}
+
+// Under atomic stock the top-up only counts toward the dish's reservation
+// and is stocked once the dish goes through, so no rival can take it first.
+// Otherwise it is stocked up front and taken back out if the dish fails.
+// Either way the stock listener is not told: the top-up is not a restock.
+KitchenStation::ConsumeResult KitchenStation::tryConsume(SymbolId dish_id, const std::vector<Ingredient>& top_up,
+                                                         const std::vector<SymbolId>& top_up_ids) {
+    if (atomic_stock_) {
+        int dish_position = dishPosition(dish_id);
+        if (dish_position < 0) {
+            return ConsumeResult{NOT_ASSIGNED, SymbolTable::NO_SYMBOL};
+        }
+        if (!isBound(dish_position)) {
+            rebindRecipe(dish_position);
+        }
+        return tryConsumeAtomic(dish_position, top_up, top_up_ids);
+    }
+    for (size_t i = 0; i < top_up.size(); i++) {
+        addStock(top_up_ids[i], top_up[i]);
+    }
+    ConsumeResult result = tryConsume(dish_id);
+    if (result.status != PREPARED) {
+        for (size_t i = 0; i < top_up.size(); i++) {
+            withdrawStock(top_up_ids[i], top_up[i].quantity);
+        }
+    }
+    return result;
+}
+
+// Stock taken down to 0 is removed, as when a dish uses it up
+void KitchenStation::withdrawStock(SymbolId ingredient_id, int quantity) {
+    int stock_index = ingredients_stock_.indexOf(ingredient_id);
+    if (stock_index < 0) {
+        return;
+    }
+    Ingredient& stocked = ingredients_stock_.valueAt(stock_index);
+    stocked.quantity -= quantity;
+    if (stocked.quantity == 0) {
+        ingredients_stock_.erase(ingredient_id);
+        stock_layout_++;
+    }
+}
+
+void KitchenStation::restoreStock(const CompiledRecipe& recipe, size_t step_count) {
+    for (size_t i = 0; i < step_count; i++) {
+        ingredients_stock_.valueAt(recipe.steps[i].stock_index).quantity += recipe.steps[i].required_quantity;
+    }
+}
+
+// returns where ingredient_id first appears in ids, or -1
+static int firstPosition(const std::vector<SymbolId>& ids, SymbolId ingredient_id) {
+    for (size_t i = 0; i < ids.size(); i++) {
+        if (ids[i] == ingredient_id) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Reserves each ingredient with a compare-and-swap that only goes through
+// while enough is left, and gives the reservations back on a shortfall. The
+// counters publish nothing else, so relaxed order is enough. A top-up counts
+// as extra stock of its ingredient that each step draws on before the
+// counter; what is left of it goes into the counter once the dish is
+// through. Every ingredient of the station's dishes has a counter (see
+// loadAtomicStock), so the top-up from a backup reservation always finds
+// one; any other ingredient cannot be topped up here, as stocking it would
+// move the counters.
+KitchenStation::ConsumeResult KitchenStation::tryConsumeAtomic(int dish_position, const std::vector<Ingredient>& top_up,
+                                                               const std::vector<SymbolId>& top_up_ids) {
+    const CompiledRecipe& recipe = recipes_[dish_position];
+    const std::vector<SymbolId>& ingredient_ids = dishes_[dish_position]->getIngredientIds();
+    // what is left of each ingredient's top-up, under its first entry, and
+    // what each step took from its counter (kept only with a top-up)
+    std::vector<int> top_up_left(top_up.size(), 0);
+    std::vector<int> drawn;
+    for (size_t j = 0; j < top_up.size(); j++) {
+        if (ingredients_stock_.indexOf(top_up_ids[j]) < 0) {
+            return ConsumeResult{MISSING_INGREDIENT, top_up_ids[j]};
+        }
+        top_up_left[firstPosition(top_up_ids, top_up_ids[j])] += top_up[j].quantity;
+    }
+    for (size_t i = 0; i < recipe.steps.size(); i++) {
+        const RecipeStep& step = recipe.steps[i];
+        if (step.stock_index < 0) {
+            restoreAtomicStock(recipe, i, drawn);
+            return ConsumeResult{MISSING_INGREDIENT, ingredient_ids[i]};
+        }
+        int extra_at = top_up.empty() ? -1 : firstPosition(top_up_ids, ingredient_ids[i]);
+        int extra = extra_at < 0 ? 0 : top_up_left[extra_at];
+        int from_counter = std::max(step.required_quantity - extra, 0);
+        std::atomic<int>& stocked = atomic_quantities_[step.stock_index];
+        int quantity = stocked.load(std::memory_order_relaxed);
+        do {
+            if (quantity + extra < step.required_quantity || quantity + extra < step.quantity) {
+                restoreAtomicStock(recipe, i, drawn);
+                return ConsumeResult{INSUFFICIENT_INGREDIENT, ingredient_ids[i]};
+            }
+        } while (!stocked.compare_exchange_weak(quantity, quantity - from_counter, std::memory_order_relaxed));
+        if (!top_up.empty()) {
+            if (extra_at >= 0) {
+                top_up_left[extra_at] -= step.required_quantity - from_counter;
             }
-            return true;
+            drawn.push_back(from_counter);
+        }
+    }
+    for (size_t j = 0; j < top_up.size(); j++) {
+        if (top_up_left[j] > 0) {
+            atomic_quantities_[ingredients_stock_.indexOf(top_up_ids[j])].fetch_add(top_up_left[j],
+                                                                                   std::memory_order_relaxed);
         }
     }
-    return false; 
+    return ConsumeResult{PREPARED, SymbolTable::NO_SYMBOL};
+}
+
+// drawn lists what each step took from its counter, or is empty if each
+// took its required quantity
+void KitchenStation::restoreAtomicStock(const CompiledRecipe& recipe, size_t step_count, const std::vector<int>& drawn) {
+    for (size_t i = 0; i < step_count; i++) {
+        int taken = drawn.empty() ? recipe.steps[i].required_quantity : drawn[i];
+        atomic_quantities_[recipe.steps[i].stock_index].fetch_add(taken, std::memory_order_relaxed);
+    }
 }
 
-bool KitchenStation::removeIngredient(const std::string& ingredient_name) {
-    for (size_t i = 0; i < ingredients_stock_.size(); i++) {
-        if (ingredients_stock_[i].name == ingredient_name) {
-            ingredients_stock_.erase(ingredients_stock_.begin() + i);
-            return true;
+// switch atomic stock on or off
+void KitchenStation::setAtomicStock(bool enabled) {
+    if (enabled == atomic_stock_) {
+        return;
+    }
+    if (enabled) {
+        atomic_stock_ = true;
+        loadAtomicStock();
+        return;
+    }
+    storeAtomicStock();
+    atomic_stock_ = false;
+    atomic_quantities_.clear();
+    // what ran out meanwhile is removed from stock now
+    std::vector<SymbolId> used_up;
+    ingredients_stock_.forEach([&used_up](SymbolId ingredient_id, const Ingredient& ingredient) {
+        if (ingredient.quantity == 0) {
+            used_up.push_back(ingredient_id);
         }
+    });
+    for (SymbolId ingredient_id : used_up) {
+        ingredients_stock_.erase(ingredient_id);
     }
-    return false;
-}
\ No newline at end of file
+    if (!used_up.empty()) {
+        stock_layout_++;
+    }
+}
+
+bool KitchenStation::hasAtomicStock() const {
+    return atomic_stock_;
+}
+
+int KitchenStation::quantityAt(int stock_index) const {
+    if (atomic_stock_) {
+        return atomic_quantities_[stock_index].load(std::memory_order_relaxed);
+    }
+    return ingredients_stock_.valueAt(stock_index).quantity;
+}
+
+// Positions of removed entries get a counter too; nothing reads it.
+// Every ingredient the dishes use is listed first, at 0 if it is not in
+// stock, so a top-up or restock of it needs no new counter while other
+// threads use the station. Every recipe is bound here, so tryConsume never
+// has to rebind meanwhile either.
+void KitchenStation::loadAtomicStock() {
+    bool listed = false;
+    for (const Dish* dish : dishes_) {
+        const std::vector<Ingredient>& ingredients = dish->getIngredients();
+        const std::vector<SymbolId>& ingredient_ids = dish->getIngredientIds();
+        for (size_t i = 0; i < ingredients.size(); i++) {
+            Ingredient none = ingredients[i];
+            none.quantity = 0;
+            listed = ingredients_stock_.insert(ingredient_ids[i], none).second || listed;
+        }
+    }
+    if (listed) {
+        stock_layout_++;
+    }
+    atomic_quantities_ = std::vector<std::atomic<int>>(ingredients_stock_.indexLimit());
+    for (size_t i = 0; i < atomic_quantities_.size(); i++) {
+        atomic_quantities_[i].store(ingredients_stock_.valueAt(static_cast<int>(i)).quantity,
+                                    std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < dishes_.size(); i++) {
+        if (!isBound(static_cast<int>(i))) {
+            bindRecipe(static_cast<int>(i));
+        }
+    }
+}
+
+void KitchenStation::storeAtomicStock() {
+    for (size_t i = 0; i < atomic_quantities_.size(); i++) {
+        ingredients_stock_.valueAt(static_cast<int>(i)).quantity = atomic_quantities_[i].load(std::memory_order_relaxed);
+    }
+}
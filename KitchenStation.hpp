@@ -6,17 +6,92 @@
 #include <string>
 #include <iomanip>
 #include <cctype>
+#include <atomic>
 #include "Dish.hpp"
+#include "FlatHashMap.hpp"
+#include "IntrusiveList.hpp"
 
-class KitchenStation {
+class KitchenStation;
+
+// Told whenever stock is added to a station it listens to, on the thread
+// that added it. Under atomic stock several threads may restock at once, so
+// stockAdded must be safe to call concurrently.
+class StockListener {
+    public:
+        virtual ~StockListener() = default;
+        virtual void stockAdded(KitchenStation& station, SymbolId ingredient_id) = 0;
+};
+
+// The hook lets a station be threaded directly into an IntrusiveList roster.
+class KitchenStation : public IntrusiveListHook<KitchenStation> {
+
+    public:
+        // how an attempt to prepare a dish from stock went
+        enum ConsumeStatus {PREPARED, NOT_ASSIGNED, MISSING_INGREDIENT, INSUFFICIENT_INGREDIENT};
+        struct ConsumeResult {
+            ConsumeStatus status;
+            SymbolId ingredient_id;  // the ingredient at fault, or NO_SYMBOL
+        };
 
     private:
         std::string station_name_;
+        SymbolId station_name_id_;
         std::vector<Dish*> dishes_;
-        std::vector<Ingredient> ingredients_stock_;
+        // A dish's ingredients bound to where they sit in stock, so checks
+        // index straight into it. Only valid while stock_layout_ and the
+        // dish's ingredients version still match what it was bound under.
+        struct RecipeStep {
+            int stock_index;        // position in ingredients_stock_, or -1
+            int required_quantity;
+            int quantity;
+        };
+        struct CompiledRecipe {
+            unsigned long stock_layout;
+            unsigned long ingredients_version;
+            bool stocked;  // every ingredient had a stock entry
+            std::vector<RecipeStep> steps;
+        };
+        std::vector<CompiledRecipe> recipes_;  // parallel to dishes_
+        // stock by interned ingredient name, kept in the order it was added
+        FlatHashMap<SymbolId, Ingredient> ingredients_stock_;
+        // bumped whenever an ingredient is added to or removed from stock,
+        // which may move entries and so unbinds every compiled recipe
+        unsigned long stock_layout_;
+        // While atomic stock is on, the quantities live here, by stock
+        // position, and the quantities in ingredients_stock_ are stale
+        bool atomic_stock_;
+        std::vector<std::atomic<int>> atomic_quantities_;
+        long busy_until_;  // simulated minute at which the station's backlog is done
+        StockListener* stock_listener_;  // told about restocks, or nullptr
 
-        bool isPresent(const std::string& dish_name) const;
-        bool removeIngredient(const std::string& ingredient_name);
+        bool isPresent(SymbolId dish_id) const;
+        // returns the dish assigned under dish_id, or nullptr
+        Dish* findDish(SymbolId dish_id) const;
+        // returns the position of that dish in dishes_, or -1
+        int dishPosition(SymbolId dish_id) const;
+        bool isBound(int dish_position) const;
+        // binds the recipe of the dish at dish_position to current stock
+        void bindRecipe(int dish_position);
+        // @post the deductions of the recipe's first step_count steps are undone
+        void restoreStock(const CompiledRecipe& recipe, size_t step_count);
+        void restoreAtomicStock(const CompiledRecipe& recipe, size_t step_count, const std::vector<int>& drawn);
+        // @post ingredient's quantity is added to its stock; unlike
+        // replenishStationIngredients, the stock listener is not told
+        void addStock(SymbolId ingredient_id, const Ingredient& ingredient);
+        // @post quantity is taken back out of the ingredient's stock; not
+        // for atomic stock
+        void withdrawStock(SymbolId ingredient_id, int quantity);
+        // returns the stocked ingredient, or nullptr
+        const Ingredient* findStock(SymbolId ingredient_id) const;
+        // returns the quantity of the ingredient at a stock position
+        int quantityAt(int stock_index) const;
+        // binds a recipe after its dish or the stock changed
+        void rebindRecipe(int dish_position);
+        // copy quantities between ingredients_stock_ and atomic_quantities_
+        void loadAtomicStock();
+        void storeAtomicStock();
+        ConsumeResult tryConsumeAtomic(int dish_position, const std::vector<Ingredient>& top_up,
+                                       const std::vector<SymbolId>& top_up_ids);
 
     public:
         KitchenStation();
@@ -24,19 +99,64 @@ class KitchenStation {
         ~KitchenStation();
 
         // get name of station
-        std::string getName() const;
+        const std::string& getName() const;
+        // get interned id of the station's name
+        SymbolId getNameId() const;
         // set name of station
         void setName(const std::string& station_name);
         // get dishes
         std::vector<Dish*> getDishes() const;
-        // get ingredients stock
+        // get ingredients stock, in the order it was added
         std::vector<Ingredient> getIngredientsStock() const;
+        // get quantity in stock of an ingredient, 0 if not stocked
+        int getStockQuantity(SymbolId ingredient_id) const;
+        // get/set the simulated minute at which the station is free again
+        long getBusyUntil() const;
+        void setBusyUntil(long busy_until);
+        // set who is told when stock is added, or nullptr; the listener
+        // must outlive its use
+        void setStockListener(StockListener* listener);
+        // append the dish's ingredients that are short in stock, that is,
+        // below what either canCompleteOrder or prepareDish checks for
+        void appendMissingIngredients(SymbolId dish_id, std::vector<SymbolId>& missing) const;
 
         bool assignDishToStation(Dish* dish);
         void replenishStationIngredients(const Ingredient& ingredient);
         bool canCompleteOrder(const std::string& dish_name) const;
         bool prepareDish(const std::string& dish_name);
 
+        // same as above, for a dish named by its interned id
+        bool canCompleteOrder(SymbolId dish_id) const;
+        bool prepareDish(SymbolId dish_id);
+        // checks and deducts the dish's ingredients in one pass, putting
+        // back what was taken if one falls short; says why it failed
+        ConsumeResult tryConsume(SymbolId dish_id);
+        // same, with top_up (whose interned names are top_up_ids) added to
+        // stock for the dish: if the dish fails, stock is as it was. Under
+        // atomic stock no other thread sees the top-up before the dish is
+        // through, and only ingredients of the station's dishes can be
+        // topped up (others give MISSING_INGREDIENT). The stock listener is
+        // not told of it
+        ConsumeResult tryConsume(SymbolId dish_id, const std::vector<Ingredient>& top_up,
+                                 const std::vector<SymbolId>& top_up_ids);
+
+        // Atomic stock lets several threads call tryConsume, prepareDish,
+        // canCompleteOrder, getStockQuantity and restock ingredients already
+        // listed on this station at once. Each ingredient's quantity is an
+        // atomic counter; a dish reserves its ingredients one by one with
+        // compare-and-swap and gives the reservations back if one falls
+        // short, so no dish is left partly deducted (a rival may see a
+        // reservation that is then given back, and fail). Every ingredient
+        // the dishes use is listed, at 0 if there is none, and stock that
+        // runs out stays listed at 0, until atomic stock is switched off;
+        // getIngredientsStock leaves the entries at 0 out, as they would be
+        // without atomic stock. Each restock tells the stock listener on its
+        // own thread. Adding an ingredient no dish uses and not yet in
+        // stock, assigning or changing dishes, setting the listener and
+        // switching the mode must not overlap with any other call.
+        void setAtomicStock(bool enabled);
+        bool hasAtomicStock() const;
+
 };
 
 #endif // KITCHENSTATION_HPP
\ No newline at end of file
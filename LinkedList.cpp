@@ -13,74 +13,129 @@
 
 #include "LinkedList.hpp"  // Header file
 #include <cassert>
+#include <new>
 
 // constructor
-template<class T>
-LinkedList<T>::LinkedList() : head_ptr_(nullptr), item_count_(0)
+template<class T, class Allocator>
+LinkedList<T, Allocator>::LinkedList() : head_ptr_(nullptr), tail_ptr_(nullptr), item_count_(0),
+                                         cursor_ptr_(nullptr), cursor_pos_(0)
 {
 }  // end default constructor
 
 
 // copy constructor
-template<class T>
-LinkedList<T>::LinkedList(const LinkedList<T>& a_list) : item_count_(a_list.item_count_)
+// If copying an item throws, the nodes created so far are released before the
+// exception propagates, so a failed copy leaks nothing.
+template<class T, class Allocator>
+LinkedList<T, Allocator>::LinkedList(const LinkedList<T, Allocator>& a_list) : head_ptr_(nullptr), tail_ptr_(nullptr), item_count_(0),
+                                         cursor_ptr_(nullptr), cursor_pos_(0)
 {
    Node<T>* orig_chain_pointer = a_list.head_ptr_;  // Points to nodes in original chain
+   Node<T>* new_chain_ptr = nullptr;                 // Points to last node in new chain
 
-   if (orig_chain_pointer == nullptr)
-      head_ptr_ = nullptr;  // Original list is empty
-   else
+   try
    {
-      // Copy first node
-      head_ptr_ = new Node<T>();
-      head_ptr_->setItem(orig_chain_pointer->getItem());
-
-      // Copy remaining nodes
-      Node<T>* new_chain_ptr = head_ptr_;      // Points to last node in new chain
-      orig_chain_pointer = orig_chain_pointer->getNext();     // Advance original-chain pointer
       while (orig_chain_pointer != nullptr)
       {
-         // Get next item from original chain
-         T next_item = orig_chain_pointer->getItem();
-
-         // Create a new node containing the next item
-         Node<T>* new_node_ptr = new Node<T>(next_item);
+         // Create a new node holding a copy of the next item from the original chain
+         Node<T>* new_node_ptr = createNode(nullptr, orig_chain_pointer->getItem());
 
          // Link new node to end of new chain
-         new_chain_ptr->setNext(new_node_ptr);
+         if (new_chain_ptr == nullptr)
+            head_ptr_ = new_node_ptr;
+         else
+            new_chain_ptr->setNext(new_node_ptr);
 
          // Advance pointer to new last node
-         new_chain_ptr = new_chain_ptr->getNext();
+         new_chain_ptr = new_node_ptr;
 
          // Advance original-chain pointer
          orig_chain_pointer = orig_chain_pointer->getNext();
       }  // end while
+   }
+   catch (...)
+   {
+      destroyChain(head_ptr_);
+      throw;
+   }  // end try
 
-      new_chain_ptr->setNext(nullptr);              // Flag end of chain
-   }  // end if
+   tail_ptr_ = new_chain_ptr;
+   item_count_ = a_list.item_count_;
 }  // end copy constructor
 
 
+// move constructor
+template<class T, class Allocator>
+LinkedList<T, Allocator>::LinkedList(LinkedList<T, Allocator>&& a_list) noexcept :
+                                         head_ptr_(a_list.head_ptr_), tail_ptr_(a_list.tail_ptr_),
+                                         item_count_(a_list.item_count_),
+                                         cursor_ptr_(a_list.cursor_ptr_), cursor_pos_(a_list.cursor_pos_)
+{
+   a_list.head_ptr_ = nullptr;
+   a_list.tail_ptr_ = nullptr;
+   a_list.item_count_ = 0;
+   a_list.resetCursor();
+}  // end move constructor
+
+
 // destructor
-template<class T>
-LinkedList<T>::~LinkedList()
+template<class T, class Allocator>
+LinkedList<T, Allocator>::~LinkedList()
 {
    clear();
 }  // end destructor
 
 
+// copy assignment: copy first, then swap, so a throwing copy leaves this list unchanged
+template<class T, class Allocator>
+LinkedList<T, Allocator>& LinkedList<T, Allocator>::operator=(const LinkedList<T, Allocator>& a_list)
+{
+   if (this != &a_list)
+   {
+      LinkedList<T, Allocator> copy(a_list);
+      swap(copy);
+   }  // end if
+   return *this;
+}  // end operator=
+
+
+// move assignment
+template<class T, class Allocator>
+LinkedList<T, Allocator>& LinkedList<T, Allocator>::operator=(LinkedList<T, Allocator>&& a_list) noexcept
+{
+   if (this != &a_list)
+   {
+      clear();
+      swap(a_list);
+   }  // end if
+   return *this;
+}  // end operator=
+
+
+/**@post the chains of this list and a_list are exchanged */
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::swap(LinkedList<T, Allocator>& a_list) noexcept
+{
+   std::swap(head_ptr_, a_list.head_ptr_);
+   std::swap(tail_ptr_, a_list.tail_ptr_);
+   std::swap(item_count_, a_list.item_count_);
+   std::swap(cursor_ptr_, a_list.cursor_ptr_);
+   std::swap(cursor_pos_, a_list.cursor_pos_);
+}  // end swap
+
+
 
 /**@return true if list is empty - item_count_ == 0 */
-template<class T>
-bool LinkedList<T>::isEmpty() const
+template<class T, class Allocator>
+bool LinkedList<T, Allocator>::isEmpty() const
 {
    return item_count_ == 0;
 }  // end isEmpty
 
 
 /**@return the number of items in the list - item_count_ */
-template<class T>
-int LinkedList<T>::getLength() const
+template<class T, class Allocator>
+int LinkedList<T, Allocator>::getLength() const
 {
    return item_count_;
 }  // end getLength
@@ -93,45 +148,117 @@ int LinkedList<T>::getLength() const
  @param new_entry to be inserted in list
  @post new_entry is added at position in list (the node previously at that position is now at position+1)
  @return true if valid position (0 <= position <= item_count_) */
-template<class T>
-bool LinkedList<T>::insert(int positions, const T& new_entry)
+template<class T, class Allocator>
+bool LinkedList<T, Allocator>::insert(int positions, const T& new_entry)
 {
    bool able_to_insert = (positions >= 0) && (positions <= item_count_ );
    if (able_to_insert)
    {
-      // Create a new node containing the new entry
-      Node<T>* new_node_ptr = new Node<T>(new_entry);
+      // Create a new node containing the new entry and attach it to the chain
+      linkNodeAt(positions, createNode(nullptr, new_entry));
+   }  // end if
 
-      // Attach new node to chain
-      if (positions == 0)
-      {
-         // Insert new node at beginning of chain
-         new_node_ptr->setNext(head_ptr_);
-         head_ptr_ = new_node_ptr;
-      }
-      else
-      {
-         // Find node that will be before new node
-         Node<T>* prev_ptr = getNodeAt(positions - 1);
-         // Insert new node after node to which prev_ptr points
-         new_node_ptr->setNext(prev_ptr->getNext());
-         prev_ptr->setNext(new_node_ptr);
-      }  // end if
-      item_count_++;  // Increase count of entries
+   return able_to_insert;
+}  // end insert
+
+
+/** Same as insert(position, const T&), but new_entry is moved into the list. */
+template<class T, class Allocator>
+bool LinkedList<T, Allocator>::insert(int position, T&& new_entry)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_ );
+   if (able_to_insert)
+      linkNodeAt(position, createNode(nullptr, std::move(new_entry)));
+
+   return able_to_insert;
+}  // end insert
+
+
+/**
+ @param position indicating point of insertion
+ @param args arguments forwarded to T's constructor; the entry is built in its node
+ @post the new entry is at position in list
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T, class Allocator>
+template<class... Args>
+bool LinkedList<T, Allocator>::emplace(int position, Args&&... args)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_ );
+   if (able_to_insert)
+      linkNodeAt(position, createNode(nullptr, std::forward<Args>(args)...));
+
+   return able_to_insert;
+}  // end emplace
+
+
+/**
+ @param new_entry to be added after the last entry
+ @post new_entry is at position item_count_ - 1 */
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::pushBack(const T& new_entry)
+{
+   linkNodeAt(item_count_, createNode(nullptr, new_entry));
+}  // end pushBack
+
+
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::pushBack(T&& new_entry)
+{
+   linkNodeAt(item_count_, createNode(nullptr, std::move(new_entry)));
+}  // end pushBack
+
+
+/**
+ @param position indicating point of insertion
+ @param first, last the range of entries to insert, in order
+ @post the entries are at position .. position + (last - first) - 1
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T, class Allocator>
+template<class InputIterator, class>
+bool LinkedList<T, Allocator>::insert(int position, InputIterator first, InputIterator last)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_ );
+   if (able_to_insert)
+   {
+      // Build the new entries on a chain of their own first, so a throwing
+      // copy is cleaned up by chunk's destructor and this list is untouched
+      LinkedList<T, Allocator> chunk;
+      for (; first != last; ++first)
+         chunk.pushBack(*first);
+      spliceListAt(position, chunk);
    }  // end if
 
    return able_to_insert;
 }  // end insert
 
 
+/** Same as the range insert, with the entries given as a braced list. */
+template<class T, class Allocator>
+bool LinkedList<T, Allocator>::insert(int position, std::initializer_list<T> entries)
+{
+   return insert(position, entries.begin(), entries.end());
+}  // end insert
+
+
+/**
+ @param a_list list whose entries are moved to the end of this one
+ @post a_list's chain follows this list's last node and a_list is empty */
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::append(LinkedList<T, Allocator>&& a_list)
+{
+   if (this != &a_list)
+      spliceListAt(item_count_, a_list);
+}  // end append
+
+
 
 /**
  @pre list positions follow traditional indexing from 0 to item_count_ -1
  @param position indicating point of deletion
  @post node at position is deleted, if any. List order is retains
  @return true if there is a node at position to be deleted, false otherwise */
-template<class T>
-bool LinkedList<T>::remove(int position)
+template<class T, class Allocator>
+bool LinkedList<T, Allocator>::remove(int position)
 {
    bool able_to_remove = (position >= 0) && (position < item_count_);
    if (able_to_remove)
@@ -142,6 +269,8 @@ bool LinkedList<T>::remove(int position)
          // Remove the first node in the chain
          cur_ptr = head_ptr_; // Save pointer to node
          head_ptr_ = head_ptr_->getNext();
+         if (tail_ptr_ == cur_ptr)
+            tail_ptr_ = nullptr;
       }
       else
       {
@@ -154,11 +283,19 @@ bool LinkedList<T>::remove(int position)
          // Disconnect indicated node from chain by connecting the
          // prior node with the one after
          prev_ptr->setNext(cur_ptr->getNext());
+         if (tail_ptr_ == cur_ptr)
+            tail_ptr_ = prev_ptr;
       }  // end if
 
-      // Return node to system
+      // Keep the cursor valid: forget it if its node goes away
+      if (cursor_ptr_ == cur_ptr)
+         resetCursor();
+      else if (cursor_ptr_ != nullptr && position < cursor_pos_)
+         cursor_pos_--;
+
+      // Return node to the allocator
       cur_ptr->setNext(nullptr);
-      delete cur_ptr;
+      destroyNode(cur_ptr);
       cur_ptr = nullptr;
 
       item_count_--;  // Decrease count of entries
@@ -170,8 +307,8 @@ bool LinkedList<T>::remove(int position)
 
 
 /**@post the list is empty and item_count_ == 0*/
-template<class T>
-void LinkedList<T>::clear()
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::clear()
 {
    while (!isEmpty())
       remove(0);
@@ -179,13 +316,114 @@ void LinkedList<T>::clear()
 
 
 
+/**
+ @param position of the entry to move
+ @post the entry is at position 0; entries before it move back by one
+ @return true if 0 <= position < item_count_ */
+template<class T, class Allocator>
+bool LinkedList<T, Allocator>::moveToFront(int position)
+{
+   bool able_to_move = (position >= 0) && (position < item_count_);
+   if (able_to_move && position > 0)
+      spliceToFront(getNodeAt(position - 1));
+
+   return able_to_move;
+}  // end moveToFront
+
+
+/**
+ @param position of the entry to move
+ @param target_position of the entry it should follow, counted before the move
+ @post the entry at position is linked right after the entry at target_position
+ @return true if both positions are valid and differ */
+template<class T, class Allocator>
+bool LinkedList<T, Allocator>::moveAfter(int position, int target_position)
+{
+   bool able_to_move = (position >= 0) && (position < item_count_) &&
+                       (target_position >= 0) && (target_position < item_count_) &&
+                       (position != target_position);
+   if (able_to_move)
+   {
+      // Look the lower position up first so the cursor serves the second lookup
+      Node<T>* prev_ptr = nullptr;
+      Node<T>* node_ptr = nullptr;
+      Node<T>* dest_ptr = nullptr;
+      if (target_position < position)
+      {
+         dest_ptr = getNodeAt(target_position);
+         prev_ptr = getNodeAt(position - 1);
+         node_ptr = prev_ptr->getNext();
+      }
+      else
+      {
+         prev_ptr = (position == 0) ? nullptr : getNodeAt(position - 1);
+         node_ptr = (prev_ptr == nullptr) ? head_ptr_ : prev_ptr->getNext();
+         dest_ptr = getNodeAt(target_position);
+      }  // end if
+      spliceAfter(prev_ptr, node_ptr, dest_ptr);
+   }  // end if
+
+   return able_to_move;
+}  // end moveAfter
+
+
+/**
+ @post the entries at position_a and position_b have traded places
+ @return true if both positions are valid */
+template<class T, class Allocator>
+bool LinkedList<T, Allocator>::swapEntries(int position_a, int position_b)
+{
+   bool able_to_swap = (position_a >= 0) && (position_a < item_count_) &&
+                       (position_b >= 0) && (position_b < item_count_);
+   if (able_to_swap && position_a != position_b)
+   {
+      if (position_b < position_a)
+         std::swap(position_a, position_b);
+      Node<T>* prev_a = (position_a == 0) ? nullptr : getNodeAt(position_a - 1);
+      Node<T>* a_ptr = (prev_a == nullptr) ? head_ptr_ : prev_a->getNext();
+      Node<T>* prev_b = getNodeAt(position_b - 1);
+      swapNodes(prev_a, a_ptr, prev_b, prev_b->getNext());
+   }  // end if
+
+   return able_to_swap;
+}  // end swapEntries
+
+
+/**
+ Finds the first entry satisfying pred and relinks its node to the front.
+ @return the entry's former position, or -1 if no entry satisfies pred */
+template<class T, class Allocator>
+template<class Predicate>
+int LinkedList<T, Allocator>::moveToFrontIf(Predicate pred)
+{
+   Node<T>* prev_ptr = nullptr;
+   Node<T>* cur_ptr = head_ptr_;
+   int position = 0;
+   while (cur_ptr != nullptr)
+   {
+      if (pred(cur_ptr->getItem()))
+      {
+         if (prev_ptr != nullptr)
+            spliceToFront(prev_ptr);
+         return position;
+      }  // end if
+      prev_ptr = cur_ptr;
+      cur_ptr = cur_ptr->getNext();
+      position++;
+   }  // end while
+
+   return -1;
+}  // end moveToFrontIf
+
+
+
 /**
  @pre list positions follow traditional indexing from 0 to item_count_ -1
  @param position indicating the position of the data to be retrieved
  @return data item found at position. If position is not a valid position < item_count_
  throws  PrecondViolatedExcep */
-template<class T>
-T LinkedList<T>::getEntry(int position) const
+template<class T, class Allocator>
+const T& LinkedList<T, Allocator>::getEntry(int position) const
 {
     // Enforce precondition
     bool ableToGet = (position >= 0) && (position < item_count_);
@@ -204,6 +442,22 @@ T LinkedList<T>::getEntry(int position) const
 
 
 
+/** Same as getEntry(position) const, but the entry may be modified in place,
+    and the cursor is moved to it. */
+template<class T, class Allocator>
+T& LinkedList<T, Allocator>::getEntry(int position)
+{
+    if ((position < 0) || (position >= item_count_))
+    {
+        // the const lookup throws the same exception
+        const LinkedList<T, Allocator>& self = *this;
+        self.getEntry(position);
+    }  // end if
+    return getNodeAt(position)->getItem();
+}  // end getEntry
+
+
+
 
 
 /************* PROTECTED METHODS ************/
@@ -214,31 +468,238 @@ T LinkedList<T>::getEntry(int position) const
 // @param position the index of the desired node
 //       0 <= position < item_count_
 // @return  A pointer to the node at the given position or nullptr if position is >= item_count_
-template<class T>
-Node<T>* LinkedList<T>::getNodeAt(int position) const
+template<class T, class Allocator>
+Node<T>* LinkedList<T, Allocator>::getNodeAt(int position)
+{
+    const LinkedList<T, Allocator>& self = *this;
+    Node<T>* cur_ptr = self.getNodeAt(position);
+    if (cur_ptr != nullptr)
+    {
+        cursor_ptr_ = cur_ptr;
+        cursor_pos_ = position;
+    }  // end if
+    return cur_ptr;
+}  // end getNodeAt
+
+// Same walk, reading the cursor but not moving it
+template<class T, class Allocator>
+Node<T>* LinkedList<T, Allocator>::getNodeAt(int position) const
 {
-    // Count from the beginning of the chain
+    // The last node is known without a walk
+    if (position == item_count_ - 1)
+    {
+        return tail_ptr_;
+    }  // end if
+
+    // Count from the cursor if it is at or before position, else from the beginning of the chain
     Node<T>* cur_ptr = head_ptr_;
-    for (int skip = 0; skip < position; skip++)
+    int skip = 0;
+    if (cursor_ptr_ != nullptr && cursor_pos_ <= position)
+    {
+        cur_ptr = cursor_ptr_;
+        skip = cursor_pos_;
+    }  // end if
+    for (; skip < position && cur_ptr != nullptr; skip++)
         cur_ptr = cur_ptr->getNext();
-
     return cur_ptr;
 }  // end getNodeAt
 
+// @post the cursor is unset
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::resetCursor()
+{
+    cursor_ptr_ = nullptr;
+    cursor_pos_ = 0;
+}  // end resetCursor
+
+// Allocates a node through the Allocator policy and constructs its item in place from args.
+// @return  A pointer to the new node, linked to next_node_ptr
+template<class T, class Allocator>
+template<class... Args>
+Node<T>* LinkedList<T, Allocator>::createNode(Node<T>* next_node_ptr, Args&&... args)
+{
+   void* node_memory = Allocator::allocate();
+   try
+   {
+      return new (node_memory) Node<T>(std::in_place, next_node_ptr, std::forward<Args>(args)...);
+   }
+   catch (...)
+   {
+      Allocator::deallocate(node_memory);
+      throw;
+   }  // end try
+}  // end createNode
+
+// Links an already created node into the chain.
+// @pre 0 <= position <= item_count_
+// @post new_node_ptr is at position and item_count_ is incremented
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::linkNodeAt(int position, Node<T>* new_node_ptr)
+{
+   if (position == 0)
+   {
+      // Insert new node at beginning of chain
+      new_node_ptr->setNext(head_ptr_);
+      head_ptr_ = new_node_ptr;
+      if (tail_ptr_ == nullptr)
+         tail_ptr_ = new_node_ptr;
+   }
+   else if (position == item_count_)
+   {
+      // Append after the last node without walking the chain
+      new_node_ptr->setNext(nullptr);
+      tail_ptr_->setNext(new_node_ptr);
+      tail_ptr_ = new_node_ptr;
+   }
+   else
+   {
+      // Find node that will be before new node
+      Node<T>* prev_ptr = getNodeAt(position - 1);
+      // Insert new node after node to which prev_ptr points
+      new_node_ptr->setNext(prev_ptr->getNext());
+      prev_ptr->setNext(new_node_ptr);
+   }  // end if
+   item_count_++;  // Increase count of entries
+
+   // The cached node is unchanged, but it moves one position back
+   if (cursor_ptr_ != nullptr && position <= cursor_pos_)
+      cursor_pos_++;
+}  // end linkNodeAt
+
+// @post node_ptr follows prev_ptr, or is the head if prev_ptr is nullptr
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::linkAfter(Node<T>* prev_ptr, Node<T>* node_ptr)
+{
+   if (prev_ptr == nullptr)
+      head_ptr_ = node_ptr;
+   else
+      prev_ptr->setNext(node_ptr);
+}  // end linkAfter
+
+// @post the node after prev_ptr (the head if prev_ptr is nullptr) is first
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::spliceToFront(Node<T>* prev_ptr)
+{
+   if (prev_ptr == nullptr)
+      return;  // already at the front
+
+   Node<T>* node_ptr = prev_ptr->getNext();
+   prev_ptr->setNext(node_ptr->getNext());
+   node_ptr->setNext(head_ptr_);
+   head_ptr_ = node_ptr;
+   if (tail_ptr_ == node_ptr)
+      tail_ptr_ = prev_ptr;
+   resetCursor();
+}  // end spliceToFront
+
+// @post node_ptr is linked right after dest_ptr
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::spliceAfter(Node<T>* prev_ptr, Node<T>* node_ptr, Node<T>* dest_ptr)
+{
+   if (dest_ptr == prev_ptr)
+      return;  // already right after dest_ptr
+
+   // Unlink node_ptr
+   linkAfter(prev_ptr, node_ptr->getNext());
+
+   // Relink after dest_ptr
+   node_ptr->setNext(dest_ptr->getNext());
+   dest_ptr->setNext(node_ptr);
+   if (tail_ptr_ == node_ptr)
+      tail_ptr_ = prev_ptr;
+   else if (tail_ptr_ == dest_ptr)
+      tail_ptr_ = node_ptr;
+   resetCursor();
+}  // end spliceAfter
+
+// @post a_ptr and b_ptr have traded places in the chain
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::swapNodes(Node<T>* prev_a, Node<T>* a_ptr, Node<T>* prev_b, Node<T>* b_ptr)
+{
+   if (a_ptr->getNext() == b_ptr)
+   {
+      // prev_a -> a -> b -> rest  becomes  prev_a -> b -> a -> rest
+      a_ptr->setNext(b_ptr->getNext());
+      b_ptr->setNext(a_ptr);
+      linkAfter(prev_a, b_ptr);
+   }
+   else if (b_ptr->getNext() == a_ptr)
+   {
+      // prev_b -> b -> a -> rest  becomes  prev_b -> a -> b -> rest
+      b_ptr->setNext(a_ptr->getNext());
+      a_ptr->setNext(b_ptr);
+      linkAfter(prev_b, a_ptr);
+   }
+   else
+   {
+      Node<T>* after_a = a_ptr->getNext();
+      a_ptr->setNext(b_ptr->getNext());
+      b_ptr->setNext(after_a);
+      linkAfter(prev_a, b_ptr);
+      linkAfter(prev_b, a_ptr);
+   }  // end if
+   if (tail_ptr_ == a_ptr)
+      tail_ptr_ = b_ptr;
+   else if (tail_ptr_ == b_ptr)
+      tail_ptr_ = a_ptr;
+   resetCursor();
+}  // end swapNodes
+
+// Destroys every node of the chain starting at chain_ptr.
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::destroyChain(Node<T>* chain_ptr)
+{
+   while (chain_ptr != nullptr)
+   {
+      Node<T>* next_ptr = chain_ptr->getNext();
+      destroyNode(chain_ptr);
+      chain_ptr = next_ptr;
+   }  // end while
+}  // end destroyChain
+
+// Moves a_list's whole chain into this list at position.
+// @pre 0 <= position <= item_count_ and a_list is not this list
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::spliceListAt(int position, LinkedList<T, Allocator>& a_list)
+{
+   if (a_list.isEmpty())
+      return;
+
+   Node<T>* prev_ptr = (position == 0) ? nullptr : getNodeAt(position - 1);
+   a_list.tail_ptr_->setNext((prev_ptr == nullptr) ? head_ptr_ : prev_ptr->getNext());
+   linkAfter(prev_ptr, a_list.head_ptr_);
+   if (position == item_count_)
+      tail_ptr_ = a_list.tail_ptr_;
+
+   // The cached node keeps its identity; entries at or after position move back
+   if (cursor_ptr_ != nullptr && position <= cursor_pos_)
+      cursor_pos_ += a_list.item_count_;
+   item_count_ += a_list.item_count_;
+
+   a_list.head_ptr_ = nullptr;
+   a_list.tail_ptr_ = nullptr;
+   a_list.item_count_ = 0;
+   a_list.resetCursor();
+}  // end spliceListAt
+
+// Destroys a node created by createNode and returns its memory to the Allocator.
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::destroyNode(Node<T>* node_ptr)
+{
+   node_ptr->~Node<T>();
+   Allocator::deallocate(node_ptr);
+}  // end destroyNode
+
 //position follows classic indexing from 0 to item_count_-1
 //if position > item_count it returns nullptr
-template <class T>
-Node<T> *LinkedList<T>::getPointerTo(size_t position) const
+template <class T, class Allocator>
+Node<T> *LinkedList<T, Allocator>::getPointerTo(size_t position) const
 {
 
   Node<T> *find = nullptr;
-  if (position < item_count_)
+  if (position < static_cast<size_t>(item_count_))
   {
-    find = head_ptr_;
-    for (size_t i = 0; i < position; ++i)
-    {
-      find = find->getNext();
-    }
+    find = getNodeAt(static_cast<int>(position));
   }
 
   return find;
@@ -248,12 +709,111 @@ Node<T> *LinkedList<T>::getPointerTo(size_t position) const
 
 
 //returns the head pointer
-template <class T>
-Node<T> *LinkedList<T>::getHeadNode() const
+template <class T, class Allocator>
+Node<T> *LinkedList<T, Allocator>::getHeadNode() const
 {
 
   return head_ptr_;
 } //end getHeadNode
 
 
+//returns an iterator to the first entry
+template <class T, class Allocator>
+typename LinkedList<T, Allocator>::iterator LinkedList<T, Allocator>::begin()
+{
+  return iterator(head_ptr_);
+} //end begin
+
+template <class T, class Allocator>
+typename LinkedList<T, Allocator>::const_iterator LinkedList<T, Allocator>::begin() const
+{
+  return const_iterator(head_ptr_);
+} //end begin
+
+template <class T, class Allocator>
+typename LinkedList<T, Allocator>::const_iterator LinkedList<T, Allocator>::cbegin() const
+{
+  return const_iterator(head_ptr_);
+} //end cbegin
+
+//returns the past-the-end iterator
+template <class T, class Allocator>
+typename LinkedList<T, Allocator>::iterator LinkedList<T, Allocator>::end()
+{
+  return iterator();
+} //end end
+
+template <class T, class Allocator>
+typename LinkedList<T, Allocator>::const_iterator LinkedList<T, Allocator>::end() const
+{
+  return const_iterator();
+} //end end
+
+template <class T, class Allocator>
+typename LinkedList<T, Allocator>::const_iterator LinkedList<T, Allocator>::cend() const
+{
+  return const_iterator();
+} //end cend
+
+
+
+/************* ITERATOR ************/
+
+
+template<class T, bool IsConst>
+LinkedListIterator<T, IsConst>::LinkedListIterator() : node_ptr_(nullptr)
+{
+}  // end default constructor
+
+template<class T, bool IsConst>
+LinkedListIterator<T, IsConst>::LinkedListIterator(Node<T>* node_ptr) : node_ptr_(node_ptr)
+{
+}  // end constructor
+
+template<class T, bool IsConst>
+typename LinkedListIterator<T, IsConst>::reference LinkedListIterator<T, IsConst>::operator*() const
+{
+   return node_ptr_->getItem();
+}  // end operator*
+
+template<class T, bool IsConst>
+typename LinkedListIterator<T, IsConst>::pointer LinkedListIterator<T, IsConst>::operator->() const
+{
+   return &node_ptr_->getItem();
+}  // end operator->
+
+template<class T, bool IsConst>
+LinkedListIterator<T, IsConst>& LinkedListIterator<T, IsConst>::operator++()
+{
+   node_ptr_ = node_ptr_->getNext();
+   return *this;
+}  // end operator++
+
+template<class T, bool IsConst>
+LinkedListIterator<T, IsConst> LinkedListIterator<T, IsConst>::operator++(int)
+{
+   LinkedListIterator<T, IsConst> previous = *this;
+   node_ptr_ = node_ptr_->getNext();
+   return previous;
+}  // end operator++
+
+template<class T, bool IsConst>
+bool LinkedListIterator<T, IsConst>::operator==(const LinkedListIterator<T, IsConst>& rhs) const
+{
+   return node_ptr_ == rhs.node_ptr_;
+}  // end operator==
+
+template<class T, bool IsConst>
+bool LinkedListIterator<T, IsConst>::operator!=(const LinkedListIterator<T, IsConst>& rhs) const
+{
+   return node_ptr_ != rhs.node_ptr_;
+}  // end operator!=
+
+template<class T, bool IsConst>
+Node<T>* LinkedListIterator<T, IsConst>::getNode() const
+{
+   return node_ptr_;
+}  // end getNode
+
+
 //  End of implementation file.
@@ -14,18 +14,72 @@
 #define LINKED_LIST_
 
 #include "Node.hpp"
+#include "NodePool.hpp"
 #include "PrecondViolatedExcep.hpp"
+#include <cstddef>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
 
-template<class T>
+// Forward iterator over a chain of Node<T>. IsConst selects const access to items.
+template<class T, bool IsConst>
+class LinkedListIterator
+{
+public:
+   typedef std::forward_iterator_tag iterator_category;
+   typedef T value_type;
+   typedef std::ptrdiff_t difference_type;
+   typedef typename std::conditional<IsConst, const T*, T*>::type pointer;
+   typedef typename std::conditional<IsConst, const T&, T&>::type reference;
+
+   LinkedListIterator(); // past-the-end iterator
+   explicit LinkedListIterator(Node<T>* node_ptr);
+
+   // a modifiable iterator converts to a const one
+   template<bool OtherConst, class = typename std::enable_if<IsConst && !OtherConst>::type>
+   LinkedListIterator(const LinkedListIterator<T, OtherConst>& other) : node_ptr_(other.getNode()) {}
+
+   reference operator*() const;
+   pointer operator->() const;
+   LinkedListIterator<T, IsConst>& operator++();   // pre-increment
+   LinkedListIterator<T, IsConst> operator++(int); // post-increment
+
+   bool operator==(const LinkedListIterator<T, IsConst>& rhs) const;
+   bool operator!=(const LinkedListIterator<T, IsConst>& rhs) const;
+
+   /**@return the node this iterator refers to, nullptr at end */
+   Node<T>* getNode() const;
+
+private:
+   Node<T>* node_ptr_;
+}; // end LinkedListIterator
+
+// Allocator is a node allocation policy (see NodePool.hpp). The default draws
+// nodes from a shared slab pool; HeapNodeAllocator<T> gives plain new/delete.
+template<class T, class Allocator = PoolNodeAllocator<T>>
 class LinkedList
 {
 
 public:
+   typedef LinkedListIterator<T, false> iterator;
+   typedef LinkedListIterator<T, true> const_iterator;
+
    LinkedList(); // constructor
-   LinkedList(const LinkedList<T>& a_list); // copy constructor
+   LinkedList(const LinkedList<T, Allocator>& a_list); // copy constructor
+   LinkedList(LinkedList<T, Allocator>&& a_list) noexcept; // move constructor, a_list is left empty
    virtual ~LinkedList(); // destructor
 
+   /**@post this list holds a copy of a_list's entries. Strong guarantee:
+      if copying throws, this list is unchanged */
+   LinkedList<T, Allocator>& operator=(const LinkedList<T, Allocator>& a_list);
+
+   /**@post this list owns a_list's former chain and a_list is empty */
+   LinkedList<T, Allocator>& operator=(LinkedList<T, Allocator>&& a_list) noexcept;
+
+   /**@post the chains of this list and a_list are exchanged; no node is copied */
+   void swap(LinkedList<T, Allocator>& a_list) noexcept;
+
    /**@return true if list is empty - item_count_ == 0 */
    bool isEmpty() const;
 
@@ -41,6 +95,41 @@ public:
      @return true if valid position (0 <= position <= item_count_) */
    bool insert(int position, const T& new_entry);
 
+    /** Same as insert(position, const T&), but new_entry is moved into the list. */
+   bool insert(int position, T&& new_entry);
+
+    /**
+     @param position indicating point of insertion
+     @param args arguments forwarded to T's constructor; the entry is built in its node
+     @post the new entry is at position in list
+     @return true if valid position (0 <= position <= item_count_) */
+   template<class... Args>
+   bool emplace(int position, Args&&... args);
+
+    /**
+     @param new_entry to be added after the last entry
+     @post new_entry is at position item_count_ - 1. O(1): no walk to the tail */
+   void pushBack(const T& new_entry);
+   void pushBack(T&& new_entry);
+
+    /**
+     @param position indicating point of insertion
+     @param first, last the range of entries to insert, in order
+     @post the entries are at position .. position + (last - first) - 1. Strong
+           guarantee: if copying an entry throws, this list is unchanged
+     @return true if valid position (0 <= position <= item_count_) */
+   template<class InputIterator, class = typename std::iterator_traits<InputIterator>::iterator_category>
+   bool insert(int position, InputIterator first, InputIterator last);
+
+    /** Same as the range insert, with the entries given as a braced list. */
+   bool insert(int position, std::initializer_list<T> entries);
+
+    /**
+     @param a_list list whose entries are moved to the end of this one
+     @post a_list's chain follows this list's last node and a_list is empty.
+           O(1): the chain is relinked, no node is copied */
+   void append(LinkedList<T, Allocator>&& a_list);
+
 
     /**
      @pre list positions follow traditional indexing from 0 to item_count_ -1
@@ -55,18 +144,61 @@ public:
    void clear();
 
 
+    /** Relinking operations: nodes change places, none is freed or allocated.
+
+     @param position of the entry to move
+     @post the entry is at position 0; entries before it move back by one
+     @return true if 0 <= position < item_count_ */
+   bool moveToFront(int position);
+
+    /**
+     @param position of the entry to move
+     @param target_position of the entry it should follow, counted before the move
+     @post the entry at position is linked right after the entry at target_position
+     @return true if both positions are valid and differ */
+   bool moveAfter(int position, int target_position);
+
+    /**
+     @post the entries at position_a and position_b have traded places
+     @return true if both positions are valid */
+   bool swapEntries(int position_a, int position_b);
+
+    /**
+     Finds the first entry satisfying pred and relinks its node to the front,
+     all in one pass over the chain.
+     @return the entry's former position, or -1 if no entry satisfies pred */
+   template<class Predicate>
+   int moveToFrontIf(Predicate pred);
+
+
     /**
      @pre list positions follow traditional indexing from 0 to item_count_ -1
      @param position indicating the position of the data to be retrieved
      @return data item found at position. If position is not a valid position < item_count_
             throws  PrecondViolatedExcep */
-   T getEntry(int position) const;
+   const T& getEntry(int position) const;
+
+    /** Same as getEntry(position) const, but the entry may be modified in place,
+        and the cursor is moved to it, so entries read in increasing position
+        order cost amortized O(1). */
+   T& getEntry(int position);
 
         //if position > item_count_ returns nullptr
     Node<T> *getPointerTo(size_t position) const;
 
     Node<T> *getHeadNode() const;
 
+    /**@return iterator to the first entry (equal to end() if the list is empty).
+       Iteration visits entries in position order in a single pass. */
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+
+    /**@return past-the-end iterator */
+    iterator end();
+    const_iterator end() const;
+    const_iterator cend() const;
+
 
 
 
@@ -74,8 +206,17 @@ public:
 protected:
     Node<T>* head_ptr_; // Pointer to first node in the chain;
     // (contains the first entry in the list)
+    Node<T>* tail_ptr_; // Pointer to last node in the chain, so appends do not walk it
     int item_count_;           // Current count of list items
 
+    // Cached position of the last node located by the non-const getNodeAt(),
+    // so positional access done in increasing order resumes from there instead
+    // of the head. Kept consistent by insert/remove/clear; nullptr when unset.
+    // Const lookups only read it, so a list that is not being changed may be
+    // read from several threads at once.
+    Node<T>* cursor_ptr_;
+    int cursor_pos_;
+
 
 
     // Locates a specified node in this linked list.
@@ -83,8 +224,57 @@ protected:
     // @param position the index of the desired node
     //       0 <= position < item_count_
     // @return  A pointer to the node at the given position or nullptr if position is >= item_count_
+    // @post   the cursor refers to the returned node
+    Node<T>* getNodeAt(int position);
+
+    // Same as above, starting from the cursor when that helps, but leaving it
+    // where it is
     Node<T>* getNodeAt(int position) const;
 
+    // @post the cursor is unset
+    void resetCursor();
+
+    // Allocates a node through the Allocator policy and constructs its item in place from args.
+    // @return  A pointer to the new node, linked to next_node_ptr
+    template<class... Args>
+    Node<T>* createNode(Node<T>* next_node_ptr, Args&&... args);
+
+    // Links an already created node into the chain.
+    // @pre 0 <= position <= item_count_
+    // @post new_node_ptr is at position and item_count_ is incremented
+    void linkNodeAt(int position, Node<T>* new_node_ptr);
+
+    // Destroys every node of the chain starting at chain_ptr.
+    void destroyChain(Node<T>* chain_ptr);
+
+    // Moves a_list's whole chain into this list.
+    // @pre 0 <= position <= item_count_ and a_list is not this list
+    // @post a_list's entries are at position .. and a_list is empty
+    void spliceListAt(int position, LinkedList<T, Allocator>& a_list);
+
+    // Node-level relinking. Each node is named by its predecessor (nullptr
+    // for the head) so the singly linked chain can be rewired in O(1).
+    // Positions change, so these leave the cursor unset.
+
+    // @pre prev_ptr is nullptr or a node of this list with a successor
+    // @post the node after prev_ptr (the head if prev_ptr is nullptr) is first
+    void spliceToFront(Node<T>* prev_ptr);
+
+    // @pre node_ptr follows prev_ptr (or is the head when prev_ptr is nullptr);
+    //      dest_ptr is a node of this list other than node_ptr
+    // @post node_ptr is linked right after dest_ptr
+    void spliceAfter(Node<T>* prev_ptr, Node<T>* node_ptr, Node<T>* dest_ptr);
+
+    // @pre a_ptr follows prev_a (nullptr for head), b_ptr follows prev_b, a_ptr != b_ptr
+    // @post a_ptr and b_ptr have traded places in the chain
+    void swapNodes(Node<T>* prev_a, Node<T>* a_ptr, Node<T>* prev_b, Node<T>* b_ptr);
+
+    // @post node_ptr follows prev_ptr, or is the head if prev_ptr is nullptr
+    void linkAfter(Node<T>* prev_ptr, Node<T>* node_ptr);
+
+    // Destroys a node created by createNode and returns its memory to the Allocator.
+    void destroyNode(Node<T>* node_ptr);
+
 
 
 
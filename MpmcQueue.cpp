@@ -0,0 +1,178 @@
+/** Bounded lock-free multi-producer/multi-consumer FIFO queue.
+
+ Implementation file for the class MpmcQueue.
+ @file MpmcQueue.cpp */
+
+#include "MpmcQueue.hpp"  // Header file
+#include <vector>
+
+
+// constructor
+template<class T>
+MpmcQueue<T>::MpmcQueue(std::size_t capacity) : cells_(nullptr), mask_(0), enqueue_pos_(0), dequeue_pos_(0)
+{
+   allocate(capacity);
+}  // end constructor
+
+
+// destructor
+template<class T>
+MpmcQueue<T>::~MpmcQueue()
+{
+   delete[] cells_;
+}  // end destructor
+
+
+// Cell at position p is free for the producer of p when its sequence is p,
+// and holds p's entry for the consumer when its sequence is p + 1
+template<class T>
+void MpmcQueue<T>::allocate(std::size_t capacity)
+{
+   std::size_t rounded = 2;
+   while (rounded < capacity)
+   {
+      rounded *= 2;
+   }  // end while
+   cells_ = new Cell[rounded];
+   mask_ = rounded - 1;
+   for (std::size_t i = 0; i < rounded; i++)
+   {
+      cells_[i].sequence_.store(i, std::memory_order_relaxed);
+   }  // end for
+   enqueue_pos_.store(0, std::memory_order_relaxed);
+   dequeue_pos_.store(0, std::memory_order_relaxed);
+}  // end allocate
+
+
+/** @post new_entry is the last entry */
+template<class T>
+bool MpmcQueue<T>::tryPush(const T& new_entry)
+{
+   std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+   while (true)
+   {
+      Cell* cell = &cells_[pos & mask_];
+      std::size_t sequence = cell->sequence_.load(std::memory_order_acquire);
+      std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+      if (lag == 0)
+      {
+         // the cell is free: claim the position
+         if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+         {
+            cell->item_ = new_entry;
+            cell->sequence_.store(pos + 1, std::memory_order_release);
+            return true;
+         }
+      }
+      else if (lag < 0)
+      {
+         // the consumer of the previous lap has not freed the cell: full
+         return false;
+      }
+      else
+      {
+         // another producer took the position
+         pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }  // end if
+   }  // end while
+}  // end tryPush
+
+
+/** @post the first entry is removed */
+template<class T>
+bool MpmcQueue<T>::tryPop(T& entry)
+{
+   std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+   while (true)
+   {
+      Cell* cell = &cells_[pos & mask_];
+      std::size_t sequence = cell->sequence_.load(std::memory_order_acquire);
+      std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+      if (lag == 0)
+      {
+         // the cell holds an entry: claim the position
+         if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+         {
+            entry = cell->item_;
+            // free the cell for the producer one lap ahead
+            cell->sequence_.store(pos + mask_ + 1, std::memory_order_release);
+            return true;
+         }
+      }
+      else if (lag < 0)
+      {
+         // the producer of the position has not published yet: empty
+         return false;
+      }
+      else
+      {
+         // another consumer took the position
+         pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }  // end if
+   }  // end while
+}  // end tryPop
+
+
+template<class T>
+std::size_t MpmcQueue<T>::size() const
+{
+   std::size_t dequeued = dequeue_pos_.load(std::memory_order_acquire);
+   std::size_t enqueued = enqueue_pos_.load(std::memory_order_acquire);
+   return enqueued > dequeued ? enqueued - dequeued : 0;
+}  // end size
+
+
+template<class T>
+bool MpmcQueue<T>::isEmpty() const
+{
+   return size() == 0;
+}  // end isEmpty
+
+
+template<class T>
+std::size_t MpmcQueue<T>::capacity() const
+{
+   return mask_ + 1;
+}  // end capacity
+
+
+/** Calls visit(entry) for each entry, front to back */
+template<class T>
+template<class Visitor>
+void MpmcQueue<T>::forEach(Visitor visit) const
+{
+   std::size_t end_pos = enqueue_pos_.load(std::memory_order_acquire);
+   for (std::size_t pos = dequeue_pos_.load(std::memory_order_acquire); pos != end_pos; pos++)
+   {
+      const Cell& cell = cells_[pos & mask_];
+      // stop at a position claimed but not yet published
+      if (cell.sequence_.load(std::memory_order_acquire) != pos + 1)
+      {
+         return;
+      }
+      visit(cell.item_);
+   }  // end for
+}  // end forEach
+
+
+/** @post the capacity is at least capacity */
+template<class T>
+void MpmcQueue<T>::reserve(std::size_t capacity)
+{
+   if (capacity <= this->capacity())
+   {
+      return;
+   }
+   std::vector<T> entries;
+   T entry;
+   while (tryPop(entry))
+   {
+      entries.push_back(entry);
+   }  // end while
+   delete[] cells_;
+   allocate(capacity);
+   for (const T& kept : entries)
+   {
+      tryPush(kept);
+   }  // end for
+}  // end reserve
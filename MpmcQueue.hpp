@@ -0,0 +1,75 @@
+/** Bounded lock-free multi-producer/multi-consumer FIFO queue.
+    A ring of cells, each stamped with a sequence number that says whether
+    the cell is ready for the producer or the consumer at a given position
+    (Vyukov). A producer claims a position with a CAS on the enqueue
+    position, writes the entry and publishes it by bumping the cell's
+    sequence; consumers do the same on the dequeue side. Producers and
+    consumers touch different cells and never wait on a lock.
+
+    The capacity is fixed, rounded up to a power of two. A push into a full
+    queue fails instead of growing it; reserve() grows it while no other
+    thread uses the queue.
+    @file MpmcQueue.hpp */
+
+#ifndef MPMC_QUEUE_
+#define MPMC_QUEUE_
+
+#include <atomic>
+#include <cstddef>
+
+template<class T>
+class MpmcQueue
+{
+public:
+   explicit MpmcQueue(std::size_t capacity = 1024); // constructor
+   ~MpmcQueue(); // destructor; no other thread may use the queue any more
+
+   MpmcQueue(const MpmcQueue<T>&) = delete;
+   MpmcQueue<T>& operator=(const MpmcQueue<T>&) = delete;
+
+   /**@post new_entry is the last entry. Lock-free.
+      @return true if there was room */
+   bool tryPush(const T& new_entry);
+
+   /**@post the first entry is removed and copied to entry. Lock-free.
+      @return true if the queue was not empty */
+   bool tryPop(T& entry);
+
+   /**@return the number of entries; exact when no other thread is active */
+   std::size_t size() const;
+
+   /**@return true if the queue is empty; exact when no other thread is active */
+   bool isEmpty() const;
+
+   /**@return the most entries the queue holds */
+   std::size_t capacity() const;
+
+   /** Calls visit(entry) for each entry, front to back, in place. No other
+       thread may pop meanwhile; entries pushed during the walk may be missed. */
+   template<class Visitor>
+   void forEach(Visitor visit) const;
+
+   /**@post the capacity is at least capacity, entries kept in order. No
+      other thread may use the queue meanwhile. */
+   void reserve(std::size_t capacity);
+
+private:
+   struct Cell
+   {
+      std::atomic<std::size_t> sequence_;
+      T item_;
+   };
+
+   // Producers and consumers each update their own position; keeping them
+   // on separate cache lines stops one side from stalling the other.
+   Cell* cells_;
+   std::size_t mask_;  // capacity - 1
+   alignas(64) std::atomic<std::size_t> enqueue_pos_;
+   alignas(64) std::atomic<std::size_t> dequeue_pos_;
+
+   // @post cells_ holds `capacity` empty cells ready for positions 0.. on
+   void allocate(std::size_t capacity);
+}; // end MpmcQueue
+
+#include "MpmcQueue.cpp"
+#endif
@@ -29,6 +29,48 @@ Node<T>::Node(const T& an_item, Node<T>* next_node_ptr) :
 {
 } // end constructor
 
+//parameterized constructor, takes over an_item
+template<class T>
+Node<T>::Node(T&& an_item) : item_(std::move(an_item)), next_(nullptr)
+{
+} // end constructor
+
+//parameterized constructor, takes over an_item
+template<class T>
+Node<T>::Node(T&& an_item, Node<T>* next_node_ptr) :
+                item_(std::move(an_item)), next_(next_node_ptr)
+{
+} // end constructor
+
+//in-place constructor: item_ is built directly from args
+template<class T>
+template<class... Args>
+Node<T>::Node(std::in_place_t, Node<T>* next_node_ptr, Args&&... args) :
+                item_(std::forward<Args>(args)...), next_(next_node_ptr)
+{
+} // end constructor
+
+//move constructor
+template<class T>
+Node<T>::Node(Node<T>&& a_node) noexcept(std::is_nothrow_move_constructible<T>::value) :
+                item_(std::move(a_node.item_)), next_(a_node.next_)
+{
+   a_node.next_ = nullptr;
+} // end move constructor
+
+//move assignment
+template<class T>
+Node<T>& Node<T>::operator=(Node<T>&& a_node) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+   if (this != &a_node)
+   {
+      item_ = std::move(a_node.item_);
+      next_ = a_node.next_;
+      a_node.next_ = nullptr;
+   }
+   return *this;
+} // end move assignment
+
 
 /** @param an_item contained in the node
  @post sets item_ to an_item */
@@ -38,6 +80,14 @@ void Node<T>::setItem(const T& an_item)
    item_ = an_item;
 } // end setItem
 
+/** @param an_item moved into the node
+ @post sets item_ to an_item */
+template<class T>
+void Node<T>::setItem(T&& an_item)
+{
+   item_ = std::move(an_item);
+} // end setItem
+
 
 /** @param next_node_ptr points to the next node in the chain
  @post sets next_ to next_node_ptr */
@@ -49,7 +99,14 @@ void Node<T>::setNext(Node<T>* next_node_ptr)
 
  /**@return item_*/
 template<class T>
-T Node<T>::getItem() const
+const T& Node<T>::getItem() const
+{
+   return item_;
+} // end getItem
+
+ /**@return item_, modifiable in place */
+template<class T>
+T& Node<T>::getItem()
 {
    return item_;
 } // end getItem
@@ -8,6 +8,9 @@
 #ifndef NODE_
 #define NODE_
 
+#include <type_traits>
+#include <utility>
+
 template<class T>
 class Node
 {
@@ -15,17 +18,38 @@ public:
    Node();  //default constructor
    Node(const T& an_item); //parameterized constructor
    Node(const T& an_item, Node<T>* next_node_ptr); //parameterized constructor
+   Node(T&& an_item); //parameterized constructor, takes over an_item
+   Node(T&& an_item, Node<T>* next_node_ptr); //parameterized constructor, takes over an_item
+
+   /** Constructs item_ in place from args.
+       @param next_node_ptr points to the next node in the chain */
+   template<class... Args>
+   Node(std::in_place_t, Node<T>* next_node_ptr, Args&&... args);
+
+   Node(const Node<T>& a_node) = default; //copy constructor, shares next_
+   Node<T>& operator=(const Node<T>& a_node) = default;
+
+   /** @post a_node's item is moved into this node, a_node no longer points to a next node */
+   Node(Node<T>&& a_node) noexcept(std::is_nothrow_move_constructible<T>::value); //move constructor
+   Node<T>& operator=(Node<T>&& a_node) noexcept(std::is_nothrow_move_assignable<T>::value); //move assignment
 
    /** @param an_item  contained in the node
         @post sets item_ to an_item */
    void setItem(const T& an_item);
+
+   /** @param an_item  moved into the node
+        @post sets item_ to an_item */
+   void setItem(T&& an_item);
     
     /** @param next_node_ptr points to the next node in the chain
      @post sets next_ to next_node_ptr */
    void setNext(Node<T>* next_node_ptr);
     
     /**@return item_*/
-   T getItem() const ;
+   const T& getItem() const ;
+
+    /**@return item_, modifiable in place */
+   T& getItem();
     
     /**@return next_*/
    Node<T>* getNext() const ;
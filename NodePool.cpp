@@ -0,0 +1,299 @@
+/** Slab pool and node allocator policies for the singly linked list.
+ Implementation file for SlabPool, HeapNodeAllocator and PoolNodeAllocator.
+ @file NodePool.cpp */
+
+#include "NodePool.hpp"
+#include <new>
+
+// constructor
+template<class NodeType>
+SlabPool<NodeType>::SlabPool() : free_list_(nullptr), bump_ptr_(nullptr), bump_end_(nullptr),
+                                 next_slab_slots_(FIRST_SLAB_SLOTS)
+{
+}  // end default constructor
+
+
+// destructor
+template<class NodeType>
+SlabPool<NodeType>::~SlabPool()
+{
+   for (Slot* slab : slabs_)
+      ::operator delete(slab);
+}  // end destructor
+
+
+/** @return the process-wide pool for NodeType */
+template<class NodeType>
+SlabPool<NodeType>& SlabPool<NodeType>::instance()
+{
+   static SlabPool<NodeType>* shared_pool = new SlabPool<NodeType>();
+   return *shared_pool;
+}  // end instance
+
+
+/** @return uninitialized storage for one NodeType */
+template<class NodeType>
+void* SlabPool<NodeType>::allocate()
+{
+   lock();
+   Slot* slot = nullptr;
+   try
+   {
+      slot = takeSlotLocked();
+   }
+   catch (...)
+   {
+      unlock();
+      throw;
+   }  // end try
+   unlock();
+
+   return slot;
+}  // end allocate
+
+
+/** @post slot is pushed onto the free list for reuse */
+template<class NodeType>
+void SlabPool<NodeType>::deallocate(void* slot)
+{
+   if (slot == nullptr)
+      return;
+
+   lock();
+   Slot* freed = static_cast<Slot*>(slot);
+   freed->next_free_ = free_list_;
+   free_list_ = freed;
+   unlock();
+}  // end deallocate
+
+
+/** @return storage for one NodeType from the calling thread's cache */
+template<class NodeType>
+void* SlabPool<NodeType>::allocateShared()
+{
+   ThreadCache& cache = threadCache();
+   if (cache.flushed_)
+      return instance().allocate();
+
+   if (cache.free_ == nullptr)
+      refillCache(cache);
+
+   Slot* slot = cache.free_;
+   cache.free_ = slot->next_free_;
+   cache.count_--;
+   return slot;
+}  // end allocateShared
+
+
+/** @post slot is cached by the calling thread, or returned to the shared pool */
+template<class NodeType>
+void SlabPool<NodeType>::deallocateShared(void* slot)
+{
+   if (slot == nullptr)
+      return;
+
+   ThreadCache& cache = threadCache();
+   if (cache.flushed_)
+   {
+      instance().deallocate(slot);
+      return;
+   }  // end if
+
+   Slot* freed = static_cast<Slot*>(slot);
+   freed->next_free_ = cache.free_;
+   cache.free_ = freed;
+   cache.count_++;
+   if (cache.count_ > 2 * CACHE_BATCH)
+      drainCache(cache, CACHE_BATCH);
+}  // end deallocateShared
+
+
+/**@return number of slabs requested from the system so far */
+template<class NodeType>
+std::size_t SlabPool<NodeType>::getSlabCount() const
+{
+   return slabs_.size();
+}  // end getSlabCount
+
+
+
+/************* PRIVATE METHODS ************/
+
+
+template<class NodeType>
+void SlabPool<NodeType>::lock()
+{
+   while (lock_.test_and_set(std::memory_order_acquire))
+   {
+      // spin; critical sections are a handful of pointer updates
+   }
+}  // end lock
+
+
+template<class NodeType>
+void SlabPool<NodeType>::unlock()
+{
+   lock_.clear(std::memory_order_release);
+}  // end unlock
+
+
+// Requests a new slab from the system and makes it the bump region.
+// Slab sizes double up to MAX_SLAB_SLOTS so small programs stay small.
+template<class NodeType>
+void SlabPool<NodeType>::addSlab()
+{
+   slabs_.reserve(slabs_.size() + 1);  // so push_back below cannot throw
+   Slot* slab = static_cast<Slot*>(::operator new(next_slab_slots_ * sizeof(Slot)));
+   slabs_.push_back(slab);
+
+   bump_ptr_ = slab;
+   bump_end_ = slab + next_slab_slots_;
+   if (next_slab_slots_ < MAX_SLAB_SLOTS)
+      next_slab_slots_ *= 2;
+}  // end addSlab
+
+
+// @pre the pool lock is held
+// @return a recycled slot if any, otherwise the next never-used slab slot
+template<class NodeType>
+typename SlabPool<NodeType>::Slot* SlabPool<NodeType>::takeSlotLocked()
+{
+   Slot* slot = free_list_;
+   if (slot != nullptr)
+   {
+      // Reuse the most recently freed slot; it is likely still in cache
+      free_list_ = slot->next_free_;
+   }
+   else
+   {
+      if (bump_ptr_ == bump_end_)
+         addSlab();
+      slot = bump_ptr_++;
+   }  // end if
+
+   return slot;
+}  // end takeSlotLocked
+
+
+template<class NodeType>
+typename SlabPool<NodeType>::ThreadCache& SlabPool<NodeType>::threadCache()
+{
+   static thread_local ThreadCache cache = {nullptr, 0, false};
+   static thread_local ThreadCacheFlusher flusher;
+   (void)flusher;  // odr-use so its destructor runs at thread exit
+   return cache;
+}  // end threadCache
+
+
+// Moves CACHE_BATCH slots from the shared pool into cache with one lock round trip.
+// Slots taken from the bump region come out in address order, so nodes allocated
+// back to back end up next to each other in memory.
+template<class NodeType>
+void SlabPool<NodeType>::refillCache(ThreadCache& cache)
+{
+   SlabPool<NodeType>& pool = instance();
+   Slot* batch[CACHE_BATCH];
+   std::size_t taken = 0;
+
+   pool.lock();
+   try
+   {
+      for (; taken < CACHE_BATCH; taken++)
+         batch[taken] = pool.takeSlotLocked();
+   }
+   catch (...)
+   {
+      if (taken == 0)
+      {
+         pool.unlock();
+         throw;
+      }  // end if
+   }  // end try
+   pool.unlock();
+
+   // Push in reverse so the cache hands slots out in the order they were taken
+   for (std::size_t i = taken; i > 0; i--)
+   {
+      batch[i - 1]->next_free_ = cache.free_;
+      cache.free_ = batch[i - 1];
+   }  // end for
+   cache.count_ += taken;
+}  // end refillCache
+
+
+// Returns all but `keep` cached slots to the shared pool with one lock round trip.
+template<class NodeType>
+void SlabPool<NodeType>::drainCache(ThreadCache& cache, std::size_t keep)
+{
+   if (cache.count_ <= keep)
+      return;
+
+   // Detach everything past the first `keep` slots
+   Slot* chain_head = cache.free_;
+   Slot* chain_tail = nullptr;
+   for (std::size_t i = 0; i < keep; i++)
+   {
+      chain_tail = chain_head;
+      chain_head = chain_head->next_free_;
+   }  // end for
+   if (chain_tail == nullptr)
+      cache.free_ = nullptr;
+   else
+      chain_tail->next_free_ = nullptr;
+
+   Slot* last = chain_head;
+   while (last->next_free_ != nullptr)
+      last = last->next_free_;
+
+   SlabPool<NodeType>& pool = instance();
+   pool.lock();
+   last->next_free_ = pool.free_list_;
+   pool.free_list_ = chain_head;
+   pool.unlock();
+
+   cache.count_ = keep;
+}  // end drainCache
+
+
+template<class NodeType>
+SlabPool<NodeType>::ThreadCacheFlusher::~ThreadCacheFlusher()
+{
+   ThreadCache& cache = threadCache();
+   drainCache(cache, 0);
+   cache.flushed_ = true;
+}  // end destructor
+
+
+
+/************* ALLOCATOR POLICIES ************/
+
+
+template<class T>
+void* HeapNodeAllocator<T>::allocate()
+{
+   return ::operator new(sizeof(Node<T>));
+}  // end allocate
+
+
+template<class T>
+void HeapNodeAllocator<T>::deallocate(void* node_memory)
+{
+   ::operator delete(node_memory);
+}  // end deallocate
+
+
+template<class T>
+void* PoolNodeAllocator<T>::allocate()
+{
+   return SlabPool<Node<T>>::allocateShared();
+}  // end allocate
+
+
+template<class T>
+void PoolNodeAllocator<T>::deallocate(void* node_memory)
+{
+   SlabPool<Node<T>>::deallocateShared(node_memory);
+}  // end deallocate
+
+
+//  End of implementation file.
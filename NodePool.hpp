@@ -0,0 +1,113 @@
+/** Slab pool and node allocator policies for the singly linked list.
+    A SlabPool hands out fixed-size node slots carved from contiguous
+    slabs and recycles freed slots through an intrusive free list, so
+    list churn stops going to the global heap one node at a time.
+    @file NodePool.hpp */
+
+#ifndef NODE_POOL_
+#define NODE_POOL_
+
+#include "Node.hpp"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+template<class NodeType>
+class SlabPool
+{
+public:
+   SlabPool();
+   ~SlabPool(); // returns every slab to the system
+
+   SlabPool(const SlabPool<NodeType>&) = delete;
+   SlabPool<NodeType>& operator=(const SlabPool<NodeType>&) = delete;
+
+   /** @return the process-wide pool for NodeType. It is created on first use
+        and deliberately never destroyed, so lists that outlive static
+        destruction can still release their nodes. */
+   static SlabPool<NodeType>& instance();
+
+   /** @return uninitialized storage for one NodeType, taken from the free list
+        if possible, otherwise from the current slab (a new slab is added when
+        the current one is exhausted) */
+   void* allocate();
+
+   /** @param slot storage previously returned by allocate() on this pool
+       @post slot is pushed onto the free list for reuse */
+   void deallocate(void* slot);
+
+   /** Same as instance().allocate(), but served from a small per-thread cache
+       that is refilled from the shared pool in batches, so the common case
+       takes no lock. */
+   static void* allocateShared();
+
+   /** Same as instance().deallocate(slot), through the per-thread cache.
+       @param slot storage previously returned by allocateShared() on any thread */
+   static void deallocateShared(void* slot);
+
+   /**@return number of slabs requested from the system so far */
+   std::size_t getSlabCount() const;
+
+private:
+   union Slot
+   {
+      Slot* next_free_;
+      alignas(NodeType) unsigned char storage_[sizeof(NodeType)];
+   };
+
+   // Per-thread stack of free slots in front of the shared pool. Kept trivially
+   // destructible so it stays usable for lists destroyed after thread-exit cleanup.
+   struct ThreadCache
+   {
+      Slot* free_;
+      std::size_t count_;
+      bool flushed_;  // set once the owning thread has returned its cache
+   };
+
+   // Returns the calling thread's cache to the shared pool when the thread exits.
+   struct ThreadCacheFlusher
+   {
+      ~ThreadCacheFlusher();
+   };
+
+   static const std::size_t FIRST_SLAB_SLOTS = 32;
+   static const std::size_t MAX_SLAB_SLOTS = 4096;
+   static const std::size_t CACHE_BATCH = 64;
+
+   std::vector<Slot*> slabs_;  // every slab, for release in the destructor
+   Slot* free_list_;           // recycled slots, most recently freed first
+   Slot* bump_ptr_;            // next never-used slot in the newest slab
+   Slot* bump_end_;            // one past the end of the newest slab
+   std::size_t next_slab_slots_;
+   std::atomic_flag lock_ = ATOMIC_FLAG_INIT; // pools are shared by every list of a node type
+
+   void lock();
+   void unlock();
+   void addSlab();
+   Slot* takeSlotLocked();
+
+   static ThreadCache& threadCache();
+   static void refillCache(ThreadCache& cache);
+   static void drainCache(ThreadCache& cache, std::size_t keep);
+}; // end SlabPool
+
+
+/** Allocator policy that reproduces plain new/delete: one heap allocation per node. */
+template<class T>
+struct HeapNodeAllocator
+{
+   static void* allocate();
+   static void deallocate(void* node_memory);
+}; // end HeapNodeAllocator
+
+
+/** Allocator policy that draws nodes from the shared SlabPool for Node<T>. */
+template<class T>
+struct PoolNodeAllocator
+{
+   static void* allocate();
+   static void deallocate(void* node_memory);
+}; // end PoolNodeAllocator
+
+#include "NodePool.cpp"
+#endif
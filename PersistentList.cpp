@@ -0,0 +1,448 @@
+/** ADT list: persistent (structurally shared) implementation.
+
+ Implementation file for the class PersistentList.
+ @file PersistentList.cpp */
+
+#include "PersistentList.hpp"  // Header file
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+
+/************* NODE ************/
+
+
+template<class T>
+PersistentNode<T>::PersistentNode(const NodePtr& left, const T& an_item, const NodePtr& right)
+   : item_(an_item), left_(left), right_(right),
+     size_((left ? left->size_ : 0) + 1 + (right ? right->size_ : 0)),
+     height_(std::max(left ? left->height_ : 0, right ? right->height_ : 0) + 1)
+{
+}  // end constructor
+
+template<class T>
+const T& PersistentNode<T>::getItem() const
+{
+   return item_;
+}  // end getItem
+
+template<class T>
+const typename PersistentNode<T>::NodePtr& PersistentNode<T>::getLeft() const
+{
+   return left_;
+}  // end getLeft
+
+template<class T>
+const typename PersistentNode<T>::NodePtr& PersistentNode<T>::getRight() const
+{
+   return right_;
+}  // end getRight
+
+template<class T>
+int PersistentNode<T>::getSize() const
+{
+   return size_;
+}  // end getSize
+
+template<class T>
+int PersistentNode<T>::getHeight() const
+{
+   return height_;
+}  // end getHeight
+
+
+
+/************* ITERATOR ************/
+
+
+template<class T>
+PersistentListIterator<T>::PersistentListIterator()
+{
+}  // end default constructor
+
+template<class T>
+PersistentListIterator<T>::PersistentListIterator(const PersistentNode<T>* root_ptr)
+{
+   pushLeftSpine(root_ptr);
+}  // end constructor
+
+template<class T>
+typename PersistentListIterator<T>::reference PersistentListIterator<T>::operator*() const
+{
+   return path_.back()->getItem();
+}  // end operator*
+
+template<class T>
+typename PersistentListIterator<T>::pointer PersistentListIterator<T>::operator->() const
+{
+   return &path_.back()->getItem();
+}  // end operator->
+
+// In-order step: the next entry is the leftmost one of the right subtree,
+// or else the nearest ancestor still on the path
+template<class T>
+PersistentListIterator<T>& PersistentListIterator<T>::operator++()
+{
+   const PersistentNode<T>* node_ptr = path_.back();
+   path_.pop_back();
+   pushLeftSpine(node_ptr->getRight().get());
+   return *this;
+}  // end operator++
+
+template<class T>
+PersistentListIterator<T> PersistentListIterator<T>::operator++(int)
+{
+   PersistentListIterator<T> previous = *this;
+   ++(*this);
+   return previous;
+}  // end operator++
+
+template<class T>
+bool PersistentListIterator<T>::operator==(const PersistentListIterator<T>& rhs) const
+{
+   if (path_.empty() || rhs.path_.empty())
+      return path_.empty() == rhs.path_.empty();
+   return path_.back() == rhs.path_.back();
+}  // end operator==
+
+template<class T>
+bool PersistentListIterator<T>::operator!=(const PersistentListIterator<T>& rhs) const
+{
+   return !(*this == rhs);
+}  // end operator!=
+
+template<class T>
+void PersistentListIterator<T>::pushLeftSpine(const PersistentNode<T>* node_ptr)
+{
+   for (; node_ptr != nullptr; node_ptr = node_ptr->getLeft().get())
+      path_.push_back(node_ptr);
+}  // end pushLeftSpine
+
+
+
+/************* LIST ************/
+
+
+// constructor
+template<class T>
+PersistentList<T>::PersistentList()
+{
+}  // end default constructor
+
+
+template<class T>
+template<class InputIterator, class>
+PersistentList<T>::PersistentList(InputIterator first, InputIterator last)
+{
+   std::vector<T> entries(first, last);
+   root_ = buildBalanced(entries, 0, static_cast<int>(entries.size()));
+}  // end constructor
+
+
+template<class T>
+PersistentList<T>::PersistentList(const NodePtr& root) : root_(root)
+{
+}  // end constructor
+
+
+/**@return a list sharing every node with this one */
+template<class T>
+PersistentList<T> PersistentList<T>::snapshot() const
+{
+   return PersistentList<T>(std::atomic_load(&root_));
+}  // end snapshot
+
+
+template<class T>
+bool PersistentList<T>::isEmpty() const
+{
+   return root_ == nullptr;
+}  // end isEmpty
+
+
+template<class T>
+int PersistentList<T>::getLength() const
+{
+   return sizeOf(root_);
+}  // end getLength
+
+
+template<class T>
+bool PersistentList<T>::insert(int position, const T& new_entry)
+{
+   bool able_to_insert = (position >= 0) && (position <= getLength());
+   if (able_to_insert)
+      publish(insertAt(root_, position, new_entry));
+
+   return able_to_insert;
+}  // end insert
+
+
+template<class T>
+void PersistentList<T>::pushBack(const T& new_entry)
+{
+   publish(insertAt(root_, getLength(), new_entry));
+}  // end pushBack
+
+
+// The new version is built off to the side and published once, so a throwing
+// copy leaves this list unchanged and readers never see half of the range
+template<class T>
+template<class InputIterator, class>
+bool PersistentList<T>::insert(int position, InputIterator first, InputIterator last)
+{
+   bool able_to_insert = (position >= 0) && (position <= getLength());
+   if (able_to_insert)
+   {
+      NodePtr new_root = root_;
+      for (; first != last; ++first, ++position)
+         new_root = insertAt(new_root, position, *first);
+      publish(new_root);
+   }  // end if
+
+   return able_to_insert;
+}  // end insert
+
+
+template<class T>
+bool PersistentList<T>::remove(int position)
+{
+   bool able_to_remove = (position >= 0) && (position < getLength());
+   if (able_to_remove)
+      publish(removeAt(root_, position));
+
+   return able_to_remove;
+}  // end remove
+
+
+template<class T>
+void PersistentList<T>::clear()
+{
+   publish(nullptr);
+}  // end clear
+
+
+template<class T>
+bool PersistentList<T>::setEntry(int position, const T& new_entry)
+{
+   bool able_to_set = (position >= 0) && (position < getLength());
+   if (able_to_set)
+      publish(replaceAt(root_, position, new_entry));
+
+   return able_to_set;
+}  // end setEntry
+
+
+template<class T>
+bool PersistentList<T>::moveToFront(int position)
+{
+   bool able_to_move = (position >= 0) && (position < getLength());
+   if (able_to_move && position > 0)
+   {
+      T entry = itemAt(root_, position);
+      publish(insertAt(removeAt(root_, position), 0, entry));
+   }  // end if
+
+   return able_to_move;
+}  // end moveToFront
+
+
+template<class T>
+bool PersistentList<T>::swapEntries(int position_a, int position_b)
+{
+   bool able_to_swap = (position_a >= 0) && (position_a < getLength()) &&
+                       (position_b >= 0) && (position_b < getLength());
+   if (able_to_swap && position_a != position_b)
+   {
+      T entry_a = itemAt(root_, position_a);
+      NodePtr new_root = replaceAt(root_, position_a, itemAt(root_, position_b));
+      publish(replaceAt(new_root, position_b, entry_a));
+   }  // end if
+
+   return able_to_swap;
+}  // end swapEntries
+
+
+template<class T>
+const T& PersistentList<T>::getEntry(int position) const
+{
+   if (position < 0 || position >= getLength())
+   {
+      std::string message = "getEntry() called with an empty list or ";
+      message = message + "invalid position.";
+      throw(PrecondViolatedExcep(message));
+   }  // end if
+   return itemAt(root_, position);
+}  // end getEntry
+
+
+template<class T>
+typename PersistentList<T>::const_iterator PersistentList<T>::begin() const
+{
+   return const_iterator(root_.get());
+}  // end begin
+
+template<class T>
+typename PersistentList<T>::const_iterator PersistentList<T>::cbegin() const
+{
+   return const_iterator(root_.get());
+}  // end cbegin
+
+template<class T>
+typename PersistentList<T>::const_iterator PersistentList<T>::end() const
+{
+   return const_iterator();
+}  // end end
+
+template<class T>
+typename PersistentList<T>::const_iterator PersistentList<T>::cend() const
+{
+   return const_iterator();
+}  // end cend
+
+
+
+/************* PRIVATE METHODS ************/
+
+
+template<class T>
+void PersistentList<T>::publish(const NodePtr& new_root)
+{
+   std::atomic_store(&root_, new_root);
+}  // end publish
+
+template<class T>
+int PersistentList<T>::sizeOf(const NodePtr& node)
+{
+   return node ? node->getSize() : 0;
+}  // end sizeOf
+
+template<class T>
+int PersistentList<T>::heightOf(const NodePtr& node)
+{
+   return node ? node->getHeight() : 0;
+}  // end heightOf
+
+template<class T>
+typename PersistentList<T>::NodePtr PersistentList<T>::makeNode(const NodePtr& left, const T& an_item, const NodePtr& right)
+{
+   return std::make_shared<const PersistentNode<T>>(left, an_item, right);
+}  // end makeNode
+
+
+// Joins left, an_item and right, rotating once or twice if one side is two taller.
+template<class T>
+typename PersistentList<T>::NodePtr PersistentList<T>::balance(const NodePtr& left, const T& an_item, const NodePtr& right)
+{
+   int left_height = heightOf(left);
+   int right_height = heightOf(right);
+   if (left_height > right_height + 1)
+   {
+      const NodePtr& outer = left->getLeft();
+      const NodePtr& inner = left->getRight();
+      if (heightOf(outer) >= heightOf(inner))
+         return makeNode(outer, left->getItem(), makeNode(inner, an_item, right));
+      return makeNode(makeNode(outer, left->getItem(), inner->getLeft()), inner->getItem(),
+                      makeNode(inner->getRight(), an_item, right));
+   }  // end if
+   if (right_height > left_height + 1)
+   {
+      const NodePtr& outer = right->getRight();
+      const NodePtr& inner = right->getLeft();
+      if (heightOf(outer) >= heightOf(inner))
+         return makeNode(makeNode(left, an_item, inner), right->getItem(), outer);
+      return makeNode(makeNode(left, an_item, inner->getLeft()), inner->getItem(),
+                      makeNode(inner->getRight(), right->getItem(), outer));
+   }  // end if
+   return makeNode(left, an_item, right);
+}  // end balance
+
+
+template<class T>
+typename PersistentList<T>::NodePtr PersistentList<T>::insertAt(const NodePtr& node, int position, const T& new_entry)
+{
+   if (node == nullptr)
+      return makeNode(nullptr, new_entry, nullptr);
+
+   int left_size = sizeOf(node->getLeft());
+   if (position <= left_size)
+      return balance(insertAt(node->getLeft(), position, new_entry), node->getItem(), node->getRight());
+   return balance(node->getLeft(), node->getItem(), insertAt(node->getRight(), position - left_size - 1, new_entry));
+}  // end insertAt
+
+
+template<class T>
+typename PersistentList<T>::NodePtr PersistentList<T>::removeAt(const NodePtr& node, int position)
+{
+   int left_size = sizeOf(node->getLeft());
+   if (position < left_size)
+      return balance(removeAt(node->getLeft(), position), node->getItem(), node->getRight());
+   if (position > left_size)
+      return balance(node->getLeft(), node->getItem(), removeAt(node->getRight(), position - left_size - 1));
+
+   // node holds the entry: join its subtrees around the next entry in order
+   if (node->getLeft() == nullptr)
+      return node->getRight();
+   if (node->getRight() == nullptr)
+      return node->getLeft();
+   const NodePtr& right = node->getRight();
+   return balance(node->getLeft(), itemAt(right, 0), removeFirst(right));
+}  // end removeAt
+
+
+template<class T>
+typename PersistentList<T>::NodePtr PersistentList<T>::removeFirst(const NodePtr& node)
+{
+   if (node->getLeft() == nullptr)
+      return node->getRight();
+   return balance(removeFirst(node->getLeft()), node->getItem(), node->getRight());
+}  // end removeFirst
+
+
+template<class T>
+typename PersistentList<T>::NodePtr PersistentList<T>::replaceAt(const NodePtr& node, int position, const T& new_entry)
+{
+   int left_size = sizeOf(node->getLeft());
+   if (position < left_size)
+      return makeNode(replaceAt(node->getLeft(), position, new_entry), node->getItem(), node->getRight());
+   if (position > left_size)
+      return makeNode(node->getLeft(), node->getItem(), replaceAt(node->getRight(), position - left_size - 1, new_entry));
+   return makeNode(node->getLeft(), new_entry, node->getRight());
+}  // end replaceAt
+
+
+template<class T>
+const T& PersistentList<T>::itemAt(const NodePtr& node, int position)
+{
+   const PersistentNode<T>* node_ptr = node.get();
+   while (true)
+   {
+      int left_size = sizeOf(node_ptr->getLeft());
+      if (position == left_size)
+         return node_ptr->getItem();
+      if (position < left_size)
+      {
+         node_ptr = node_ptr->getLeft().get();
+      }
+      else
+      {
+         position -= left_size + 1;
+         node_ptr = node_ptr->getRight().get();
+      }  // end if
+   }  // end while
+}  // end itemAt
+
+
+template<class T>
+typename PersistentList<T>::NodePtr PersistentList<T>::buildBalanced(const std::vector<T>& entries, int first, int last)
+{
+   if (first >= last)
+      return nullptr;
+
+   int middle = first + (last - first) / 2;
+   return makeNode(buildBalanced(entries, first, middle), entries[middle],
+                   buildBalanced(entries, middle + 1, last));
+}  // end buildBalanced
+
+
+//  End of implementation file.
@@ -0,0 +1,177 @@
+/** ADT list: persistent (structurally shared) implementation.
+    Entries live in an immutable, size-balanced (AVL) tree of shared nodes,
+    ordered by position. An update builds new nodes only along the path from
+    the root to the position it touches - O(log n) of them - and shares every
+    other node with the previous version, so snapshot() is O(1) and a
+    snapshot stays valid, unchanged, for as long as anyone holds it.
+
+    One thread may update a list while any number of threads call snapshot()
+    on it; every other member needs the caller's own synchronization, like
+    LinkedList.
+    @file PersistentList.hpp */
+
+#ifndef PERSISTENT_LIST_
+#define PERSISTENT_LIST_
+
+#include "PrecondViolatedExcep.hpp"
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+template<class T>
+class PersistentNode
+{
+public:
+   typedef std::shared_ptr<const PersistentNode<T>> NodePtr;
+
+   PersistentNode(const NodePtr& left, const T& an_item, const NodePtr& right);
+
+   const T& getItem() const;
+   const NodePtr& getLeft() const;
+   const NodePtr& getRight() const;
+
+   /**@return number of entries in the subtree rooted here */
+   int getSize() const;
+
+   /**@return height of the subtree rooted here (a leaf has height 1) */
+   int getHeight() const;
+
+private:
+   T item_;
+   NodePtr left_;   // entries before item_
+   NodePtr right_;  // entries after item_
+   int size_;
+   int height_;
+}; // end PersistentNode
+
+
+// Forward iterator over the entries of a persistent list, in position order.
+// Entries are immutable, so there is only a const iterator.
+template<class T>
+class PersistentListIterator
+{
+public:
+   typedef std::forward_iterator_tag iterator_category;
+   typedef T value_type;
+   typedef std::ptrdiff_t difference_type;
+   typedef const T* pointer;
+   typedef const T& reference;
+
+   PersistentListIterator(); // past-the-end iterator
+   explicit PersistentListIterator(const PersistentNode<T>* root_ptr);
+
+   reference operator*() const;
+   pointer operator->() const;
+   PersistentListIterator<T>& operator++();   // pre-increment
+   PersistentListIterator<T> operator++(int); // post-increment
+
+   bool operator==(const PersistentListIterator<T>& rhs) const;
+   bool operator!=(const PersistentListIterator<T>& rhs) const;
+
+private:
+   // Nodes still to visit; the top is the current entry
+   std::vector<const PersistentNode<T>*> path_;
+
+   void pushLeftSpine(const PersistentNode<T>* node_ptr);
+}; // end PersistentListIterator
+
+
+template<class T>
+class PersistentList
+{
+public:
+   typedef PersistentListIterator<T> const_iterator;
+   typedef const_iterator iterator;
+
+   PersistentList(); // constructor
+
+   /**@post the list holds [first, last) in order; built balanced in O(n) */
+   template<class InputIterator, class = typename std::iterator_traits<InputIterator>::iterator_category>
+   PersistentList(InputIterator first, InputIterator last);
+
+   /**@return a list sharing every node with this one, in O(1). Safe to call
+      while another thread updates this list; the result never changes. */
+   PersistentList<T> snapshot() const;
+
+   /**@return true if list is empty */
+   bool isEmpty() const;
+
+   /**@return the number of items in the list */
+   int getLength() const;
+
+   /**
+    @param position indicating point of insertion
+    @param new_entry to be inserted in list
+    @post new_entry is at position; O(log n) nodes are copied
+    @return true if valid position (0 <= position <= getLength()) */
+   bool insert(int position, const T& new_entry);
+
+   /**@post new_entry is the last entry */
+   void pushBack(const T& new_entry);
+
+   /** Same as insert, for the entries [first, last), in order. */
+   template<class InputIterator, class = typename std::iterator_traits<InputIterator>::iterator_category>
+   bool insert(int position, InputIterator first, InputIterator last);
+
+   /**
+    @param position indicating point of deletion
+    @post entry at position is deleted, if any; O(log n) nodes are copied
+    @return true if there is an entry at position to be deleted */
+   bool remove(int position);
+
+   /**@post the list is empty. Snapshots taken earlier keep their entries. */
+   void clear();
+
+   /**
+    @post the entry at position is new_entry
+    @return true if 0 <= position < getLength() */
+   bool setEntry(int position, const T& new_entry);
+
+   /** Reordering operations, matching LinkedList.
+       @return true if the positions are valid (see LinkedList) */
+   bool moveToFront(int position);
+   bool swapEntries(int position_a, int position_b);
+
+   /**
+    @return data item found at position, in O(log n). If position is not a
+            valid position < getLength() throws PrecondViolatedExcep */
+   const T& getEntry(int position) const;
+
+   const_iterator begin() const;
+   const_iterator cbegin() const;
+   const_iterator end() const;
+   const_iterator cend() const;
+
+private:
+   typedef typename PersistentNode<T>::NodePtr NodePtr;
+
+   // Root of the current version. Updates publish a new root with
+   // std::atomic_store so snapshot() can read it from other threads.
+   NodePtr root_;
+
+   explicit PersistentList(const NodePtr& root);
+
+   void publish(const NodePtr& new_root);
+
+   static int sizeOf(const NodePtr& node);
+   static int heightOf(const NodePtr& node);
+   static NodePtr makeNode(const NodePtr& left, const T& an_item, const NodePtr& right);
+
+   // Joins left, an_item and right whose heights differ by at most two,
+   // rotating so the result is balanced again.
+   static NodePtr balance(const NodePtr& left, const T& an_item, const NodePtr& right);
+
+   // Path-copying updates; each returns the root of the new version.
+   static NodePtr insertAt(const NodePtr& node, int position, const T& new_entry);
+   static NodePtr removeAt(const NodePtr& node, int position);
+   static NodePtr removeFirst(const NodePtr& node);  // drops the first entry
+   static NodePtr replaceAt(const NodePtr& node, int position, const T& new_entry);
+   static const T& itemAt(const NodePtr& node, int position);
+
+   // @return a balanced tree holding entries[first, last)
+   static NodePtr buildBalanced(const std::vector<T>& entries, int first, int last);
+}; // end PersistentList
+
+#include "PersistentList.cpp"
+#endif
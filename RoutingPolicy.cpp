@@ -0,0 +1,94 @@
+/**
+ * @file RoutingPolicy.cpp
+ * @brief Implementation of the routing policies.
+ *
+ * @date December 1, 2024
+ * @author kufunei
+ */
+
+#include "RoutingPolicy.hpp"
+#include <algorithm>
+#include <limits>
+
+QueuedDemand::QueuedDemand() {
+    for (std::atomic<std::atomic<long>*>& chunk : chunks_) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+QueuedDemand::~QueuedDemand() {
+    for (std::atomic<std::atomic<long>*>& chunk : chunks_) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+// Finds an ingredient's counter; the first thread to need a chunk installs it
+std::atomic<long>* QueuedDemand::counter(SymbolId ingredient_id, bool create) {
+    if (ingredient_id < 0 || ingredient_id >= MAX_INGREDIENTS) {
+        return nullptr;
+    }
+    std::atomic<std::atomic<long>*>& slot = chunks_[ingredient_id / CHUNK_SIZE];
+    std::atomic<long>* chunk = slot.load(std::memory_order_acquire);
+    if (chunk == nullptr && create) {
+        std::atomic<long>* fresh = new std::atomic<long>[CHUNK_SIZE];
+        for (int i = 0; i < CHUNK_SIZE; i++) {
+            fresh[i].store(0, std::memory_order_relaxed);
+        }
+        if (slot.compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel)) {
+            chunk = fresh;
+        } else {
+            delete[] fresh;  // another thread installed one first
+        }
+    }
+    return chunk == nullptr ? nullptr : &chunk[ingredient_id % CHUNK_SIZE];
+}
+
+const std::atomic<long>* QueuedDemand::counter(SymbolId ingredient_id) const {
+    return const_cast<QueuedDemand*>(this)->counter(ingredient_id, false);
+}
+
+// Returns the quantity of an ingredient still needed
+long QueuedDemand::of(SymbolId ingredient_id) const {
+    const std::atomic<long>* needed = counter(ingredient_id);
+    return needed == nullptr ? 0 : needed->load(std::memory_order_relaxed);
+}
+
+// Counts a dish's ingredients `times` more
+void QueuedDemand::add(const Dish& dish, long times) {
+    const std::vector<Ingredient>& ingredients = dish.getIngredients();
+    const std::vector<SymbolId>& ingredient_ids = dish.getIngredientIds();
+    for (size_t i = 0; i < ingredients.size(); i++) {
+        std::atomic<long>* needed = counter(ingredient_ids[i], true);
+        if (needed != nullptr) {
+            needed->fetch_add(times * ingredients[i].required_quantity, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Forgets all demand
+void QueuedDemand::clear() {
+    for (std::atomic<std::atomic<long>*>& slot : chunks_) {
+        std::atomic<long>* chunk = slot.load(std::memory_order_relaxed);
+        for (int i = 0; chunk != nullptr && i < CHUNK_SIZE; i++) {
+            chunk[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Negative of the tightest cover the station keeps after making the dish
+double InventoryCostPolicy::cost(const KitchenStation& station, const Dish& dish, const QueuedDemand& demand) const {
+    if (!station.canCompleteOrder(dish.getNameId())) {
+        return std::numeric_limits<double>::infinity();
+    }
+    const std::vector<Ingredient>& ingredients = dish.getIngredients();
+    const std::vector<SymbolId>& ingredient_ids = dish.getIngredientIds();
+    double tightest = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < ingredients.size(); i++) {
+        long left = station.getStockQuantity(ingredient_ids[i]) - ingredients[i].required_quantity;
+        long wanted = ingredients[i].required_quantity + demand.of(ingredient_ids[i]);
+        if (wanted > 0) {
+            tightest = std::min(tightest, static_cast<double>(left) / wanted);
+        }
+    }
+    return -tightest;
+}
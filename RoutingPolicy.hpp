@@ -0,0 +1,96 @@
+/**
+ * @file RoutingPolicy.hpp
+ * @brief Pluggable policies for choosing which station makes a dish.
+ *
+ * When several stations can make a dish, StationManager asks its routing
+ * policy for the cost of making the dish at each one and tries them in
+ * order of increasing cost, equal costs in their usual order. A policy sees
+ * the stations' stock and the demand of the dishes still queued.
+ *
+ * @date December 1, 2024
+ * @author kufunei
+ */
+
+#ifndef ROUTINGPOLICY_HPP
+#define ROUTINGPOLICY_HPP
+
+#include "Dish.hpp"
+#include "KitchenStation.hpp"
+#include "SymbolTable.hpp"
+#include <atomic>
+#include <vector>
+
+// The ingredient quantities still needed by the dishes in a queue, counted as
+// the dishes would deduct them (required_quantity per ingredient). Threads
+// adding dishes to and taking dishes from the queue may update it at once:
+// counters are atomic and live in chunks that are never moved, allocated on
+// first use. Ingredients with ids past MAX_INGREDIENTS are not counted.
+class QueuedDemand {
+public:
+    static const int CHUNK_SIZE = 1024;
+    static const int MAX_CHUNKS = 1024;
+    static const SymbolId MAX_INGREDIENTS = CHUNK_SIZE * MAX_CHUNKS;
+
+    QueuedDemand();
+    ~QueuedDemand();
+    QueuedDemand(const QueuedDemand&) = delete;
+    QueuedDemand& operator=(const QueuedDemand&) = delete;
+
+    /**
+     * @param ingredient_id An interned ingredient name.
+     * @return: The quantity of the ingredient the queued dishes still need.
+     */
+    long of(SymbolId ingredient_id) const;
+
+    /**
+     * @param dish A dish entering the queue (times = 1) or leaving it
+     *        (times = -1).
+     * @post: The dish's ingredients are counted times more.
+     */
+    void add(const Dish& dish, long times);
+
+    /**
+     * @post: Nothing is needed. No other thread may update the demand
+     *        meanwhile.
+     */
+    void clear();
+
+private:
+    // by ingredient id: chunks_[id / CHUNK_SIZE][id % CHUNK_SIZE]
+    std::atomic<std::atomic<long>*> chunks_[MAX_CHUNKS];
+
+    // returns the counter for an ingredient id below MAX_INGREDIENTS,
+    // allocating its chunk if create, else nullptr if it has none
+    std::atomic<long>* counter(SymbolId ingredient_id, bool create);
+    const std::atomic<long>* counter(SymbolId ingredient_id) const;
+};
+
+class RoutingPolicy {
+public:
+    virtual ~RoutingPolicy() = default;
+
+    /**
+     * @param station A station the dish is assigned to.
+     * @param dish The dish being routed; it is no longer counted in demand.
+     * @param demand What the rest of the queue still needs.
+     * @return: The cost of making the dish at the station. Stations are
+     *          tried cheapest first.
+     */
+    virtual double cost(const KitchenStation& station, const Dish& dish, const QueuedDemand& demand) const = 0;
+};
+
+// Sends a dish to the station its stock suits best. For each of the dish's
+// ingredients, the cover at a station is what would be left after the
+// deduction, as a share of what this dish and the rest of the queue need of
+// it; the station whose tightest ingredient keeps the most cover is tried
+// first. Measured against its own stock, demand thus steers a dish away from
+// a station whose plenty lies in ingredients nobody is waiting for, while
+// the rest of the queue needs most of what it has of another. Stations that
+// cannot make the dish from stock are tried last, so a backup draw is the
+// last resort rather than what happens once the first station runs dry.
+class InventoryCostPolicy : public RoutingPolicy {
+public:
+    double cost(const KitchenStation& station, const Dish& dish, const QueuedDemand& demand) const override;
+};
+
+#endif // ROUTINGPOLICY_HPP
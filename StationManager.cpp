@@ -1,6 +1,6 @@
 /**
  * @file StationManager.cpp
- * @brief This file contains the implementation of the StationManager class that is a subclass of LinkedList that stores KitchenStation* objects, which represents a station manager in a virtual bistro simulation.
+ * @brief This file contains the implementation of the StationManager class that stores KitchenStation* objects on a roster list, which represents a station manager in a virtual bistro simulation.
  * 
  * The StationManager class includes a default constructor, destructor, and methods to manage and present the details of the station manager. 
  * 
@@ -9,104 +9,318 @@
  */
 
 #include "StationManager.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Weight of a station's past success score against its latest attempt
+const double ROUTE_SCORE_DECAY = 0.75;
+
+// A station new to a dish starts out trusted, ahead of any that has failed
+StationManager::RouteCandidate newCandidate(KitchenStation* station) {
+    return StationManager::RouteCandidate{station, 0, 0, 1.0};
+}
+
+}  // namespace
+
+// Trace text a worker writes during a parallel pass, appended to one string
+// whose storage is kept for the next pass
+struct StationManager::TraceBuffer : std::streambuf {
+    std::string text;
+    size_t mark = 0;  // end of the last span handed to a dish
+
+    int overflow(int c) override
+    {
+        if (c != traits_type::eof())
+        {
+            text.push_back(static_cast<char>(c));
+        }
+        return c;
+    }
+
+    std::streamsize xsputn(const char* chars, std::streamsize count) override
+    {
+        text.append(chars, static_cast<size_t>(count));
+        return count;
+    }
+};
 
 // Default Constructor
-StationManager::StationManager() {
+StationManager::StationManager()
+    : verbose_routing_(false), routing_mode_(ROSTER_ORDER), routing_stats_{0, 0, 0, 0, 0, 0},
+      simulated_time_(0), routing_policy_(nullptr), worker_threads_(1),
+      dish_queue_(DISH_QUEUE_CAPACITY), queue_discipline_(FIFO), next_sequence_(0),
+      free_slots_(static_cast<long>(dish_queue_.capacity())),
+      queue_slots_(static_cast<long>(dish_queue_.capacity())), producers_(0), growing_(false), retry_parking_(false), retry_backoff_(0),
+      next_ticket_(0), open_backup_reservations_(0), snapshots_enabled_(false),
+      concurrent_reads_(false) {
     // Initializes an empty station manager
 }
 
+// Destructor: stops the roster's stations reporting restocks here
+StationManager::~StationManager() {
+    if (retry_parking_) {
+        for (KitchenStation* station : *this) {
+            station->setStockListener(nullptr);
+        }
+    }
+}
+
 
 // Adds a new station to the station manager
 bool StationManager::addStation(KitchenStation* station) {
-    return insert(item_count_, station);
+    std::lock_guard<std::mutex> hold(routing_lock_);
+    pushBack(station);
+    if (concurrent_reads_) {
+        live_roster_.pushBack(station);
+    }
+    indexStation(station);
+    if (snapshots_enabled_) {
+        roster_view_.pushBack(station);
+    }
+    return true;
+}
+
+// Adds several stations after the existing ones in a single splice
+int StationManager::addStations(const std::vector<KitchenStation*>& stations) {
+    std::lock_guard<std::mutex> hold(routing_lock_);
+    if (snapshots_enabled_) {
+        roster_view_.insert(roster_view_.getLength(), stations.begin(), stations.end());
+    }
+    insert(getLength(), stations.begin(), stations.end());
+    for (KitchenStation* station : stations) {
+        if (concurrent_reads_) {
+            live_roster_.pushBack(station);
+        }
+        indexStation(station);
+    }
+    return static_cast<int>(stations.size());
+}
+
+// Takes over the roster of another station manager; the nodes are relinked, not copied
+void StationManager::appendStations(StationManager& other) {
+    if (this != &other) {
+        std::scoped_lock hold(routing_lock_, other.routing_lock_);
+        if (snapshots_enabled_) {
+            roster_view_.insert(roster_view_.getLength(), other.begin(), other.end());
+        }
+        if (other.snapshots_enabled_) {
+            other.roster_view_.clear();
+        }
+        for (KitchenStation* station : other) {
+            if (other.retry_parking_) {
+                station->setStockListener(nullptr);
+            }
+            if (other.concurrent_reads_) {
+                other.live_roster_.removeEntry(station);
+            }
+            if (concurrent_reads_) {
+                live_roster_.pushBack(station);
+            }
+            indexStation(station);
+        }
+        // the donor keeps no route to the stations it gave away
+        other.station_index_.clear();
+        other.dish_index_.clear();
+        append(std::move(static_cast<StationList&>(other)));
+    }
 }
 
 // Removes a station from the station manager by name
 bool StationManager::removeStation(const std::string& station_name) {
-    for (int i = 0; i < item_count_; ++i) {
-        if (getEntry(i)->getName() == station_name) {
-            return remove(i);
-        }
+    std::lock_guard<std::mutex> hold(routing_lock_);
+    KitchenStation* station = findStation(station_name);
+    if (station == nullptr) {
+        return false;
     }
-    return false;
+    return removeFromRoster(station);
+}
+
+// Takes a station off the roster and out of every index
+bool StationManager::removeFromRoster(KitchenStation* station) {
+    unindexStation(station);
+    if (concurrent_reads_) {
+        live_roster_.removeEntry(station);
+    }
+#ifdef STATION_LIST_INTRUSIVE
+    if (!snapshots_enabled_) {
+        // the station is its own list node, so it unlinks without a walk
+        return removeEntry(station);
+    }
+#endif
+    int position = getStationIndex(station);
+    if (snapshots_enabled_) {
+        roster_view_.remove(position);
+    }
+    return remove(position);
 }
 
 // Finds a station in the station manager by name
 KitchenStation* StationManager::findStation(const std::string& station_name) const {
-    Node<KitchenStation*>* searchptr = getHeadNode();
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->getName() == station_name) {
-            return searchptr->getItem();
-        }
-        searchptr = searchptr->getNext();
+    return findStation(SymbolTable::find(station_name));
+}
+
+KitchenStation* StationManager::findStation(SymbolId station_id) const {
+    auto found = station_index_.find(station_id);
+    if (found == station_index_.end()) {
+        return nullptr;
     }
-    return nullptr;
+    return found->second.station;
 }
 
 // Moves a specified station to the front of the station manager list
 bool StationManager::moveStationToFront(const std::string& station_name) {
-    // First, make sure the station exists
-    if (findStation(station_name) == nullptr) {
+    std::lock_guard<std::mutex> hold(routing_lock_);
+    KitchenStation* station = findStation(station_name);
+    if (station == nullptr) {
         return false;
     }
-    
-    // If it's already at the front, return true
-    if (getHeadNode()->getItem()->getName() == station_name) {
+    // One pass of pointer comparisons finds the station and relinks it at
+    // the front; nothing is allocated or freed
+    int position = moveToFrontIf([station](KitchenStation* entry) {
+        return entry == station;
+    });
+    if (concurrent_reads_ && position > 0) {
+        live_roster_.moveToFront(station);
+    }
+    if (snapshots_enabled_ && position > 0) {
+        roster_view_.moveToFront(position);
+    }
+    // it is now the first station with its name, and, unless the dishes'
+    // stations are ranked by score, the first station for each of its dishes
+    station_index_[station->getNameId()].station = station;
+    if (routing_mode_ == ADAPTIVE) {
         return true;
     }
+    for (Dish* dish : station->getDishes()) {
+        std::vector<RouteCandidate>& candidates = dish_index_[dish->getNameId()];
+        auto moved = std::find_if(candidates.begin(), candidates.end(),
+                                  [station](const RouteCandidate& candidate) { return candidate.station == station; });
+        std::rotate(candidates.begin(), moved, moved + 1);
+    }
+    return true;
+}
 
-    Node<KitchenStation*>* searchptr = getHeadNode();
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->getName() == station_name) {
-            // Make a copy of the station
-            KitchenStation* station = searchptr->getItem();
-            
-            // Remove the station from its current position
-            int pos = getStationIndex(searchptr->getItem()->getName());
-            remove(pos);
-            
-            // Insert the station at the front
-            insert(0, station);
-            
-            return true;  // Exit after moving the station
-        }
-        
-        searchptr = searchptr->getNext();  // Move to the next node
-    }
-    
-    return false;
+// Starts mirroring the roster into a persistent list
+void StationManager::enableSnapshots() {
+    std::lock_guard<std::mutex> hold(routing_lock_);
+    if (!snapshots_enabled_) {
+        roster_view_ = RosterSnapshot(begin(), end());
+        snapshots_enabled_ = true;
+    }
+}
+
+// Returns an immutable view of the roster
+StationManager::RosterSnapshot StationManager::snapshot() const {
+    if (snapshots_enabled_) {
+        return roster_view_.snapshot();
+    }
+    return RosterSnapshot(begin(), end());
+}
+
+// Starts mirroring the roster into a lock-free list
+void StationManager::enableConcurrentReads() {
+    std::lock_guard<std::mutex> hold(routing_lock_);
+    if (!concurrent_reads_) {
+        for (KitchenStation* station : *this) {
+            live_roster_.pushBack(station);
+        }
+        concurrent_reads_ = true;
+    }
 }
 
+// Returns the station at a roster position, without moving the list's cursor
+KitchenStation* StationManager::getEntry(int position) const {
+    return StationList::getEntry(position);
+}
 
-int StationManager::getStationIndex(const std::string& name) const {
-    Node<KitchenStation*>* searchptr = getHeadNode();
+int StationManager::getStationIndex(const KitchenStation* station) const {
     int index = 0;
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->getName() == name) {
+    for (KitchenStation* entry : *this) {
+        if (entry == station) {
             return index;
         }
-        searchptr = searchptr->getNext();
         index++;
     }
     return -1;
 }
 
+// Records a station just added at the back of the roster
+void StationManager::indexStation(KitchenStation* station) {
+    auto inserted = station_index_.emplace(station->getNameId(), IndexEntry{station, 1});
+    if (!inserted.second) {
+        // an earlier station has this name and stays the one found
+        inserted.first->second.count++;
+    }
+    // the station is last in the roster, so last for each of its dishes
+    for (Dish* dish : station->getDishes()) {
+        dish_index_[dish->getNameId()].push_back(newCandidate(station));
+    }
+    if (retry_parking_) {
+        station->setStockListener(this);
+    }
+}
+
+// Forgets a station that is about to leave the roster
+void StationManager::unindexStation(KitchenStation* station) {
+    if (retry_parking_) {
+        station->setStockListener(nullptr);
+    }
+    for (Dish* dish : station->getDishes()) {
+        auto listed = dish_index_.find(dish->getNameId());
+        if (listed != dish_index_.end()) {
+            std::vector<RouteCandidate>& candidates = listed->second;
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                            [station](const RouteCandidate& candidate) { return candidate.station == station; }),
+                             candidates.end());
+            if (candidates.empty()) {
+                dish_index_.erase(listed);
+            }
+        }
+    }
+    auto found = station_index_.find(station->getNameId());
+    if (found == station_index_.end()) {
+        return;
+    }
+    if (--found->second.count == 0) {
+        station_index_.erase(found);
+    } else if (found->second.station == station) {
+        // the next station with this name takes its place; shared names are
+        // rare, so this scan is too
+        for (KitchenStation* entry : *this) {
+            if (entry != station && entry->getNameId() == found->first) {
+                found->second.station = entry;
+                break;
+            }
+        }
+    }
+}
+
 // Merges the dishes and ingredients of two specified stations
 bool StationManager::mergeStations(const std::string& station_name1, const std::string& station_name2) {
+    std::lock_guard<std::mutex> hold(routing_lock_);
     KitchenStation* station1 = findStation(station_name1);
     KitchenStation* station2 = findStation(station_name2);
     if (station1 && station2) {
         // take all the dishes from station2 and add them to station1
         for (Dish* dish : station2->getDishes()) {
-            station1->assignDishToStation(dish);
+            if (station1->assignDishToStation(dish)) {
+                indexDish(dish->getNameId(), station1);
+            }
         }
         // take all the ingredients from station2 and add them to station1
         for (Ingredient ingredient : station2->getIngredientsStock()) {
             station1->replenishStationIngredients(ingredient);
         }
         // remove station2 from the list
-        removeStation(station_name2);
+        removeFromRoster(station2);
         return true;
     }
     return false;
@@ -114,13 +328,210 @@ bool StationManager::mergeStations(const std::string& station_name1, const std::
 
 // Assigns a dish to a specific station
 bool StationManager::assignDishToStation(const std::string& station_name, Dish* dish) {
+    std::lock_guard<std::mutex> hold(routing_lock_);
     KitchenStation* station = findStation(station_name);
-    if (station) {
-        return station->assignDishToStation(dish);
+    if (station && station->assignDishToStation(dish)) {
+        indexDish(dish->getNameId(), station);
+        return true;
     }
     return false;
 }
 
+// Records that a station in the roster can now make a dish
+void StationManager::indexDish(SymbolId dish_id, KitchenStation* station) {
+    std::vector<RouteCandidate>& candidates = dish_index_[dish_id];
+    // walk the roster alongside the stations already listed to keep them in
+    // roster order; most dishes have no station yet and skip the walk. In
+    // adaptive order a new station is tried first, until it has a record.
+    if (routing_mode_ == ADAPTIVE) {
+        candidates.insert(candidates.begin(), newCandidate(station));
+        rankCandidates(candidates, 1);
+        return;
+    }
+    auto next = candidates.begin();
+    if (!candidates.empty()) {
+        for (KitchenStation* entry : *this) {
+            if (entry == station) {
+                break;
+            }
+            if (next != candidates.end() && next->station == entry) {
+                ++next;
+            }
+        }
+    }
+    candidates.insert(next, newCandidate(station));
+}
+
+// Returns the route candidates for a dish, or nullptr if it has none
+std::vector<StationManager::RouteCandidate>* StationManager::routesFor(SymbolId dish_id) {
+    auto found = dish_index_.find(dish_id);
+    if (found == dish_index_.end()) {
+        return nullptr;
+    }
+    return &found->second;
+}
+
+// Records the outcome of one station's attempt at a dish
+void StationManager::recordProbe(RouteCandidate& candidate, bool hit, RoutingStats& stats) {
+    if (hit) {
+        candidate.hits++;
+    } else {
+        candidate.misses++;
+        stats.failed_probes++;
+    }
+    candidate.score = ROUTE_SCORE_DECAY * candidate.score + (hit ? 1.0 - ROUTE_SCORE_DECAY : 0.0);
+}
+
+// Puts a dish's candidates back in order of decreasing score. Everything
+// after the first `changed` is still in order, so each of those is sunk into
+// place from the back - an insertion sort over the stations just tried, and
+// O(1) once the best station is first. Equal scores keep their order.
+void StationManager::rankCandidates(std::vector<RouteCandidate>& candidates, size_t changed) {
+    if (routing_mode_ != ADAPTIVE) {
+        return;
+    }
+    for (size_t i = std::min(changed, candidates.size()); i-- > 0;) {
+        RouteCandidate candidate = candidates[i];
+        size_t j = i;
+        while (j + 1 < candidates.size() && candidates[j + 1].score > candidate.score) {
+            candidates[j] = candidates[j + 1];
+            j++;
+        }
+        candidates[j] = candidate;
+    }
+}
+
+// Puts a dish's candidates in the order to try them. By start time, routing
+// a dish delays one station, so the list is nearly sorted and the insertion
+// sort is close to linear. Both sorts are stable, so ties keep their order.
+void StationManager::orderCandidates(const Dish* dish, std::vector<RouteCandidate>& candidates) {
+    if (routing_mode_ == POLICY && routing_policy_ != nullptr) {
+        // sorting (cost, position) pairs keeps ties in order without the
+        // buffer std::stable_sort would allocate for every dish
+        policy_order_.clear();
+        for (size_t i = 0; i < candidates.size(); i++) {
+            policy_order_.emplace_back(routing_policy_->cost(*candidates[i].station, *dish, queued_demand_), i);
+        }
+        std::sort(policy_order_.begin(), policy_order_.end());
+        policy_candidates_ = candidates;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            candidates[i] = policy_candidates_[policy_order_[i].second];
+        }
+        return;
+    }
+    if (routing_mode_ != EARLIEST_FINISH) {
+        return;
+    }
+    for (size_t i = 1; i < candidates.size(); i++) {
+        RouteCandidate candidate = candidates[i];
+        long start = std::max(simulated_time_, candidate.station->getBusyUntil());
+        size_t j = i;
+        while (j > 0 && std::max(simulated_time_, candidates[j - 1].station->getBusyUntil()) > start) {
+            candidates[j] = candidates[j - 1];
+            j--;
+        }
+        candidates[j] = candidate;
+    }
+}
+
+// Chooses the order in which stations are tried
+void StationManager::setRoutingMode(RoutingMode mode) {
+    if (mode == routing_mode_) {
+        return;
+    }
+    if (routing_mode_ != ROSTER_ORDER) {
+        restoreRosterOrder();
+    }
+    routing_mode_ = mode;
+    if (mode == POLICY) {
+        // demand is only kept up to date while a policy may read it
+        queued_demand_.clear();
+        forEachQueuedDish([this](Dish* dish) { queued_demand_.add(*dish, 1); });
+    }
+    if (mode == ADAPTIVE) {
+        for (auto& listed : dish_index_) {
+            rankCandidates(listed.second, listed.second.size());
+        }
+    }
+    // EARLIEST_FINISH and POLICY order each dish's list as the dish is routed
+}
+
+// Returns the order in which stations are tried
+StationManager::RoutingMode StationManager::getRoutingMode() const {
+    return routing_mode_;
+}
+
+// Switches between roster order and score order for trying stations
+void StationManager::setAdaptiveRouting(bool adaptive) {
+    setRoutingMode(adaptive ? ADAPTIVE : ROSTER_ORDER);
+}
+
+// Routes by a policy's costs, or by roster order without one
+void StationManager::setRoutingPolicy(RoutingPolicy* policy) {
+    routing_policy_ = policy;
+    setRoutingMode(policy != nullptr ? POLICY : ROSTER_ORDER);
+}
+
+// Returns the simulated clock
+long StationManager::getSimulatedTime() const {
+    return simulated_time_;
+}
+
+// Moves the simulated clock forward
+void StationManager::advanceSimulatedTime(long minutes) {
+    simulated_time_ += minutes;
+}
+
+// Puts the simulated clock and every station's backlog back at minute 0
+void StationManager::resetSimulatedTime() {
+    simulated_time_ = 0;
+    for (KitchenStation* station : *this) {
+        station->setBusyUntil(0);
+    }
+}
+
+// Books a prepared dish on the station's simulated backlog
+void StationManager::scheduleDish(KitchenStation* station, const Dish* dish, RoutingStats& stats) {
+    long finish = std::max(simulated_time_, station->getBusyUntil()) + dish->getPrepTime();
+    station->setBusyUntil(finish);
+    stats.dishes_prepared++;
+    stats.latest_finish = std::max(stats.latest_finish, finish);
+    stats.total_latency += finish - simulated_time_;
+}
+
+// Puts every dish's candidates back in roster order, keeping their records
+void StationManager::restoreRosterOrder() {
+    std::unordered_map<KitchenStation*, int> position;
+    for (KitchenStation* station : *this) {
+        position.emplace(station, static_cast<int>(position.size()));
+    }
+    for (auto& listed : dish_index_) {
+        std::stable_sort(listed.second.begin(), listed.second.end(),
+                         [&position](const RouteCandidate& a, const RouteCandidate& b) {
+                             return position[a.station] < position[b.station];
+                         });
+    }
+}
+
+// Returns the routing totals
+StationManager::RoutingStats StationManager::getRoutingStats() const {
+    return routing_stats_;
+}
+
+// Zeroes the routing totals
+void StationManager::resetRoutingStats() {
+    routing_stats_ = RoutingStats{0, 0, 0, 0, 0, 0};
+}
+
+// Returns a dish's candidates in the order they are tried
+std::vector<StationManager::RouteCandidate> StationManager::getRouteCandidates(const std::string& dish_name) const {
+    auto found = dish_index_.find(SymbolTable::find(dish_name));
+    if (found == dish_index_.end()) {
+        return {};
+    }
+    return found->second;
+}
+
 // Replenishes an ingredient at a specific station
 bool StationManager::replenishIngredientAtStation(const std::string& station_name, const Ingredient& ingredient) {
     KitchenStation* station = findStation(station_name);
@@ -133,12 +544,18 @@ bool StationManager::replenishIngredientAtStation(const std::string& station_nam
 
 // Checks if any station in the station manager can complete an order for a specific dish
 bool StationManager::canCompleteOrder(const std::string& dish_name) const {
-    Node<KitchenStation*>* searchptr = getHeadNode();
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->canCompleteOrder(dish_name)) {
+    return canCompleteOrder(SymbolTable::find(dish_name));
+}
+
+bool StationManager::canCompleteOrder(SymbolId dish_id) const {
+    auto found = dish_index_.find(dish_id);
+    if (found == dish_index_.end()) {
+        return false;
+    }
+    for (const RouteCandidate& candidate : found->second) {
+        if (candidate.station->canCompleteOrder(dish_id)) {
             return true;
         }
-        searchptr = searchptr->getNext();
     }
     return false;
 }
@@ -146,10 +563,7 @@ bool StationManager::canCompleteOrder(const std::string& dish_name) const {
 // Prepares a dish at a specific station if possible
 bool StationManager::prepareDishAtStation(const std::string& station_name, const std::string& dish_name) {
     KitchenStation* station = findStation(station_name);
-    if (station && station->canCompleteOrder(dish_name)) {
-        return station->prepareDish(dish_name);
-    }
-    return false;
+    return station && station->prepareDish(dish_name);
 }
 
 //-----------------------------------------------------------------------------------------
@@ -163,7 +577,25 @@ bool StationManager::prepareDishAtStation(const std::string& station_name, const
  */
 std::queue<Dish*> StationManager::getDishQueue() const
 {
-    return dish_queue_;
+    std::queue<Dish*> dish_queue;
+    forEachQueuedDish([&dish_queue](Dish* dish) { dish_queue.push(dish); });
+    return dish_queue;
+}
+
+// Returns the number of dishes in the queue: every slot a dish holds
+size_t StationManager::getDishQueueSize() const
+{
+    long held = queue_slots_.load(std::memory_order_acquire) - free_slots_.load(std::memory_order_acquire);
+    return held > 0 ? static_cast<size_t>(held) : 0;
+}
+
+// Makes room for more dishes in the queue
+void StationManager::reserveDishQueue(size_t capacity)
+{
+    size_t old_capacity = dish_queue_.capacity();
+    dish_queue_.reserve(capacity);
+    free_slots_ += static_cast<long>(dish_queue_.capacity() - old_capacity);
+    queue_slots_.store(static_cast<long>(dish_queue_.capacity()), std::memory_order_release);
 }
 
 /**
@@ -186,7 +618,22 @@ Dish objects.
 queue. */
 void StationManager::setDishQueue(std::queue<Dish*> dish_queue)
 {
-    dish_queue_ = dish_queue;
+    QueuedOrder order;
+    while (dish_queue_.tryPop(order))
+    {
+    }
+    scheduled_orders_.clear();
+    {
+        std::lock_guard<std::mutex> hold(parked_lock_);
+        dropParkedOrders();
+    }
+    reserveDishQueue(dish_queue.size());
+    free_slots_ = static_cast<long>(dish_queue_.capacity());
+    queued_demand_.clear();
+    for (; !dish_queue.empty(); dish_queue.pop())
+    {
+        enqueueDish(dish_queue.front(), NO_DEADLINE);
+    }
 }
 
 // Method	Definition
@@ -209,7 +656,7 @@ void StationManager::addDishToQueue(Dish* dish)
 {
     if (dish != nullptr)
     {
-        dish_queue_.push(dish);
+        enqueueDish(dish, NO_DEADLINE);
     }
 }
 
@@ -227,10 +674,31 @@ void StationManager::addDishToQueue(Dish* dish, const Dish::DietaryRequest& requ
     if (dish != nullptr)
     {
         dish->dietaryAccommodations(request);
-        dish_queue_.push(dish);
+        enqueueDish(dish, NO_DEADLINE);
+    }
+}
+
+/**
+ * Adds a dish to the preparation queue with a deadline.
+ * @param dish A pointer to a dynamically allocated Dish object.
+ * @param deadline The simulated minute the order is due by.
+ * @pre: The dish pointer is not null.
+ * @post: The dish is added to the queue.
+ */
+void StationManager::addDishToQueue(Dish* dish, long deadline)
+{
+    if (dish != nullptr)
+    {
+        enqueueDish(dish, deadline);
     }
 }
 
+// Adds a dish to the queue only if that needs no waiting
+bool StationManager::tryAddDishToQueue(Dish* dish, long deadline)
+{
+    return dish != nullptr && tryEnqueueDish(dish, deadline);
+}
+
 /**
  * Prepares the next dish in the queue if possible.
  * @pre: The dish queue is not empty.
@@ -240,145 +708,397 @@ void StationManager::addDishToQueue(Dish* dish, const Dish::DietaryRequest& requ
  */
 bool StationManager::prepareNextDish()
 {
-    if (dish_queue_.empty() == true)
+    std::lock_guard<std::mutex> hold(routing_lock_);
+    wakeDueOrders();
+    QueuedOrder order;
+    if (takeOrder(order) == false)
     {
         return false;
     }
+    Dish* dish = order.dish;
+    countDemand(dish, -1);
 
-    Dish* dish = dish_queue_.front();
-    dish_queue_.pop();
-
-    for (size_t i = 0; i < getLength(); i++)
+    std::vector<RouteCandidate>* candidates = routesFor(dish->getNameId());
+    if (candidates != nullptr)
     {
-        KitchenStation* station = getEntry(i);
-        if (station->canCompleteOrder(dish->getName()) && station->prepareDish(dish->getName()))
+        bool prepared = false;
+        size_t probed = 0;
+        orderCandidates(dish, *candidates);
+        for (RouteCandidate& candidate : *candidates)
+        {
+            probed++;
+            prepared = candidate.station->tryConsume(dish->getNameId()).status == KitchenStation::PREPARED;
+            recordProbe(candidate, prepared, routing_stats_);
+            if (prepared)
+            {
+                scheduleDish(candidate.station, dish, routing_stats_);
+                break;
+            }
+        }
+        rankCandidates(*candidates, probed);
+        if (prepared)
         {
+            releaseDishSlot();
             return true;
         }
     }
-    dish_queue_.push(dish);
-    return false;
-}  
-
-/**
- * Displays all dishes in the preparation queue.
-* @pre: None.
- * @post: Outputs the names of the dishes in the queue in order (each name
-is on its own line).
-*/
-void StationManager::displayDishQueue()
-{
-    std::queue<Dish*> temp_dish_queue_ = dish_queue_;
-    while (temp_dish_queue_.empty() == false)
+    if (retry_parking_)
+    {
+        findMissingIngredients(dish, missing_scratch_);
+    }
+    if (!retry_parking_ || !parkOrder(order, missing_scratch_))
     {
-        Dish* temp_dish = temp_dish_queue_.front();
-        std::cout << temp_dish->getName() << std::endl;
-        temp_dish_queue_.pop(); 
+        requeueOrder(order);
     }
+    routing_stats_.queue_failures++;
+    return false;
 }
 
-/**
- * Clears all dishes from the preparation queue.
- * @pre: None.
- * @post: The dish queue is emptied and all allocated memory is freed.
- */
-void StationManager::clearDishQueue()
+// Adds a new dish, doubling the queue whenever it is full
+void StationManager::enqueueDish(Dish* dish, long deadline)
 {
-    while (dish_queue_.empty() == false)
+    while (!tryEnqueueDish(dish, deadline))
     {
-        Dish* dish = dish_queue_.front();
-        delete dish;        
-        dish_queue_.pop();
+        growDishQueue();
     }
 }
 
-/**
- * Replenishes a specific ingredient at a given station from the backup
-ingredients stock by a specified quantity.
- * @param station_name A string representing the name of the station.
- * @param ingredient_name A string representing the name of the ingredient
-to replenish.
- * @param quantity An integer representing the amount to replenish.
- * @pre None.
- * @post If the ingredient is found in the backup ingredients stock and has
-sufficient quantity, it is added to the station's ingredient stock by the
-specified amount, and the function returns true.
- *       The quantity of the ingredient in the backup stock is decreased by
-the specified amount.
- *       If the ingredient in backup stock is depleted (quantity becomes
-zero), it is removed from the backup stock.
- *       If the ingredient does not have sufficient quantity in backup
-stock, or the ingredient or station is not found, returns false.
-* @return True if the ingredient was replenished from backup; false
-otherwise.
- */
-bool StationManager::replenishStationIngredientFromBackup(const std::string& station_name, const std::string& ingredient_name, const int& quantity)
+// Adds a new dish if a slot is free and the queue is not being grown. The
+// caller counts as a producer first, so growDishQueue knows to wait for it.
+bool StationManager::tryEnqueueDish(Dish* dish, long deadline)
 {
-    KitchenStation* station = findStation(station_name);
-    if (station == nullptr)
+    producers_.fetch_add(1);
+    if (growing_.load())
     {
+        producers_.fetch_sub(1);
         return false;
     }
-
-    for (size_t i = 0; i < backup_ingredients_.size(); i++)
+    long free = free_slots_.load(std::memory_order_relaxed);
+    while (free > 0 && !free_slots_.compare_exchange_weak(free, free - 1, std::memory_order_acquire))
     {
-        if (backup_ingredients_[i].name == ingredient_name && backup_ingredients_[i].quantity >= quantity)
+    }
+    if (free > 0)
+    {
+        countDemand(dish, 1);
+        QueuedOrder order{dish, deadline, 0};
+        // only fails while a thread taking the dish a lap ahead has not yet
+        // marked its cell free
+        while (!dish_queue_.tryPush(order))
         {
-            if (replenishIngredientAtStation(station_name, Ingredient{ingredient_name, quantity, {}, {}}))
-            {
-                backup_ingredients_[i].quantity = backup_ingredients_[i].quantity - quantity;
-
-                if (backup_ingredients_[i].quantity <= 0)
-                {
-                    backup_ingredients_.erase(backup_ingredients_.begin() + i);
-                    i--;
-                }
-                return true;
-            }
-            return false;
+            std::this_thread::yield();
         }
     }
-    return false;
+    producers_.fetch_sub(1, std::memory_order_release);
+    return free > 0;
 }
 
-/**
- * Sets the backup ingredients stock with the provided list of ingredients.
- * @param ingredients A vector of Ingredient objects to set as the backup
-stock.
- * @pre None.
- * @post The backup_ingredients_ vector is replaced with the provided
-ingredients.
- * @return True if the ingredients were added; false otherwise.
- */
-bool StationManager::addBackupIngredients(const std::vector<Ingredient>& ingredients)
+// Doubles a full queue. Dishes are taken under routing_lock_ and parked ones
+// come back under parked_lock_, so with both held only producers can touch
+// the ring: new ones back off while growing_ is set, and the pushes already
+// under way finish without waiting on anyone.
+void StationManager::growDishQueue()
 {
-    backup_ingredients_ = ingredients;
-    return true;
+    std::lock_guard<std::mutex> hold(routing_lock_);
+    std::lock_guard<std::mutex> hold_parked(parked_lock_);
+    growing_.store(true);
+    while (producers_.load() > 0)
+    {
+        std::this_thread::yield();
+    }
+    // another producer may have grown it, or a dish been taken, meanwhile
+    if (free_slots_.load() <= 0)
+    {
+        reserveDishQueue(2 * dish_queue_.capacity());
+    }
+    growing_.store(false);
 }
 
-/**
- * Adds a single ingredient to the backup ingredients stock.
- * @param ingredient An Ingredient object to add to the backup stock.
- * @pre None.
- * @post If the ingredient already exists in the backup stock, its quantity
-is increased by the ingredient's quantity.
- *       If the ingredient does not exist, it is added to the backup stock.
- * @return True if the ingredient was added; false otherwise.
+// Puts an order that failed back in the slot it holds. The push can only
+// fail while a thread taking the dish a lap ahead has not yet marked its cell
+// free.
+void StationManager::requeueOrder(const QueuedOrder& order)
+{
+    countDemand(order.dish, 1);
+    if (queue_discipline_ != FIFO)
+    {
+        scheduleOrder(order);
+        return;
+    }
+    while (!dish_queue_.tryPush(order))
+    {
+        std::this_thread::yield();
+    }
+}
+
+// Takes the next order under the discipline. Under FIFO this is a lock-free
+// pop; otherwise the caller holds routing_lock_ and, if file_arrivals, the
+// arrivals are filed in the heap first.
+bool StationManager::takeOrder(QueuedOrder& order, bool file_arrivals)
+{
+    if (queue_discipline_ == FIFO)
+    {
+        return dish_queue_.tryPop(order);
+    }
+    if (file_arrivals)
+    {
+        fileArrivals();
+    }
+    if (scheduled_orders_.isEmpty())
+    {
+        return false;
+    }
+    order = scheduled_orders_.peekTop().order;
+    scheduled_orders_.remove();
+    return true;
+}
+
+// Moves the arrivals into the heap. @pre routing_lock_ is held
+void StationManager::fileArrivals()
+{
+    QueuedOrder arrived;
+    while (dish_queue_.tryPop(arrived))
+    {
+        scheduleOrder(arrived);
+    }
+}
+
+// Counts the orders a pass starting now takes: those in the queue, not the
+// parked ones, which hold slots too. Under a heap discipline the arrivals are
+// filed first, and the pass then takes from the heap alone.
+// @pre routing_lock_ is held
+size_t StationManager::countWaitingOrders()
+{
+    if (queue_discipline_ == FIFO)
+    {
+        return dish_queue_.size();
+    }
+    fileArrivals();
+    return scheduled_orders_.size();
+}
+
+// Files an order in the heap behind every order that arrived before it
+void StationManager::scheduleOrder(const QueuedOrder& order)
+{
+    long key = queue_discipline_ == SHORTEST_PREP_FIRST ? order.dish->getPrepTime() : order.deadline;
+    scheduled_orders_.add(ScheduledOrder{key, next_sequence_++, order});
+}
+
+// Lists the queued orders as they would be taken, arrivals not yet filed
+// after the ones that were
+std::vector<StationManager::ScheduledOrder> StationManager::ordersInServiceOrder() const
+{
+    std::vector<ScheduledOrder> waiting(scheduled_orders_.entries());
+    unsigned long sequence = next_sequence_;
+    dish_queue_.forEach([&](const QueuedOrder& order) {
+        long key = queue_discipline_ == SHORTEST_PREP_FIRST ? order.dish->getPrepTime() : order.deadline;
+        waiting.push_back(ScheduledOrder{key, sequence++, order});
+    });
+    std::sort(waiting.begin(), waiting.end(), ServedBefore());
+    return waiting;
+}
+
+// Switches discipline with every queued order back in the ring in arrival
+// order, to be filed again on the next take
+void StationManager::setQueueDiscipline(QueueDiscipline discipline)
+{
+    if (discipline == queue_discipline_)
+    {
+        return;
+    }
+    std::vector<ScheduledOrder> scheduled(scheduled_orders_.entries());
+    std::sort(scheduled.begin(), scheduled.end(), [](const ScheduledOrder& a, const ScheduledOrder& b) {
+        return a.sequence < b.sequence;
+    });
+    std::vector<QueuedOrder> arrived;
+    QueuedOrder order;
+    while (dish_queue_.tryPop(order))
+    {
+        arrived.push_back(order);
+    }
+    scheduled_orders_.clear();
+    // every order holds a slot, so the ring has room for all of them
+    for (const ScheduledOrder& waiting : scheduled)
+    {
+        dish_queue_.tryPush(waiting.order);
+    }
+    for (const QueuedOrder& waiting : arrived)
+    {
+        dish_queue_.tryPush(waiting);
+    }
+    queue_discipline_ = discipline;
+}
+
+StationManager::QueueDiscipline StationManager::getQueueDiscipline() const
+{
+    return queue_discipline_;
+}
+
+// Counts a dish entering or leaving the queue in its demand, under POLICY
+void StationManager::countDemand(const Dish* dish, long times)
+{
+    if (routing_mode_ == POLICY)
+    {
+        queued_demand_.add(*dish, times);
+    }
+}
+
+void StationManager::releaseDishSlot()
+{
+    free_slots_.fetch_add(1, std::memory_order_release);
+}  
+
+/**
+ * Displays all dishes in the preparation queue.
+* @pre: None.
+ * @post: Outputs the names of the dishes in the queue in order (each name
+is on its own line).
+*/
+void StationManager::displayDishQueue()
+{
+    forEachQueuedDish([](Dish* dish) { std::cout << dish->getName() << std::endl; });
+}
+
+/**
+ * Clears all dishes from the preparation queue.
+ * @pre: None.
+ * @post: The dish queue is emptied and all allocated memory is freed.
  */
-bool StationManager::addBackupIngredient(const Ingredient& ingredient)
+void StationManager::clearDishQueue()
 {
-    for (size_t i = 0; i < backup_ingredients_.size(); i++)
+    // Routers own the heap and the dish they are routing, so wait for them.
+    // Threads may still add dishes meanwhile, so the demand of each dish is
+    // taken off rather than cleared.
+    std::lock_guard<std::mutex> hold(routing_lock_);
+    QueuedOrder order;
+    while (dish_queue_.tryPop(order))
+    {
+        countDemand(order.dish, -1);
+        delete order.dish;        
+        releaseDishSlot();
+    }
+    for (const ScheduledOrder& waiting : scheduled_orders_.entries())
+    {
+        countDemand(waiting.order.dish, -1);
+        delete waiting.order.dish;
+        releaseDishSlot();
+    }
+    scheduled_orders_.clear();
+    // in one hold, so a restock cannot wake a dish already deleted
+    std::lock_guard<std::mutex> hold_parked(parked_lock_);
+    for (const auto& parked : parked_orders_)
     {
-        if (backup_ingredients_[i].name == ingredient.name)
+        delete parked.second.order.dish;
+        releaseDishSlot();
+    }
+    dropParkedOrders();
+}
+
+/**
+ * Replenishes a specific ingredient at a given station from the backup
+ingredients stock by a specified quantity.
+ * @param station_name A string representing the name of the station.
+ * @param ingredient_name A string representing the name of the ingredient
+to replenish.
+ * @param quantity An integer representing the amount to replenish.
+ * @pre None.
+ * @post If the ingredient is found in the backup ingredients stock and has
+sufficient quantity, it is added to the station's ingredient stock by the
+specified amount, and the function returns true.
+ *       The quantity of the ingredient in the backup stock is decreased by
+the specified amount.
+ *       If the ingredient in backup stock is depleted (quantity becomes
+zero), it is removed from the backup stock.
+ *       If the ingredient does not have sufficient quantity in backup
+stock, or the ingredient or station is not found, returns false.
+* @return True if the ingredient was replenished from backup; false
+otherwise.
+ */
+bool StationManager::replenishStationIngredientFromBackup(const std::string& station_name, const std::string& ingredient_name, const int& quantity)
+{
+    KitchenStation* station = findStation(station_name);
+    if (station == nullptr)
+    {
+        return false;
+    }
+
+    SymbolId ingredient_id = SymbolTable::find(ingredient_name);
+    for (size_t i = 0; i < backup_ids_.size(); i++)
+    {
+        if (backup_ids_[i] == ingredient_id && backup_ingredients_[i].quantity >= quantity)
         {
-            backup_ingredients_[i].quantity = backup_ingredients_[i].quantity + ingredient.quantity;
-            return true;
+            if (replenishIngredientAtStation(station_name, Ingredient{ingredient_name, quantity, {}, {}}))
+            {
+                backup_ingredients_[i].quantity = backup_ingredients_[i].quantity - quantity;
+
+                if (backup_ingredients_[i].quantity <= 0)
+                {
+                    backup_ingredients_.erase(backup_ingredients_.begin() + i);
+                    backup_ids_.erase(backup_ids_.begin() + i);
+                }
+                return true;
+            }
+            return false;
         }
     }
-    backup_ingredients_.push_back(ingredient);
+    return false;
+}
+
+/**
+ * Sets the backup ingredients stock with the provided list of ingredients.
+ * @param ingredients A vector of Ingredient objects to set as the backup
+stock.
+ * @pre None.
+ * @post The backup_ingredients_ vector is replaced with the provided
+ingredients.
+ * @return True if the ingredients were added; false otherwise.
+ */
+bool StationManager::addBackupIngredients(const std::vector<Ingredient>& ingredients)
+{
+    backup_ingredients_ = ingredients;
+    backup_ids_.clear();
+    for (const Ingredient& ingredient : backup_ingredients_)
+    {
+        backup_ids_.push_back(SymbolTable::intern(ingredient.name));
+    }
+    for (SymbolId ingredient_id : backup_ids_)
+    {
+        wakeParkedOrders(ingredient_id);
+    }
+    return true;
+}
+
+/**
+ * Adds a single ingredient to the backup ingredients stock.
+ * @param ingredient An Ingredient object to add to the backup stock.
+ * @pre None.
+ * @post If the ingredient already exists in the backup stock, its quantity
+is increased by the ingredient's quantity.
+ *       If the ingredient does not exist, it is added to the backup stock.
+ * @return True if the ingredient was added; false otherwise.
+ */
+bool StationManager::addBackupIngredient(const Ingredient& ingredient)
+{
+    wakeParkedOrders(stockBackup(ingredient));
     return true;
 }
 
+// Adds to backup stock without waking parked dishes
+SymbolId StationManager::stockBackup(const Ingredient& ingredient)
+{
+    SymbolId ingredient_id = SymbolTable::intern(ingredient.name);
+    int i = backupIndex(ingredient_id);
+    if (i >= 0)
+    {
+        backup_ingredients_[i].quantity = backup_ingredients_[i].quantity + ingredient.quantity;
+    }
+    else
+    {
+        backup_ingredients_.push_back(ingredient);
+        backup_ids_.push_back(ingredient_id);
+    }
+    return ingredient_id;
+}
+
 /**
  * Empties the backup ingredients vector
  * @post The backup_ingredients_ private member variable is empty.
@@ -386,6 +1106,99 @@ bool StationManager::addBackupIngredient(const Ingredient& ingredient)
 void StationManager::clearBackupIngredients()
 {
     backup_ingredients_.clear();
+    backup_ids_.clear();
+}
+
+// Returns the index of an ingredient in backup stock, or -1
+int StationManager::backupIndex(SymbolId ingredient_id) const
+{
+    for (size_t i = 0; i < backup_ids_.size(); i++)
+    {
+        if (backup_ids_[i] == ingredient_id)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Reserves backup stock for what the station is short of. No entry leaves
+// the store while any reservation is open (commits only note the ones they
+// used up), so every entry stays where it was reserved from until the last
+// reservation ends.
+bool StationManager::reserveBackupIngredients(KitchenStation* station, const Dish* dish, BackupReservation& reservation)
+{
+    const std::vector<Ingredient>& ingredients = dish->getIngredients();
+    const std::vector<SymbolId>& ingredient_ids = dish->getIngredientIds();
+    std::lock_guard<std::mutex> hold(backup_lock_);
+    for (size_t i = 0; i < ingredients.size(); i++)
+    {
+        int stocked = station->getStockQuantity(ingredient_ids[i]);
+        if (stocked >= ingredients[i].required_quantity && stocked >= ingredients[i].quantity)
+        {
+            continue;
+        }
+        int b = backupIndex(ingredient_ids[i]);
+        if (b >= 0 && backup_ingredients_[b].quantity >= ingredients[i].required_quantity
+            && std::find(used_up_backup_.begin(), used_up_backup_.end(), ingredient_ids[i]) == used_up_backup_.end())
+        {
+            backup_ingredients_[b].quantity -= ingredients[i].required_quantity;
+            reservation.ingredients.push_back(Ingredient{ingredients[i].name, ingredients[i].required_quantity, {}, {}});
+            reservation.ingredient_ids.push_back(ingredient_ids[i]);
+            reservation.backup_positions.push_back(b);
+        }
+    }
+    if (reservation.ingredients.empty())
+    {
+        return false;
+    }
+    open_backup_reservations_++;
+    return true;
+}
+
+void StationManager::commitBackupReservation(BackupReservation& reservation)
+{
+    std::lock_guard<std::mutex> hold(backup_lock_);
+    for (size_t i = 0; i < reservation.ingredients.size(); i++)
+    {
+        if (backup_ingredients_[reservation.backup_positions[i]].quantity <= 0)
+        {
+            used_up_backup_.push_back(reservation.ingredient_ids[i]);
+        }
+    }
+    endBackupReservation(reservation);
+}
+
+void StationManager::abortBackupReservation(BackupReservation& reservation)
+{
+    std::lock_guard<std::mutex> hold(backup_lock_);
+    for (size_t i = 0; i < reservation.ingredients.size(); i++)
+    {
+        backup_ingredients_[reservation.backup_positions[i]].quantity += reservation.ingredients[i].quantity;
+    }
+    endBackupReservation(reservation);
+}
+
+// @pre backup_lock_ is held. Once no reservation is open, the entries
+// commits used up leave the store
+void StationManager::endBackupReservation(BackupReservation& reservation)
+{
+    if (!reservation.ingredients.empty() && --open_backup_reservations_ == 0)
+    {
+        for (SymbolId ingredient_id : used_up_backup_)
+        {
+            int b = backupIndex(ingredient_id);
+            if (b >= 0 && backup_ingredients_[b].quantity <= 0)
+            {
+                backup_ingredients_.erase(backup_ingredients_.begin() + b);
+                backup_ids_.erase(backup_ids_.begin() + b);
+            }
+        }
+        used_up_backup_.clear();
+    }
+    reservation.ingredients.clear();
+    reservation.ingredient_ids.clear();
+    reservation.backup_positions.clear();
 }
 
 // PREPARING DISH: Spaghetti Bolognese
@@ -426,6 +1239,16 @@ void StationManager::clearBackupIngredients()
 // Beef Wellington was not prepared.
 // All dishes have been processed.
 
+/**
+ * Chooses how processAllDishes traces stations that cannot make a dish.
+ * @param verbose True to reproduce the full trace for skipped stations.
+ * @post: Later calls to processAllDishes use the chosen trace.
+ */
+void StationManager::setVerboseRouting(bool verbose)
+{
+    verbose_routing_ = verbose;
+}
+
 /**
  * Processes all dishes in the queue and displays detailed results.
  * @pre: None.
@@ -439,108 +1262,692 @@ in the same order
 */
 void StationManager::processAllDishes()
 {
-    int initial_queue_size = dish_queue_.size();
+    // Dishes added while the queue is processed wait for the next call
+    std::lock_guard<std::mutex> pass(pass_lock_);
+    size_t initial_queue_size = 0;
+    {
+        std::lock_guard<std::mutex> hold(routing_lock_);
+        wakeDueOrders();
+        if (worker_threads_ > 1 && routing_mode_ != POLICY)
+        {
+            // the station groups hold for the whole pass, and so does the lock
+            processAllDishesInParallel();
+            return;
+        }
+        initial_queue_size = countWaitingOrders();
+    }
 
-    // Iterates through dish queues
-    for (int i = 0; i < initial_queue_size; i++)
-    {        
-        Dish* dish = dish_queue_.front();
+    // Iterates through dish queues; dishes that fail go back once the pass is
+    // over, so a heap discipline does not hand the same dish out twice. The
+    // routing lock is taken per dish, so roster changes from other threads
+    // wait for one dish, not for the pass.
+    std::vector<KitchenStation*> roster;
+    QueuedOrder order;
+    unprepared_orders_.clear();
+    for (size_t i = 0; i < initial_queue_size; i++)
+    {
+        std::lock_guard<std::mutex> hold(routing_lock_);
+        if (!takeOrder(order, false))
+        {
+            break;
+        }
+        // The verbose walk follows the roster as it is now
+        if (verbose_routing_)
+        {
+            roster.assign(begin(), end());
+        }
+
+        Dish* dish = order.dish;
         std::cout << "PREPARING DISH: " << dish->getName() << std::endl;
+        countDemand(dish, -1);
+
+        // Stations the dish is assigned to, in the order they are tried
+        std::vector<RouteCandidate> no_candidates;
+        std::vector<RouteCandidate>* routes = routesFor(dish->getNameId());
+        std::vector<RouteCandidate>& assigned = routes != nullptr ? *routes : no_candidates;
+        if (!verbose_routing_)
+        {
+            orderCandidates(dish, assigned);
+        }
 
-        bool prepared_dishes = false;
+        DishProgress progress{0, false};
+        DishOutcome outcome = routeQueuedDish(dish, assigned, roster, progress, true, std::cout, routing_stats_);
 
-        // Iterates through stations
-        for (int j = 0; j < getLength(); j++)
+        // How many of the leading candidates were tried; the verbose walk
+        // follows the roster, so any of them may have been
+        bool prepared_dishes = outcome == DISH_PREPARED;
+        rankCandidates(assigned, verbose_routing_ || !prepared_dishes ? assigned.size() : progress.position + 1);
+
+        if (prepared_dishes)
+        {
+            releaseDishSlot();
+        }
+        // If dish was not prepared even after replenishing
+        else
+        {
+            if (retry_parking_)
+            {
+                findMissingIngredients(dish, missing_scratch_);
+            }
+            if (!retry_parking_ || !parkOrder(order, missing_scratch_))
+            {
+                unprepared_orders_.push_back(order);
+            }
+            routing_stats_.queue_failures++;
+            std::cout << dish->getName() << " was not prepared." << std::endl;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> hold(routing_lock_);
+        for (const QueuedOrder& unprepared : unprepared_orders_)
+        {
+            requeueOrder(unprepared);
+        }
+    }
+    // Final indicator of code completion
+    std::cout << "All dishes have been processed." << std::endl;
+}
+
+// Walks the stations for one dish, from where progress left off
+StationManager::DishOutcome StationManager::routeQueuedDish(Dish* dish, std::vector<RouteCandidate>& assigned,
+                                                            const std::vector<KitchenStation*>& roster,
+                                                            DishProgress& progress, bool backup_ready,
+                                                            std::ostream& out, RoutingStats& stats)
+{
+    // Iterates through all stations, tracing the ones without the dish, or
+    // through the stations the dish is assigned to
+    size_t stations = verbose_routing_ ? roster.size() : assigned.size();
+    for (; progress.position < stations; progress.position++, progress.stock_tried = false)
+    {
+        RouteCandidate* candidate = nullptr;
+        if (verbose_routing_)
         {
-            KitchenStation* station = getEntry(j);
+            KitchenStation* station = roster[progress.position];
+            auto listed = std::find_if(assigned.begin(), assigned.end(),
+                                       [station](const RouteCandidate& entry) { return entry.station == station; });
+            // If dish is not assigned to a station print
+            if (listed == assigned.end())
+            {
+                out << station->getName() << " attempting to prepare " << dish->getName() << "..." << std::endl;
+                out << station->getName() << ": Dish not available. Moving to next station..." << std::endl;
+                continue;
+            }
+            candidate = &*listed;
+        }
+        else
+        {
+            candidate = &assigned[progress.position];
+        }
 
-            std::cout << station->getName() << " attempting to prepare " << dish->getName() << "..." << std::endl;
-            
-            // Assigned dish checker
-            bool assigned_dishes = false;
-            for (int k = 0; k < station->getDishes().size(); k++)
+        if (!progress.stock_tried)
+        {
+            if (prepareFromStock(*candidate, dish, out, stats))
             {
-                if (station->getDishes()[k]->getName() == dish->getName())
+                return DISH_PREPARED;
+            }
+            progress.stock_tried = true;
+        }
+        if (!backup_ready)
+        {
+            return DISH_NEEDS_BACKUP;
+        }
+        if (prepareWithBackup(*candidate, dish, out, stats))
+        {
+            return DISH_PREPARED;
+        }
+    }
+    return DISH_FAILED;
+}
+
+// Traces one station's attempt at a dish assigned to it, from stock
+bool StationManager::prepareFromStock(RouteCandidate& candidate, Dish* dish, std::ostream& out, RoutingStats& stats)
+{
+    KitchenStation* station = candidate.station;
+    out << station->getName() << " attempting to prepare " << dish->getName() << "..." << std::endl;
+
+    // If dish is assigned and can be prepared, output prepared
+    bool from_stock = station->tryConsume(dish->getNameId()).status == KitchenStation::PREPARED;
+    // a station that needs the backup counts as a miss even if it then succeeds
+    recordProbe(candidate, from_stock, stats);
+    if (from_stock)
+    {
+        scheduleDish(station, dish, stats);
+        out << station->getName() << ": Successfully prepared " << dish->getName() << "." << std::endl;
+    }
+    return from_stock;
+}
+
+// Traces the same station's retry after topping it up from backup. The top-up
+// is one transaction: if the dish still cannot be made, what was drawn goes
+// back to the backup store instead of sitting at the station.
+bool StationManager::prepareWithBackup(RouteCandidate& candidate, Dish* dish, std::ostream& out, RoutingStats& stats)
+{
+    KitchenStation* station = candidate.station;
+
+    // If dish is assigned and cannot be prepared, so replenishing from backup once
+    // (moving stock around here wakes no parked dish)
+    out << station->getName() << ": Insufficient ingredients. Replenishing ingredients..." << std::endl;
+
+    // The dish's own ingredients count as backup supplies
+    for (const Ingredient& ingredient : dish->getIngredients())
+    {
+        stockBackup(ingredient);
+    }
+
+    // Reserving what the station lacks, then preparing with it, or giving it
+    // back (dishes reach this one at a time)
+    BackupReservation& reservation = backup_scratch_;
+    bool prepared = reserveBackupIngredients(station, dish, reservation)
+                    && station->tryConsume(dish->getNameId(), reservation.ingredients, reservation.ingredient_ids).status
+                           == KitchenStation::PREPARED;
+    if (prepared)
+    {
+        stats.backup_draws += reservation.ingredients.size();
+        commitBackupReservation(reservation);
+        scheduleDish(station, dish, stats);
+        out << station->getName() << ": Ingredients replenished." << std::endl;
+
+        out << station->getName() << ": Successfully prepared " << dish->getName() << "." << std::endl;
+        return true;
+    }
+    abortBackupReservation(reservation);
+    // If dishes are not replenished, output failed to prepare
+    out << station->getName() << ": Unable to replenish ingredients. Failed to prepare " << dish->getName() << "." << std::endl;
+    return false;
+}
+
+// Sets how many worker threads processAllDishes uses
+void StationManager::setWorkerThreads(int threads)
+{
+    std::lock_guard<std::mutex> hold(routing_lock_);
+    worker_threads_ = threads > 1 ? threads : 1;
+    worker_pool_.resize(worker_threads_ - 1);
+}
+
+int StationManager::getWorkerThreads() const
+{
+    return worker_threads_;
+}
+
+// Turns retry parking on or off, with the roster's stations reporting
+// restocks only while it is on
+void StationManager::setRetryParking(bool parking)
+{
+    if (parking == retry_parking_)
+    {
+        return;
+    }
+    for (KitchenStation* station : *this)
+    {
+        station->setStockListener(parking ? this : nullptr);
+    }
+    retry_parking_ = parking;
+    if (!parking)
+    {
+        wakeAllParkedOrders();
+    }
+}
+
+bool StationManager::getRetryParking() const
+{
+    return retry_parking_;
+}
+
+void StationManager::setRetryBackoff(long minutes)
+{
+    retry_backoff_ = minutes > 0 ? minutes : 0;
+}
+
+long StationManager::getRetryBackoff() const
+{
+    return retry_backoff_;
+}
+
+size_t StationManager::getParkedDishCount() const
+{
+    std::lock_guard<std::mutex> hold(parked_lock_);
+    return parked_orders_.size();
+}
+
+// Lists the ingredients the dish's stations are short of, once each; stock
+// of any of them may be what lets the dish through
+void StationManager::findMissingIngredients(const Dish* dish, std::vector<SymbolId>& missing)
+{
+    SymbolId dish_id = dish->getNameId();
+    std::vector<RouteCandidate>* routes = routesFor(dish_id);
+    missing.clear();
+    for (size_t i = 0; routes != nullptr && i < routes->size(); i++)
+    {
+        (*routes)[i].station->appendMissingIngredients(dish_id, missing);
+    }
+    std::sort(missing.begin(), missing.end());
+    missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+}
+
+// Parks an order under every ingredient it is missing
+bool StationManager::parkOrder(const QueuedOrder& order, const std::vector<SymbolId>& missing)
+{
+    if (missing.empty())
+    {
+        return false;
+    }
+    // a parked dish still holds its slot and counts in the demand
+    countDemand(order.dish, 1);
+    std::lock_guard<std::mutex> hold(parked_lock_);
+    unsigned long ticket = next_ticket_++;
+    ParkedOrder parked{order, std::numeric_limits<long>::max()};
+    parked.order.parks++;
+    if (retry_backoff_ > 0)
+    {
+        parked.wake_at = simulated_time_ + (retry_backoff_ << std::min(parked.order.parks - 1, 6));
+        parked_by_time_.add(std::make_pair(parked.wake_at, ticket));
+    }
+    parked_orders_.emplace(ticket, parked);
+    for (SymbolId ingredient_id : missing)
+    {
+        std::vector<unsigned long>& waiting = parked_by_ingredient_[ingredient_id];
+        if (waiting.size() > 2 * parked_orders_.size())
+        {
+            // most of the list was woken by the clock: drop those tickets
+            waiting.erase(std::remove_if(waiting.begin(), waiting.end(),
+                                         [this](unsigned long listed) { return parked_orders_.count(listed) == 0; }),
+                          waiting.end());
+        }
+        waiting.push_back(ticket);
+    }
+    return true;
+}
+
+// Puts the orders parked on a restocked ingredient back in the queue
+void StationManager::wakeParkedOrders(SymbolId ingredient_id)
+{
+    if (!retry_parking_)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> hold(parked_lock_);
+    auto found = parked_by_ingredient_.find(ingredient_id);
+    if (found == parked_by_ingredient_.end())
+    {
+        return;
+    }
+    std::vector<unsigned long> waiting = std::move(found->second);
+    parked_by_ingredient_.erase(found);
+    for (unsigned long ticket : waiting)
+    {
+        unparkOrder(ticket);
+    }
+}
+
+// Puts the orders whose backoff is over back in the queue
+void StationManager::wakeDueOrders()
+{
+    if (retry_backoff_ == 0)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> hold(parked_lock_);
+    while (!parked_by_time_.isEmpty() && parked_by_time_.peekTop().first <= simulated_time_)
+    {
+        unsigned long ticket = parked_by_time_.peekTop().second;
+        parked_by_time_.remove();
+        unparkOrder(ticket);
+    }
+}
+
+// Puts every parked order back in the queue, in the order they were parked
+void StationManager::wakeAllParkedOrders()
+{
+    {
+        std::lock_guard<std::mutex> hold(parked_lock_);
+        while (!parked_orders_.empty())
+        {
+            unparkOrder(parked_orders_.begin()->first);
+        }
+        dropParkedOrders();
+    }
+}
+
+// @pre parked_lock_ is held. The order still holds its slot, so the push
+// only waits on a consumer a lap ahead
+void StationManager::unparkOrder(unsigned long ticket)
+{
+    auto found = parked_orders_.find(ticket);
+    if (found == parked_orders_.end())
+    {
+        return;
+    }
+    while (!dish_queue_.tryPush(found->second.order))
+    {
+        std::this_thread::yield();
+    }
+    parked_orders_.erase(found);
+}
+
+// @pre parked_lock_ is held
+void StationManager::dropParkedOrders()
+{
+    parked_orders_.clear();
+    parked_by_ingredient_.clear();
+    parked_by_time_.clear();
+}
+
+void StationManager::stockAdded(KitchenStation&, SymbolId ingredient_id)
+{
+    wakeParkedOrders(ingredient_id);
+}
+
+// processAllDishes on worker_threads_ threads: the caller and the pool.
+// Stations are grouped so that no dish spans two groups; a group's dishes are
+// worked in queue order by one worker at a time, which makes the stock each
+// dish sees the same as in the serial run. The backup store is shared, so a
+// dish that needs it stops, and its group is parked, until every dish queued
+// before it is done; meanwhile its worker takes other groups, or sleeps until
+// a dish is done. Each worker writes its traces into its own buffer, noting
+// which span belongs to which dish, and the spans are printed in queue order
+// at the end. Nothing is kept if std::cout would print nothing.
+void StationManager::processAllDishesInParallel()
+{
+    std::vector<QueuedOrder> orders;
+    std::vector<Dish*> dishes;
+    QueuedOrder taken;
+    for (size_t n = countWaitingOrders(); dishes.size() < n && takeOrder(taken, false);)
+    {
+        orders.push_back(taken);
+        dishes.push_back(taken.dish);
+        countDemand(taken.dish, -1);
+    }
+    std::vector<KitchenStation*> roster(begin(), end());
+
+    // Union-find over roster positions: stations sharing a dish
+    std::unordered_map<KitchenStation*, int> position;
+    for (KitchenStation* station : roster)
+    {
+        position.emplace(station, static_cast<int>(position.size()));
+    }
+    std::vector<int> parent(roster.size());
+    for (size_t i = 0; i < parent.size(); i++)
+    {
+        parent[i] = static_cast<int>(i);
+    }
+    auto root = [&parent](int i) {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    auto join = [&](KitchenStation* a, KitchenStation* b) {
+        parent[root(position[a])] = root(position[b]);
+    };
+    for (auto& listed : dish_index_)
+    {
+        for (const RouteCandidate& candidate : listed.second)
+        {
+            join(candidate.station, listed.second.front().station);
+        }
+    }
+
+    // One trace buffer per worker, kept from pass to pass so its storage is
+    // reused. A dish's trace is one span of a buffer, or several if it
+    // stopped for the backup store and went on later, maybe on another worker.
+    int workers = worker_pool_.size() + 1;
+    while (trace_buffers_.size() < static_cast<size_t>(workers))
+    {
+        trace_buffers_.emplace_back(new TraceBuffer);
+    }
+    bool keep_trace = std::cout.good();
+    struct TraceSpan {
+        size_t dish;
+        int piece;  // which piece of the dish's trace, from 0
+        int worker;
+        size_t begin;
+        size_t end;
+    };
+    std::vector<TraceSpan> first_spans(dishes.size(), TraceSpan{0, 0, 0, 0, 0});
+    std::vector<int> pieces(dishes.size(), 0);
+    std::vector<std::vector<TraceSpan>> later_spans(workers);
+    for (int w = 0; w < workers; w++)
+    {
+        trace_buffers_[w]->text.clear();
+        trace_buffers_[w]->mark = 0;
+    }
+
+    // Notes that what worker w wrote since its last note belongs to dish i
+    auto noteTrace = [&](size_t i, int w) {
+        TraceBuffer& buffer = *trace_buffers_[w];
+        TraceSpan span{i, pieces[i], w, buffer.mark, buffer.text.size()};
+        buffer.mark = span.end;
+        if (span.begin == span.end)
+        {
+            return;
+        }
+        if (pieces[i]++ == 0)
+        {
+            first_spans[i] = span;
+        }
+        else
+        {
+            later_spans[w].push_back(span);
+        }
+    };
+
+    // A group's dishes, in queue order, and how far its worker got
+    struct Group {
+        std::vector<size_t> dishes;
+        size_t next;
+        DishProgress progress;
+    };
+    std::vector<Group> groups;
+    std::vector<size_t> group_of_root(roster.size(), SIZE_MAX);  // by roster position
+    std::vector<char> prepared(dishes.size(), 0);
+    // what each failed dish's stations lacked when it failed, if parking
+    std::vector<std::vector<SymbolId>> missing(retry_parking_ ? dishes.size() : 0);
+    std::unique_ptr<std::atomic<bool>[]> done(new std::atomic<bool>[dishes.size()]);
+    {
+        std::ostream out(keep_trace ? trace_buffers_[0].get() : nullptr);
+        for (size_t i = 0; i < dishes.size(); i++)
+        {
+            done[i].store(false, std::memory_order_relaxed);
+            std::vector<RouteCandidate>* routes = routesFor(dishes[i]->getNameId());
+            if (routes == nullptr || routes->empty())
+            {
+                // no station to cook it: only the trace to write
+                std::vector<RouteCandidate> no_candidates;
+                DishProgress progress{0, false};
+                out << "PREPARING DISH: " << dishes[i]->getName() << std::endl;
+                routeQueuedDish(dishes[i], no_candidates, roster, progress, true, out, routing_stats_);
+                out << dishes[i]->getName() << " was not prepared." << std::endl;
+                routing_stats_.queue_failures++;
+                noteTrace(i, 0);
+                done[i].store(true, std::memory_order_relaxed);
+                continue;
+            }
+            size_t& group = group_of_root[root(position[routes->front().station])];
+            if (group == SIZE_MAX)
+            {
+                group = groups.size();
+                groups.push_back(Group{{}, 0, DishProgress{0, false}});
+            }
+            groups[group].dishes.push_back(i);
+        }
+    }
+
+    // Scheduler state: groups are claimed in order of their first dish, so
+    // the earliest unfinished dish is always being worked on or claimable
+    std::mutex schedule_lock;
+    std::condition_variable dish_done;  // signalled while workers sleep
+    std::atomic<int> sleepers(0);
+    std::mutex backup_lock;
+    size_t next_group = 0;
+    size_t finished_groups = 0;
+    size_t frontier = 0;  // every dish before it is done
+    std::vector<size_t> parked;
+
+    // @pre schedule_lock is held
+    auto advanceFrontier = [&]() {
+        while (frontier < dishes.size() && done[frontier].load())
+        {
+            frontier++;
+        }
+    };
+
+    // Marks dish i done, waking sleeping workers: a parked group may be
+    // ready now. A worker counts itself a sleeper before it looks at the
+    // frontier, so either it sees the dish done or this sees it asleep.
+    auto finishDish = [&](size_t i) {
+        done[i].store(true);
+        if (sleepers.load() > 0)
+        {
+            std::lock_guard<std::mutex> hold(schedule_lock);
+            dish_done.notify_all();
+        }
+    };
+
+    // Works a group until it is finished (false) or parked (true)
+    auto runGroup = [&](Group& group, int w, std::ostream& out, RoutingStats& stats) {
+        for (; group.next < group.dishes.size(); group.next++)
+        {
+            size_t i = group.dishes[group.next];
+            Dish* dish = dishes[i];
+            std::vector<RouteCandidate>& assigned = *routesFor(dish->getNameId());
+            if (group.progress.position == 0 && !group.progress.stock_tried)
+            {
+                out << "PREPARING DISH: " << dish->getName() << std::endl;
+                if (!verbose_routing_)
                 {
-                    assigned_dishes = true;
-                    break;
+                    orderCandidates(dish, assigned);
                 }
             }
-
-            // If a dish is assigned to a station pursue preparation logic
-            if (assigned_dishes)
+            DishOutcome outcome = routeQueuedDish(dish, assigned, roster, group.progress, false, out, stats);
+            if (outcome == DISH_NEEDS_BACKUP)
+            {
+                bool ready;
+                {
+                    std::lock_guard<std::mutex> hold(schedule_lock);
+                    advanceFrontier();
+                    ready = frontier >= i;
+                }
+                if (!ready)
+                {
+                    noteTrace(i, w);
+                    return true;
+                }
+                std::lock_guard<std::mutex> hold(backup_lock);
+                outcome = routeQueuedDish(dish, assigned, roster, group.progress, true, out, stats);
+            }
+            prepared[i] = outcome == DISH_PREPARED;
+            rankCandidates(assigned, verbose_routing_ || !prepared[i] ? assigned.size() : group.progress.position + 1);
+            if (!prepared[i])
             {
-                // If dish is assigned and can be prepared, output prepared
-                if (station->canCompleteOrder(dish->getName()) && station->prepareDish(dish->getName()))
+                stats.queue_failures++;
+                out << dish->getName() << " was not prepared." << std::endl;
+                if (retry_parking_)
                 {
-                    std::cout << station->getName() << ": Successfully prepared " << dish->getName() << "." << std::endl;
-                    dish_queue_.pop();
+                    findMissingIngredients(dish, missing[i]);
+                }
+            }
+            noteTrace(i, w);
+            group.progress = DishProgress{0, false};
+            finishDish(i);
+        }
+        return false;
+    };
 
-                    prepared_dishes = true;
+    auto work = [&](int w) {
+        std::ostream out(keep_trace ? trace_buffers_[w].get() : nullptr);
+        RoutingStats stats{0, 0, 0, 0, 0, 0};
+        std::unique_lock<std::mutex> hold(schedule_lock);
+        while (finished_groups < groups.size())
+        {
+            advanceFrontier();
+            size_t picked = groups.size();
+            for (size_t k = 0; k < parked.size(); k++)
+            {
+                Group& group = groups[parked[k]];
+                if (frontier >= group.dishes[group.next])
+                {
+                    picked = parked[k];
+                    parked.erase(parked.begin() + k);
                     break;
                 }
-                else
+            }
+            if (picked == groups.size() && next_group < groups.size())
+            {
+                picked = next_group++;
+            }
+            if (picked == groups.size() && parked.empty())
+            {
+                // the rest is in other workers' hands
+                break;
+            }
+            if (picked == groups.size())
+            {
+                // every parked group waits on a dish another worker has
+                sleepers++;
+                size_t seen = frontier;
+                advanceFrontier();
+                if (frontier == seen)
                 {
-                    // If dish is assigned and cannot be prepared, so replenishing from backup once
-                    bool replenished_dishes = false;
-                    std::cout << station->getName() << ": Insufficient ingredients. Replenishing ingredients..." << std::endl;
-
-                    // Replenishing ingredients from backup
-                    for (int l = 0; l < dish->getIngredients().size(); l++)
-                    {
-                        Ingredient ingredient = dish->getIngredients()[l];
-
-                        StationManager::addBackupIngredient(ingredient);
-
-                        if (StationManager::replenishStationIngredientFromBackup(station->getName(), ingredient.name, ingredient.required_quantity))
-                        {                        
-                            replenished_dishes = true;
-                        }
-                    }
-
-                    // If dishes are replenished and can be prepared, output replenished and prepared
-                    if (replenished_dishes && station->canCompleteOrder(dish->getName()) && station->prepareDish(dish->getName()))
-                    {
-                        std::cout << station->getName() << ": Ingredients replenished." << std::endl;
-
-                        std::cout << station->getName() << ": Successfully prepared " << dish->getName() << "." << std::endl;
-                        dish_queue_.pop();
-
-                        prepared_dishes = true;
-                        break; 
-                    }
-                    // If dishes are not replenished, output failed to prepare
-                    else
-                    {
-                        std::cout << station->getName() << ": Unable to replenish ingredients. Failed to prepare " << dish->getName() << "." << std::endl;
-                    }
+                    dish_done.wait(hold);
                 }
+                sleepers--;
+                continue;
+            }
+            hold.unlock();
+            bool parks = runGroup(groups[picked], w, out, stats);
+            hold.lock();
+            if (parks)
+            {
+                parked.push_back(picked);
             }
-            // If dish is not assigned to a station print
             else
             {
-                std::cout << station->getName() << ": Dish not available. Moving to next station..." << std::endl;
+                finished_groups++;
             }
         }
-        // If dish was not prepared even after replenishing
-        if (!prepared_dishes)
+        routing_stats_.dishes_prepared += stats.dishes_prepared;
+        routing_stats_.failed_probes += stats.failed_probes;
+        routing_stats_.latest_finish = std::max(routing_stats_.latest_finish, stats.latest_finish);
+        routing_stats_.total_latency += stats.total_latency;
+        routing_stats_.backup_draws += stats.backup_draws;
+        routing_stats_.queue_failures += stats.queue_failures;
+    };
+    worker_pool_.run(work);
+
+    // Same trace and final queue as the serial run. Pieces after a dish's
+    // first are rare, so they are sorted into place here.
+    std::vector<TraceSpan> later;
+    for (const std::vector<TraceSpan>& spans : later_spans)
+    {
+        later.insert(later.end(), spans.begin(), spans.end());
+    }
+    std::sort(later.begin(), later.end(), [](const TraceSpan& a, const TraceSpan& b) {
+        return a.dish != b.dish ? a.dish < b.dish : a.piece < b.piece;
+    });
+    auto print = [this](const TraceSpan& span) {
+        std::cout.write(trace_buffers_[span.worker]->text.data() + span.begin, span.end - span.begin);
+    };
+    size_t next_later = 0;
+    for (size_t i = 0; i < dishes.size(); i++)
+    {
+        if (pieces[i] > 0)
         {
-            dish_queue_.pop();
-            dish_queue_.push(dish);
-            std::cout << dish->getName() << " was not prepared." << std::endl;
+            print(first_spans[i]);
+        }
+        for (; next_later < later.size() && later[next_later].dish == i; next_later++)
+        {
+            print(later[next_later]);
+        }
+        if (prepared[i])
+        {
+            releaseDishSlot();
+        }
+        else if (!retry_parking_ || !parkOrder(orders[i], missing[i]))
+        {
+            requeueOrder(orders[i]);
         }
     }
-    // Final indicator of code completion
     std::cout << "All dishes have been processed." << std::endl;
 }
-
-// std::cout << "PREPARING DISH: " << dish->getName() << std::endl;
-// std::cout << station->getName() << " attempting to prepare " << dish->getName() << "..." << std::endl;
-// std::cout << station->getName() << ": Successfully prepared " << dish->getName() << "." << std::endl;
-// std::cout << station->getName() << ": Insufficient ingredients. Replenishing ingredients..." << std::endl;;
-// std::cout << station->getName() << ": Ingredients replenished." << std::endl;
-// std::cout << station->getName() << ": Successfully prepared " << dish->getName() << "." << std::endl;
-// std::cout << station->getName() << ": Unable to replenish ingredients. Failed to prepare " << dish->getName() << "." << std::endl;                    
-// std::cout << station->getName() << ": Dish not available. Moving to next station..." << std::endl;
-// std::cout << dish->getName() << " was not prepared." << std::endl;
-// std::cout << "All dishes have been processed." << std::endl;
@@ -0,0 +1,160 @@
+/**
+ * @file SymbolTable.cpp
+ * @brief Implementation of the process-wide symbol table.
+ *
+ * @date December 1, 2024
+ * @author kufunei
+ */
+
+#include "SymbolTable.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Names are stored in fixed chunks that never move, so references handed out
+// by nameOf() survive later interning and readers need no lock to follow an
+// id to its name.
+const int CHUNK_BITS = 12;
+const int CHUNK_SIZE = 1 << CHUNK_BITS;
+const int MAX_CHUNKS = 4096;
+
+// Open-addressing index from name to id, probed linearly and kept at most a
+// quarter full, so that even unlucky names sit a few slots from home. A slot
+// holds 0 while empty, or the id + 1 in its low half and the top half of the
+// name's hash in its high half, so most probes that miss skip the string
+// compare. Slots are written once and never cleared.
+struct Index {
+    std::size_t mask;
+    std::vector<std::atomic<std::uint64_t>> slots;
+
+    explicit Index(std::size_t capacity) : mask(capacity - 1), slots(capacity) {}
+};
+
+// Built on first use, so objects with static storage may intern names too.
+// Lookups take no lock: they read the index last published, which only
+// intern() changes, under lock. When the index fills up, intern() publishes
+// a larger copy; the old ones are kept, since a lookup may still be reading
+// one, and a lookup that misses a name being added meanwhile ran before it.
+struct Table {
+    std::mutex lock;
+    std::atomic<Index*> index;
+    std::vector<std::unique_ptr<Index>> indexes;  // every index published
+    std::atomic<std::string*> chunks[MAX_CHUNKS];
+    std::atomic<int> count;
+
+    Table() : index(nullptr), count(0) {
+        for (std::atomic<std::string*>& chunk : chunks) {
+            chunk.store(nullptr, std::memory_order_relaxed);
+        }
+        indexes.emplace_back(new Index(1024));
+        index.store(indexes.back().get(), std::memory_order_release);
+    }
+
+    ~Table() {
+        for (std::atomic<std::string*>& chunk : chunks) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+};
+
+Table& table() {
+    static Table the_table;
+    return the_table;
+}
+
+std::uint64_t hashOf(const std::string& name) {
+    return static_cast<std::uint64_t>(std::hash<std::string>()(name));
+}
+
+const std::string& nameAt(const Table& symbols, SymbolId id) {
+    return symbols.chunks[id >> CHUNK_BITS].load(std::memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+}
+
+// The id of name in index, or NO_SYMBOL
+SymbolId lookup(const Table& symbols, const Index& index, const std::string& name, std::uint64_t hash) {
+    std::uint64_t tag = hash >> 32;
+    for (std::size_t slot = hash & index.mask;; slot = (slot + 1) & index.mask) {
+        std::uint64_t entry = index.slots[slot].load(std::memory_order_acquire);
+        if (entry == 0) {
+            return SymbolTable::NO_SYMBOL;
+        }
+        SymbolId id = static_cast<SymbolId>((entry & 0xFFFFFFFFu) - 1);
+        if ((entry >> 32) == tag && nameAt(symbols, id) == name) {
+            return id;
+        }
+    }
+}
+
+// Files id under hash in an index no one else writes to
+void place(Index& index, std::uint64_t hash, SymbolId id) {
+    std::size_t slot = hash & index.mask;
+    while (index.slots[slot].load(std::memory_order_relaxed) != 0) {
+        slot = (slot + 1) & index.mask;
+    }
+    index.slots[slot].store(((hash >> 32) << 32) | static_cast<std::uint64_t>(id + 1), std::memory_order_release);
+}
+
+}  // namespace
+
+// Interns a name, adding it on first sight
+SymbolId SymbolTable::intern(const std::string& name) {
+    SymbolId id = find(name);
+    if (id != NO_SYMBOL) {
+        return id;
+    }
+    Table& symbols = table();
+    std::lock_guard<std::mutex> hold(symbols.lock);
+    // another thread may have added it before we took the lock
+    std::uint64_t hash = hashOf(name);
+    Index* index = symbols.index.load(std::memory_order_relaxed);
+    id = lookup(symbols, *index, name, hash);
+    if (id != NO_SYMBOL) {
+        return id;
+    }
+
+    id = symbols.count.load(std::memory_order_relaxed);
+    if (id >= CHUNK_SIZE * MAX_CHUNKS) {
+        throw std::length_error("SymbolTable: too many names");
+    }
+    std::string* chunk = symbols.chunks[id >> CHUNK_BITS].load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+        chunk = new std::string[CHUNK_SIZE];
+        symbols.chunks[id >> CHUNK_BITS].store(chunk, std::memory_order_release);
+    }
+    chunk[id & (CHUNK_SIZE - 1)] = name;
+
+    if (4 * static_cast<std::size_t>(id + 1) > index->slots.size()) {
+        symbols.indexes.emplace_back(new Index(2 * index->slots.size()));
+        index = symbols.indexes.back().get();
+        for (SymbolId known = 0; known < id; known++) {
+            place(*index, hashOf(nameAt(symbols, known)), known);
+        }
+    }
+    place(*index, hash, id);
+    symbols.index.store(index, std::memory_order_release);
+    symbols.count.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+// Looks a name up without adding it
+SymbolId SymbolTable::find(const std::string& name) {
+    const Table& symbols = table();
+    return lookup(symbols, *symbols.index.load(std::memory_order_acquire), name, hashOf(name));
+}
+
+// Returns the name behind an id
+const std::string& SymbolTable::nameOf(SymbolId id) {
+    return nameAt(table(), id);
+}
+
+// Returns the number of names interned so far
+int SymbolTable::size() {
+    return table().count.load(std::memory_order_acquire);
+}
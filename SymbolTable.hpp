@@ -0,0 +1,58 @@
+/**
+ * @file SymbolTable.hpp
+ * @brief Process-wide interning of names into dense integer ids.
+ *
+ * Dishes, stations and the ingredient lists they hold intern their names
+ * when the names are set, and compare ids from then on, so a name
+ * comparison is an integer compare. Ids start at 0 and are handed out in
+ * order, so they can index arrays. An id is never reused; the table only
+ * grows. find(), nameOf() and size() take no lock, so the string adapters
+ * stay cheap; intern() takes one only to add a name it has not seen.
+ *
+ * @date December 1, 2024
+ * @author kufunei
+ */
+
+#ifndef SYMBOLTABLE_HPP
+#define SYMBOLTABLE_HPP
+
+#include <string>
+
+// An interned name. Two names are equal exactly when their ids are.
+typedef int SymbolId;
+
+class SymbolTable {
+public:
+    // Id returned by find() for a name that was never interned.
+    static const SymbolId NO_SYMBOL = -1;
+
+    /**
+     * Interns a name.
+     * @param name Any string.
+     * @post: name has an id, which stays the same for the rest of the run.
+     * @return: The id of name.
+     */
+    static SymbolId intern(const std::string& name);
+
+    /**
+     * Looks a name up without interning it, for string adapters that only
+     * need to know whether anything carries the name.
+     * @param name Any string.
+     * @return: The id of name, or NO_SYMBOL if it was never interned.
+     */
+    static SymbolId find(const std::string& name);
+
+    /**
+     * @param id An id returned by intern().
+     * @return: The name interned as id. The reference stays valid for the
+     *          rest of the run.
+     */
+    static const std::string& nameOf(SymbolId id);
+
+    /**
+     * @return: The number of names interned so far; every id is below it.
+     */
+    static int size();
+};
+
+#endif // SYMBOLTABLE_HPP
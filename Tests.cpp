@@ -0,0 +1,2177 @@
+/**
+ * @file Tests.cpp
+ * @brief Tests for the bistro data structures and StationManager. Built and
+ * run by `make test`.
+ *
+ * The concurrent cases only prove much under a sanitizer, so run them that
+ * way too after touching the threaded paths:
+ *   make clean && make test SANITIZE=thread
+ *   make clean && make test SANITIZE=address,undefined
+ *
+ * Usage: tests [--filter TEXT]
+ *   --filter TEXT  runs only the tests whose name contains TEXT
+ */
+
+#include "Appetizer.hpp"
+#include "BinaryHeap.hpp"
+#include "ConcurrentList.hpp"
+#include "FlatHashMap.hpp"
+#include "IntrusiveList.hpp"
+#include "KitchenStation.hpp"
+#include "LinkedList.hpp"
+#include "MpmcQueue.hpp"
+#include "NodePool.hpp"
+#include "RoutingPolicy.hpp"
+#include "StationManager.hpp"
+#include "SymbolTable.hpp"
+#include "UnrolledLinkedList.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+int g_test_failures = 0;
+std::string g_filter;
+
+// Records a failed check and goes on, so one run reports every failure.
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::printf("    failed: %s\n", what.c_str());
+        g_test_failures++;
+    }
+}
+
+// Runs the test `name` unless the filter excludes it, and reports it.
+template <class Case>
+void run(const std::string& name, Case test_case) {
+    if (name.find(g_filter) == std::string::npos) {
+        return;
+    }
+    g_test_failures = 0;
+    test_case();
+    std::printf("%-50s %s\n", name.c_str(), g_test_failures == 0 ? "ok" : "FAILED");
+    std::fflush(stdout);
+    g_failures += g_test_failures;
+}
+
+// Sends std::cout to a string for as long as it lives: routing traces every
+// dish, and the tests compare or discard those traces.
+class CaptureCout {
+public:
+    CaptureCout() : old_(std::cout.rdbuf(text_.rdbuf())) {}
+    ~CaptureCout() { std::cout.rdbuf(old_); }
+    std::string text() const { return text_.str(); }
+    void clear() { text_.str(""); }
+
+private:
+    std::ostringstream text_;
+    std::streambuf* old_;
+};
+
+// "a", "b", ..., "z", "ba", ...: dish names may hold letters and spaces only
+std::string letterId(int i) {
+    std::string id;
+    do {
+        id.insert(id.begin(), char('a' + i % 26));
+        i /= 26;
+    } while (i > 0);
+    return id;
+}
+
+// A dish a station can make once it stocks the ingredients; with none, any
+// station that has it can.
+Dish* newAppetizer(const std::string& name, const std::vector<Ingredient>& ingredients, int prep_time = 1) {
+    return new Appetizer(name, ingredients, prep_time, 1.0, Dish::OTHER, Appetizer::PLATED, 1, false);
+}
+
+// The entries of a positional list, front to back.
+template <class List>
+std::vector<int> entriesOf(const List& list) {
+    std::vector<int> entries;
+    for (int i = 0; i < list.getLength(); i++) {
+        entries.push_back(list.getEntry(i));
+    }
+    return entries;
+}
+
+// Inserts and removes at the head, in the middle and at the tail, and checks
+// the list against the same edits on a vector.
+template <class List>
+void checkInsertRemove() {
+    List list;
+    std::vector<int> model;
+    for (int i = 0; i < 8; i++) {
+        list.insert(list.getLength(), i);
+        model.push_back(i);
+    }
+    const int inserts[][2] = {{0, 100}, {4, 101}, {10, 102}, {0, 103}, {6, 104}, {12, 105}};
+    for (const auto& edit : inserts) {
+        check(list.insert(edit[0], edit[1]), "insert at " + std::to_string(edit[0]));
+        model.insert(model.begin() + edit[0], edit[1]);
+    }
+    check(entriesOf(list) == model, "inserts at the head, middle and tail");
+    check(!list.insert(list.getLength() + 1, 0) && !list.insert(-1, 0), "inserts past either end are refused");
+
+    const int removes[] = {0, 5, 11, 0, 3, 8};
+    for (int position : removes) {
+        check(list.remove(position), "remove at " + std::to_string(position));
+        model.erase(model.begin() + position);
+    }
+    check(entriesOf(list) == model, "removes at the head, middle and tail");
+    check(!list.remove(list.getLength()) && !list.remove(-1), "removes past either end are refused");
+
+    list.insert(list.getLength(), 200);
+    model.push_back(200);
+    check(entriesOf(list) == model, "an append after removing the tail");
+    while (!list.isEmpty()) {
+        list.remove(list.getLength() - 1);
+    }
+    list.insert(0, 300);
+    list.insert(1, 301);
+    check(entriesOf(list) == std::vector<int>({300, 301}), "an emptied list takes new entries");
+}
+
+// Reads by position through the cursor while entries go in and out before
+// it, at it and after it.
+template <class List>
+void checkCursorFollowsEdits() {
+    List list;
+    std::vector<int> model;
+    for (int i = 0; i < 20; i++) {
+        list.insert(i, i);
+        model.push_back(i);
+    }
+    bool same = true;
+    for (int round = 0; round < 40; round++) {
+        int at = (round * 7) % list.getLength();
+        same = same && list.getEntry(at) == model[at];  // leaves the cursor at `at`
+        int edit = (round * 5) % list.getLength();
+        if (round % 2 == 0) {
+            list.insert(edit, 1000 + round);
+            model.insert(model.begin() + edit, 1000 + round);
+        } else {
+            list.remove(edit);
+            model.erase(model.begin() + edit);
+        }
+        for (int i = 0; i < list.getLength(); i++) {
+            same = same && list.getEntry(i) == model[i];
+        }
+    }
+    check(same, "every read after an edit finds the entry the model has there");
+}
+
+// Moves, swaps and moves-to-front that touch the head, the middle and the
+// last entry, each followed by an append, checked against a vector.
+template <class List>
+void checkRelinks() {
+    List list;
+    std::vector<int> model;
+    for (int i = 0; i < 10; i++) {
+        list.insert(i, i);
+        model.push_back(i);
+    }
+    bool same = true;
+    int next = 100;
+    for (int round = 0; round < 60; round++) {
+        int length = list.getLength();
+        int a = (round * 7) % length;
+        int b = round % 3 == 0 ? length - 1 : (round * 3 + 1) % length;
+        switch (round % 4) {
+        case 0:
+            list.moveToFront(b);
+            model.insert(model.begin(), model[b]);
+            model.erase(model.begin() + b + 1);
+            break;
+        case 1:
+            if (list.moveAfter(a, b)) {
+                int entry = model[a];
+                int target = model[b];
+                model.erase(model.begin() + a);
+                model.insert(std::find(model.begin(), model.end(), target) + 1, entry);
+            }
+            break;
+        case 2:
+            list.swapEntries(a, b);
+            std::swap(model[a], model[b]);
+            break;
+        default: {
+            int wanted = model[b];
+            int found = list.moveToFrontIf([wanted](int entry) { return entry == wanted; });
+            same = same && found == b;
+            model.erase(model.begin() + b);
+            model.insert(model.begin(), wanted);
+        }
+        }
+        same = same && entriesOf(list) == model;
+        if (round % 2 == 0) {
+            list.insert(list.getLength(), next);
+        } else {
+            list.pushBack(next);
+        }
+        model.push_back(next++);
+        same = same && entriesOf(list) == model;
+        if (round % 5 == 4) {
+            list.remove(0);
+            model.erase(model.begin());
+        }
+    }
+    check(same, "every relink and the append after it match the model");
+    check(list.moveToFrontIf([](int entry) { return entry < 0; }) == -1, "moveToFrontIf without a match");
+    check(!list.moveToFront(list.getLength()) && !list.swapEntries(0, list.getLength()), "positions past the end");
+}
+
+// Range inserts at the head, in the middle and at the tail, appends of whole
+// lists, and swaps, each followed by a pushBack that must land after the
+// last entry.
+template <class List>
+void checkBulkEdits() {
+    List list;
+    std::vector<int> model;
+    const std::vector<int> range = {1, 2, 3, 4, 5};
+    const int places[] = {0, 0, 3, 8, 20};
+    for (int at : places) {
+        at = std::min(at, list.getLength());
+        check(list.insert(at, range.begin(), range.end()), "range insert at " + std::to_string(at));
+        model.insert(model.begin() + at, range.begin(), range.end());
+        list.pushBack(at);
+        model.push_back(at);
+    }
+    check(list.insert(2, {40, 41}) && list.insert(list.getLength(), {42}), "braced inserts");
+    model.insert(model.begin() + 2, {40, 41});
+    model.push_back(42);
+    check(!list.insert(list.getLength() + 1, range.begin(), range.end()), "a range insert past the end is refused");
+    check(entriesOf(list) == model, "range inserts and pushBacks");
+
+    List other;
+    for (int i = 0; i < 7; i++) {
+        other.pushBack(100 + i);
+        model.push_back(100 + i);
+    }
+    list.append(std::move(other));
+    list.pushBack(200);
+    model.push_back(200);
+    check(entriesOf(list) == model && other.isEmpty(), "an append moves the other list's entries");
+    other.pushBack(300);
+    check(entriesOf(other) == std::vector<int>({300}), "the emptied list takes new entries");
+    list.append(List());
+    List empty;
+    empty.append(std::move(other));
+    empty.pushBack(301);
+    check(entriesOf(empty) == std::vector<int>({300, 301}), "appends to and from empty lists");
+
+    list.swap(empty);
+    list.pushBack(302);
+    empty.pushBack(201);
+    model.push_back(201);
+    check(entriesOf(list) == std::vector<int>({300, 301, 302}) && entriesOf(empty) == model,
+          "swapped lists append after their own last entry");
+}
+
+// An IntrusiveList of int entries it owns, shaped like LinkedList<int> so
+// the list tests above run on it too. Removed entries stay owned until the
+// adapter goes away.
+class IntrusiveInts {
+public:
+    bool isEmpty() const { return list_.isEmpty(); }
+    int getLength() const { return list_.getLength(); }
+    int getEntry(int position) const { return list_.getEntry(position)->value; }
+    int getEntry(int position) { return list_.getEntry(position)->value; }
+    bool insert(int position, int value) { return list_.insert(position, make(value)); }
+    bool pushBack(int value) { return list_.pushBack(make(value)); }
+    template <class InputIterator>
+    bool insert(int position, InputIterator first, InputIterator last) {
+        std::vector<Item*> entries;
+        for (; first != last; ++first) {
+            entries.push_back(make(*first));
+        }
+        return list_.insert(position, entries.begin(), entries.end());
+    }
+    bool insert(int position, std::initializer_list<int> values) {
+        return insert(position, values.begin(), values.end());
+    }
+    void append(IntrusiveInts&& other) {
+        std::move(other.items_.begin(), other.items_.end(), std::back_inserter(items_));
+        other.items_.clear();
+        list_.append(std::move(other.list_));
+    }
+    void swap(IntrusiveInts& other) {
+        items_.swap(other.items_);
+        list_.swap(other.list_);
+    }
+    bool remove(int position) { return list_.remove(position); }
+    bool moveToFront(int position) { return list_.moveToFront(position); }
+    bool moveAfter(int position, int target_position) { return list_.moveAfter(position, target_position); }
+    bool swapEntries(int position_a, int position_b) { return list_.swapEntries(position_a, position_b); }
+    template <class Predicate>
+    int moveToFrontIf(Predicate pred) {
+        return list_.moveToFrontIf([&pred](Item* item) { return pred(item->value); });
+    }
+
+private:
+    struct Item : IntrusiveListHook<Item> {
+        int value;
+    };
+
+    Item* make(int value) {
+        items_.emplace_back(new Item());
+        items_.back()->value = value;
+        return items_.back().get();
+    }
+
+    // Declared first so the list, which unlinks its entries, goes first
+    std::vector<std::unique_ptr<Item>> items_;
+    IntrusiveList<Item> list_;
+};
+
+// Entries of IntrusiveList carry their own links.
+struct Plate : IntrusiveListHook<Plate> {
+    int id;
+    explicit Plate(int plate_id) : id(plate_id) {}
+};
+
+std::vector<int> idsOf(const IntrusiveList<Plate>& list) {
+    std::vector<int> ids;
+    for (Plate* plate : list) {
+        ids.push_back(plate->id);
+    }
+    return ids;
+}
+
+// removeEntry unlinks a given entry through its own links, and only from
+// the list holding it; destroying an entry unlinks it, and a copy of an
+// entry starts out unlinked.
+void checkIntrusiveRemoveEntry() {
+    std::vector<std::unique_ptr<Plate>> plates;
+    IntrusiveList<Plate> list;
+    IntrusiveList<Plate> other;
+    for (int i = 0; i < 6; i++) {
+        plates.emplace_back(new Plate(i));
+        list.pushBack(plates.back().get());
+    }
+    list.getEntry(4);  // leaves the cursor past the entries removed below
+    check(list.removeEntry(plates[2].get()) && list.removeEntry(plates[0].get()) && list.removeEntry(plates[5].get()),
+          "entries in the middle, at the head and at the tail are removed");
+    check(idsOf(list) == std::vector<int>({1, 3, 4}) && list.getEntry(2)->id == 4, "the rest keep their order");
+    check(!plates[2]->isLinked() && !list.removeEntry(plates[2].get()) && !list.removeEntry(nullptr),
+          "an entry no longer in the list is not removed again");
+    other.pushBack(plates[2].get());
+    check(!list.insert(0, plates[1].get()) && !list.removeEntry(plates[2].get()) && other.getLength() == 1,
+          "an entry belongs to one list at a time");
+
+    Plate copy(*plates[3]);
+    check(!copy.isLinked() && list.getLength() == 3, "a copy of an entry starts unlinked");
+    Plate* doomed = new Plate(7);
+    list.insert(1, doomed);
+    delete doomed;
+    list.pushBack(plates[5].get());
+    check(idsOf(list) == std::vector<int>({1, 3, 4, 5}), "destroying an entry unlinks it");
+}
+
+// A slot type used by no list, so the shared pool below serves these tests only.
+struct Ticket {
+    long id;
+    char payload[24];
+};
+
+// Freed slots are handed out again, most recently freed first, before the
+// pool asks the system for another slab.
+void checkSlabReuse() {
+    SlabPool<Ticket> pool;
+    std::vector<void*> slots;
+    for (int i = 0; i < 100; i++) {
+        slots.push_back(pool.allocate());
+    }
+    std::size_t slabs = pool.getSlabCount();
+    check(std::set<void*>(slots.begin(), slots.end()).size() == slots.size(), "every slot is distinct");
+
+    void* last = slots.back();
+    pool.deallocate(last);
+    check(pool.allocate() == last, "the slot freed last is reused first");
+
+    for (void* slot : slots) {
+        pool.deallocate(slot);
+    }
+    std::vector<void*> again;
+    for (int i = 0; i < 100; i++) {
+        again.push_back(pool.allocate());
+    }
+    check(std::set<void*>(again.begin(), again.end()) == std::set<void*>(slots.begin(), slots.end()),
+          "a second round reuses the first round's slots");
+    check(pool.getSlabCount() == slabs, "no slab is added for reused slots");
+    for (void* slot : again) {
+        pool.deallocate(slot);
+    }
+}
+
+// Slots taken on one thread are freed on another, through the per-thread
+// caches. The freeing thread's cache goes back to the shared pool when it
+// exits, so later rounds need no new slabs.
+void checkCrossThreadFree() {
+    const int per_round = 1000;
+    std::size_t slabs_after_first = 0;
+    bool distinct = true;
+    bool intact = true;
+    for (int round = 0; round < 20; round++) {
+        std::vector<Ticket*> tickets;
+        std::thread taker([&] {
+            for (int i = 0; i < per_round; i++) {
+                Ticket* ticket = static_cast<Ticket*>(SlabPool<Ticket>::allocateShared());
+                ticket->id = round * per_round + i;
+                tickets.push_back(ticket);
+            }
+        });
+        taker.join();
+        distinct = distinct && std::set<Ticket*>(tickets.begin(), tickets.end()).size() == tickets.size();
+        std::thread freer([&] {
+            for (int i = 0; i < per_round; i++) {
+                intact = intact && tickets[i]->id == round * per_round + i;
+                SlabPool<Ticket>::deallocateShared(tickets[i]);
+            }
+        });
+        freer.join();
+        if (round == 0) {
+            slabs_after_first = SlabPool<Ticket>::instance().getSlabCount();
+        }
+    }
+    check(distinct, "no slot is handed out twice in a round");
+    check(intact, "a slot keeps what its taker wrote until it is freed");
+    check(SlabPool<Ticket>::instance().getSlabCount() == slabs_after_first,
+          "slots freed on another thread are reused");
+}
+
+// Interning far past the table's first index (a quarter of 1024 slots)
+// keeps every id, and the names they refer to, where they were; find
+// neither interns nor matches a name never interned.
+void checkSymbolGrowth() {
+    const int base = SymbolTable::size();
+    SymbolId first = SymbolTable::intern("symbol_growth 0");
+    const std::string* first_name = &SymbolTable::nameOf(first);
+    std::vector<SymbolId> ids;
+    for (int i = 0; i < 3000; i++) {
+        ids.push_back(SymbolTable::intern("symbol_growth " + std::to_string(i)));
+    }
+    bool dense = ids[0] == first && first == base;
+    bool found = true;
+    for (int i = 0; i < 3000; i++) {
+        std::string name = "symbol_growth " + std::to_string(i);
+        dense = dense && ids[i] == base + i;
+        found = found && SymbolTable::find(name) == ids[i] && SymbolTable::nameOf(ids[i]) == name &&
+                SymbolTable::intern(name) == ids[i];
+    }
+    check(dense && SymbolTable::size() == base + 3000, "new names get consecutive ids");
+    check(found, "every name keeps its id as the index grows");
+    check(&SymbolTable::nameOf(first) == first_name, "a name stays where it was first stored");
+    check(SymbolTable::find("symbol_growth never") == SymbolTable::NO_SYMBOL &&
+              SymbolTable::size() == base + 3000,
+          "find of a name never interned neither matches nor interns it");
+}
+
+// Threads intern overlapping names while others look them up, without a
+// lock on the lookup side: each name gets one id.
+void checkSymbolsFromThreads() {
+    std::vector<std::vector<SymbolId>> ids(4, std::vector<SymbolId>(1000));
+    std::atomic<int> wrong(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 1000; i++) {
+                std::string name = "symbol_threads " + std::to_string(i);
+                ids[t][i] = SymbolTable::intern(name);
+                SymbolId seen = SymbolTable::find("symbol_threads " + std::to_string(i / 2));
+                wrong += seen == SymbolTable::NO_SYMBOL || SymbolTable::nameOf(seen) != "symbol_threads " + std::to_string(i / 2);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    check(wrong.load() == 0, "a name interned earlier is found with its own id");
+    check(ids[0] == ids[1] && ids[1] == ids[2] && ids[2] == ids[3], "every thread gets the same id for a name");
+}
+
+// Keys below 10 hash to the last slot of an 8-slot FlatHashMap, the rest to
+// the first, so a run of the small keys wraps around the end of the table.
+struct WrappingHash {
+    static std::size_t valueWithHome(std::size_t home) {
+        std::size_t value = 0;
+        while ((static_cast<std::uint64_t>(value) * 0x9E3779B97F4A7C15ULL >> 32 & 7) != home) {
+            value++;
+        }
+        return value;
+    }
+    std::size_t operator()(int key) const {
+        static const std::size_t last = valueWithHome(7);
+        static const std::size_t first = valueWithHome(0);
+        return key < 10 ? last : first;
+    }
+};
+
+// Keys in insertion order, as forEach visits them
+template <class Map>
+std::string keysInOrder(const Map& map) {
+    std::string keys;
+    map.forEach([&keys](int key, int) { keys += " " + std::to_string(key); });
+    return keys;
+}
+
+// Erasing from a run that wraps past the table's end shifts the later keys
+// back, across the wrap, so each is still found from its home slot.
+void checkFlatMapWrappedErase() {
+    FlatHashMap<int, int, WrappingHash> map;
+    map.insert(1, 100);   // slot 7
+    map.insert(2, 200);   // wraps to slot 0
+    map.insert(10, 300);  // home slot 0 is taken: slot 1
+    check(map.erase(1) && map.find(1) == nullptr, "the key at the end of the table is erased");
+    check(map.find(2) != nullptr && *map.find(2) == 200 && map.find(10) != nullptr && *map.find(10) == 300,
+          "the keys after it in the run are found after the shift");
+    check(map.erase(2) && map.find(10) != nullptr && *map.find(10) == 300, "and again once the shifted key goes");
+    map.insert(3, 400);
+    check(map.size() == 2 && *map.find(3) == 400 && *map.find(10) == 300, "the shifted table takes new keys");
+    check(!map.erase(2) && !map.erase(11), "erasing an absent key changes nothing");
+}
+
+// Once dead entries outnumber live ones the map compacts; what is left keeps
+// its values and insertion order, and the map keeps working.
+void checkFlatMapCompaction() {
+    FlatHashMap<int, int> map;
+    std::string expected;
+    for (int key = 0; key < 100; key++) {
+        map.insert(key, key * 10);
+    }
+    for (int key = 0; key < 100; key++) {
+        if (key % 3 != 0) {
+            map.erase(key);
+        } else {
+            expected += " " + std::to_string(key);
+        }
+    }
+    bool kept = map.size() == 34;
+    for (int key = 0; key < 100; key++) {
+        const int* value = map.find(key);
+        kept = kept && (key % 3 == 0 ? value != nullptr && *value == key * 10 : value == nullptr);
+    }
+    check(kept, "live entries keep their values and erased ones are gone");
+    check(keysInOrder(map) == expected, "live entries keep their insertion order");
+    map.insert(100, 1000);
+    check(map.size() == 35 && *map.find(100) == 1000 && keysInOrder(map) == expected + " 100",
+          "the compacted map takes new keys at the end");
+}
+
+// A key erased and inserted again goes to the end of the order; inserting a
+// present key leaves both its value and its place alone.
+void checkFlatMapReinsertOrder() {
+    FlatHashMap<int, int> map;
+    map.insert(5, 50);
+    map.insert(6, 60);
+    map.insert(7, 70);
+    map.erase(6);
+    check(keysInOrder(map) == " 5 7", "an erased key leaves the order");
+    map.insert(6, 61);
+    check(keysInOrder(map) == " 5 7 6" && *map.find(6) == 61, "re-inserted, it goes to the end with its new value");
+    std::pair<int*, bool> again = map.insert(5, 99);
+    check(!again.second && *again.first == 50 && keysInOrder(map) == " 5 7 6", "a present key is not moved");
+}
+
+// Takes every station off a manager and frees it, with its dishes. The
+// pointers are copied out first, and names may repeat, so all are taken off
+// before any is freed.
+void deleteStations(StationManager& manager) {
+    std::vector<KitchenStation*> stations(manager.begin(), manager.end());
+    for (KitchenStation* station : stations) {
+        manager.removeStation(station->getName());
+    }
+    for (KitchenStation* station : stations) {
+        delete station;
+    }
+}
+
+// Names of the dishes left in the queue, front to back
+std::string queuedNames(const StationManager& manager) {
+    std::string names;
+    for (std::queue<Dish*> queue = manager.getDishQueue(); !queue.empty(); queue.pop()) {
+        names += " " + queue.front()->getName();
+    }
+    return names;
+}
+
+int countOf(const std::string& text, const std::string& word) {
+    int count = 0;
+    for (size_t at = text.find(word); at != std::string::npos; at = text.find(word, at + 1)) {
+        count++;
+    }
+    return count;
+}
+
+// Four threads read the roster by position at once: const lookups leave the
+// list's cursor alone, so this is safe.
+void checkRosterReadsFromThreads() {
+    StationManager manager;
+    for (int i = 0; i < 64; i++) {
+        manager.addStation(new KitchenStation("S" + std::to_string(i)));
+    }
+    const StationManager& roster = manager;
+    std::atomic<int> wrong(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&, t] {
+            for (int round = 0; round < 200; round++) {
+                for (int i = 0; i < roster.getLength(); i++) {
+                    int position = (i * (t + 1)) % roster.getLength();
+                    wrong += roster.getEntry(position)->getName() != "S" + std::to_string(position);
+                }
+            }
+        });
+    }
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    check(wrong.load() == 0, "every reader finds each station at its position");
+    deleteStations(manager);
+}
+
+// The entries of a ConcurrentList, front to back.
+std::vector<int> entriesOf(const ConcurrentList<int>& list) {
+    std::vector<int> entries;
+    list.forEach([&](int entry) {
+        entries.push_back(entry);
+        return true;
+    });
+    return entries;
+}
+
+// pushBack starts from a tail hint; removing the node it names, or every
+// node, must send the next append back to the real end of the chain.
+void checkConcurrentListAppends() {
+    ConcurrentList<int> list;
+    for (int i = 1; i <= 5; i++) {
+        list.pushBack(i);
+    }
+    list.removeEntry(5);
+    list.pushBack(6);
+    list.pushFront(0);
+    check(entriesOf(list) == std::vector<int>({0, 1, 2, 3, 4, 6}), "appends follow the last entry left");
+    for (int i = 0; i <= 6; i++) {
+        list.removeEntry(i);
+    }
+    list.pushBack(7);
+    list.pushBack(8);
+    check(entriesOf(list) == std::vector<int>({7, 8}), "appends to an emptied list");
+
+    // Four threads append their own entries and remove every other one
+    ConcurrentList<int> shared;
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; t++) {
+        writers.emplace_back([&, t] {
+            for (int i = 0; i < 500; i++) {
+                shared.pushBack(t * 1000 + i);
+                if (i % 2 == 1) {
+                    shared.removeEntry(t * 1000 + i - 1);
+                }
+            }
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    std::vector<int> left = entriesOf(shared);
+    check(left.size() == 1000 && shared.getLength() == 1000, "each thread keeps half its entries");
+    for (int t = 0; t < 4; t++) {
+        std::vector<int> own;
+        for (int entry : left) {
+            if (entry / 1000 == t) {
+                own.push_back(entry);
+            }
+        }
+        bool in_order = own.size() == 250;
+        for (size_t i = 0; in_order && i < own.size(); i++) {
+            in_order = own[i] == t * 1000 + 2 * int(i) + 1;
+        }
+        check(in_order, "thread " + std::to_string(t) + "'s entries are in the order it appended them");
+    }
+}
+
+// Two threads walk the roster's lock-free mirror while this one moves
+// stations to the front: no walk sees a station twice, and once the writer
+// is done the mirror is in roster order.
+void checkRosterMirror() {
+    StationManager manager;
+    for (int i = 0; i < 32; i++) {
+        manager.addStation(new KitchenStation("S" + std::to_string(i)));
+    }
+    manager.enableConcurrentReads();
+    std::atomic<bool> moving(true);
+    std::atomic<int> repeats(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 2; t++) {
+        readers.emplace_back([&] {
+            while (moving.load()) {
+                std::set<const KitchenStation*> seen;
+                manager.forEachStation([&](const KitchenStation* station) {
+                    repeats += !seen.insert(station).second;
+                    return true;
+                });
+            }
+        });
+    }
+    for (int i = 0; i < 2000; i++) {
+        manager.moveStationToFront("S" + std::to_string((i * 7) % 32));
+    }
+    moving = false;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    manager.addStation(new KitchenStation("S32"));
+    KitchenStation* removed = manager.findStation("S5");
+    manager.removeStation("S5");
+    std::vector<KitchenStation*> mirrored;
+    manager.forEachStation([&](KitchenStation* station) {
+        mirrored.push_back(station);
+        return true;
+    });
+    check(repeats.load() == 0, "no walk visits a station twice");
+    check(mirrored == std::vector<KitchenStation*>(manager.begin(), manager.end()), "the mirror follows the roster");
+    check(std::find(mirrored.begin(), mirrored.end(), removed) == mirrored.end(), "a removed station leaves the mirror");
+    deleteStations(manager);
+    delete removed;
+}
+
+// appendStations moves one manager's roster, and its mirror entries, to
+// another.
+void checkAppendStations() {
+    StationManager kitchen;
+    StationManager annex;
+    kitchen.addStation(new KitchenStation("A"));
+    kitchen.enableConcurrentReads();
+    annex.addStations({new KitchenStation("B"), new KitchenStation("C")});
+    annex.enableConcurrentReads();
+    kitchen.appendStations(annex);
+    kitchen.addStation(new KitchenStation("D"));
+    std::string names;
+    kitchen.forEachStation([&](KitchenStation* station) {
+        names += station->getName();
+        return true;
+    });
+    check(names == "ABCD", "the mirror lists the appended stations in order");
+    check(annex.isEmpty() && annex.forEachStation([](KitchenStation*) { return true; }) == 0,
+          "the donor has no stations left, in its roster or its mirror");
+    deleteStations(kitchen);
+}
+
+// The names on a roster snapshot, front to back.
+std::vector<std::string> namesOf(const StationManager::RosterSnapshot& snapshot) {
+    std::vector<std::string> names;
+    for (KitchenStation* station : snapshot) {
+        names.push_back(station->getName());
+    }
+    return names;
+}
+
+// A snapshot keeps the roster it was taken from while the roster changes;
+// one taken afterwards shows every change, in roster order.
+void checkSnapshotIsolation() {
+    StationManager manager;
+    for (int i = 0; i < 8; i++) {
+        manager.addStation(new KitchenStation("S" + std::to_string(i)));
+    }
+    manager.enableSnapshots();
+    StationManager::RosterSnapshot before = manager.snapshot();
+    StationManager annex;
+    annex.addStations({new KitchenStation("A0"), new KitchenStation("A1")});
+    KitchenStation* removed = manager.findStation("S3");
+    manager.removeStation("S3");
+    manager.moveStationToFront("S6");
+    manager.addStation(new KitchenStation("S8"));
+    manager.appendStations(annex);
+    StationManager::RosterSnapshot after = manager.snapshot();
+    std::vector<std::string> roster;
+    for (KitchenStation* station : manager) {
+        roster.push_back(station->getName());
+    }
+    check(namesOf(before) == std::vector<std::string>({"S0", "S1", "S2", "S3", "S4", "S5", "S6", "S7"}),
+          "an earlier snapshot is unchanged");
+    check(namesOf(after) == roster && roster.front() == "S6" && roster.back() == "A1" && after.getLength() == 10,
+          "a later snapshot follows the roster");
+    deleteStations(manager);
+    delete removed;
+}
+
+// Lookups by name go through the index: with names shared, the first
+// station in roster order is found, and the next takes its place when it
+// leaves or falls behind; a donor of appendStations finds none.
+void checkNameIndex() {
+    StationManager manager;
+    KitchenStation* grill = new KitchenStation("Grill");
+    KitchenStation* grill2 = new KitchenStation("Grill");
+    KitchenStation* fry = new KitchenStation("Fry");
+    manager.addStations({grill, fry, grill2});
+    check(manager.findStation("Grill") == grill && manager.findStation("Fry") == fry, "the first station with a name is found");
+    check(manager.moveStationToFront("Fry") && manager.findStation("Grill") == grill, "moving another station changes nothing");
+    check(manager.removeStation("Grill") && manager.findStation("Grill") == grill2, "the next station with the name takes over");
+    check(manager.removeStation("Grill") && manager.findStation("Grill") == nullptr && !manager.removeStation("Grill"),
+          "a name is gone once its last station is");
+    check(manager.getLength() == 1 && manager.getEntry(0) == fry, "the roster keeps the rest");
+
+    StationManager annex;
+    KitchenStation* pastry = new KitchenStation("Pastry");
+    annex.addStation(pastry);
+    manager.appendStations(annex);
+    check(manager.findStation("Pastry") == pastry && annex.findStation("Pastry") == nullptr,
+          "appended stations are found by their new manager only");
+    deleteStations(manager);
+    delete grill;
+    delete grill2;
+}
+
+// Orders are routed to the stations a dish is assigned to, as stations
+// join, leave and change hands between managers.
+void checkDishIndex() {
+    StationManager manager;
+    KitchenStation* prep = new KitchenStation("Prep");
+    KitchenStation* soup = new KitchenStation("Soup");
+    soup->assignDishToStation(newAppetizer("Broth", {}));  // before it joins
+    manager.addStations({prep, soup});
+    check(manager.canCompleteOrder("Broth"), "a dish the station had when it joined is routed");
+    check(!manager.canCompleteOrder("Salad") && manager.assignDishToStation("Prep", newAppetizer("Salad", {})) &&
+              manager.canCompleteOrder("Salad"),
+          "a dish assigned through the manager is routed");
+    check(manager.removeStation("Soup") && !manager.canCompleteOrder("Broth"), "a removed station takes its dishes along");
+
+    StationManager annex;
+    annex.addStation(soup);
+    manager.appendStations(annex);
+    check(manager.canCompleteOrder("Broth") && !annex.canCompleteOrder("Broth"),
+          "appended stations' dishes are routed by their new manager only");
+    deleteStations(manager);
+}
+
+// Under ADAPTIVE routing a station moved to the front of the roster keeps
+// its place by score: a station that keeps running out is still tried last.
+void checkAdaptiveMoveToFront() {
+    CaptureCout trace;
+    StationManager manager;
+    KitchenStation* first = new KitchenStation("A");
+    KitchenStation* flaky = new KitchenStation("B");
+    for (KitchenStation* station : {first, flaky}) {
+        station->assignDishToStation(newAppetizer("Soup", {Ingredient("Salt", 1, 1, 1.0)}));
+        manager.addStation(station);
+    }
+    manager.setRoutingMode(StationManager::ADAPTIVE);
+    Dish* order = newAppetizer("Soup", {Ingredient("Salt", 1, 1, 1.0)});
+
+    // Both miss once; then A is stocked and B misses again, so A ranks first
+    for (int i = 0; i < 3; i++) {
+        if (i == 2) {
+            first->replenishStationIngredients(Ingredient("Salt", 10, 0, 1.0));
+        }
+        manager.addDishToQueue(order);
+        manager.processAllDishes();
+    }
+    long failed = manager.getRoutingStats().failed_probes;
+    check(failed == 3, "each station missed from stock");
+
+    manager.moveStationToFront("B");
+    check(manager.getEntry(0) == flaky, "B is at the front of the roster");
+    trace.clear();
+    manager.addDishToQueue(order);
+    manager.processAllDishes();
+    check(manager.getRoutingStats().failed_probes == failed, "the move does not put B before A");
+    check(trace.text().find("B attempting") == std::string::npos, "only A is tried");
+
+    manager.setRoutingMode(StationManager::ROSTER_ORDER);
+    trace.clear();
+    manager.addDishToQueue(order);
+    manager.processAllDishes();
+    check(trace.text().find("B attempting") < trace.text().find("A attempting"),
+          "back in roster order, B is tried first");
+    deleteStations(manager);
+    delete order;
+}
+
+// EARLIEST_FINISH spreads a rush of dishes over the stations that can make
+// them, where roster order piles them all onto the first.
+void checkEarliestFinish() {
+    CaptureCout trace;
+    for (StationManager::RoutingMode mode : {StationManager::ROSTER_ORDER, StationManager::EARLIEST_FINISH}) {
+        StationManager manager;
+        KitchenStation* first = new KitchenStation("A");
+        KitchenStation* second = new KitchenStation("B");
+        for (KitchenStation* station : {first, second}) {
+            station->assignDishToStation(newAppetizer("Stew", {}, 10));
+            manager.addStation(station);
+        }
+        manager.setRoutingMode(mode);
+        Dish* order = newAppetizer("Stew", {}, 10);
+        for (int i = 0; i < 4; i++) {
+            manager.addDishToQueue(order);
+        }
+        manager.processAllDishes();
+        bool spread = mode == StationManager::EARLIEST_FINISH;
+        check(manager.getRoutingStats().latest_finish == (spread ? 20 : 40), "the last of four dishes is done in time");
+        check(first->getBusyUntil() == (spread ? 20 : 40) && second->getBusyUntil() == (spread ? 20 : 0),
+              "each station's backlog holds the dishes it was given");
+
+        manager.advanceSimulatedTime(50);
+        manager.addDishToQueue(order);
+        manager.processAllDishes();
+        check(first->getBusyUntil() == 60, "a dish routed later starts when it arrives");
+        deleteStations(manager);
+        delete order;
+    }
+}
+
+// A station with plenty of broth but little beef to spare is not the
+// cheapest for a stew while the queue wants that beef, even though the
+// other station is shorter of broth, which nobody else needs.
+void checkInventoryCostWeighsDemand() {
+    KitchenStation beefy("A");
+    KitchenStation brothy("B");
+    for (KitchenStation* station : {&beefy, &brothy}) {
+        station->assignDishToStation(newAppetizer("Stew", {Ingredient("Broth", 1, 1, 1.0), Ingredient("Beef", 1, 1, 1.0)}));
+    }
+    beefy.replenishStationIngredients(Ingredient("Broth", 5, 0, 1.0));
+    beefy.replenishStationIngredients(Ingredient("Beef", 1000, 0, 1.0));
+    brothy.replenishStationIngredients(Ingredient("Broth", 100, 0, 1.0));
+    brothy.replenishStationIngredients(Ingredient("Beef", 40, 0, 1.0));
+
+    Dish* stew = newAppetizer("Stew", {Ingredient("Broth", 1, 1, 1.0), Ingredient("Beef", 1, 1, 1.0)});
+    Dish* steak = newAppetizer("Steak", {Ingredient("Beef", 1, 1, 1.0)});
+    InventoryCostPolicy policy;
+    QueuedDemand demand;
+    check(policy.cost(brothy, *stew, demand) < policy.cost(beefy, *stew, demand),
+          "with nothing queued, the station with more of its tightest ingredient");
+    demand.add(*steak, 30);
+    check(policy.cost(beefy, *stew, demand) < policy.cost(brothy, *stew, demand),
+          "with steaks queued, the station that can spare the beef");
+    delete stew;
+    delete steak;
+}
+
+// One randomized kitchen, reproducible from its seed.
+struct Scenario {
+    unsigned seed;
+    StationManager::RoutingMode mode;
+    bool verbose;
+};
+
+// The dish `d` of a scenario: one or two of seven ingredients.
+Dish* scenarioDish(int d, unsigned seed) {
+    std::mt19937 rng(seed * 31 + d);
+    std::vector<Ingredient> ingredients;
+    int count = 1 + rng() % 2;
+    for (int j = 0; j < count; j++) {
+        ingredients.push_back(Ingredient("I" + std::to_string((d + j * 3) % 7), 1 + rng() % 3, 1 + rng() % 3, 1.0));
+    }
+    return newAppetizer("Dish " + letterId(d), ingredients, 1 + d % 5);
+}
+
+// Runs three rounds of queueing and processing on `threads` threads, with
+// restocks between rounds, and returns everything a caller can observe: the
+// traces, what is left queued, stock, backup, statistics and route scores.
+std::string runScenario(const Scenario& scenario, int threads) {
+    std::mt19937 rng(scenario.seed);
+    StationManager manager;
+    const int station_count = 24;
+    std::vector<KitchenStation*> roster;
+    for (int i = 0; i < station_count; i++) {
+        // some names repeat, so lookups by name see more than one station
+        roster.push_back(new KitchenStation("S" + std::to_string(i % 21)));
+    }
+    for (int d = 0; d < 15; d++) {
+        int copies = 1 + rng() % 3;
+        for (int c = 0; c < copies; c++) {
+            Dish* copy = scenarioDish(d, scenario.seed);
+            if (!roster[rng() % station_count]->assignDishToStation(copy)) {
+                delete copy;
+            }
+        }
+    }
+    for (KitchenStation* station : roster) {
+        for (int j = 0; j < 7; j++) {
+            if (rng() % 2) {
+                station->replenishStationIngredients(Ingredient("I" + std::to_string(j), 1 + rng() % 6, 0, 1.0));
+            }
+        }
+        manager.addStation(station);
+    }
+    for (int j = 0; j < 7; j++) {
+        manager.addBackupIngredient(Ingredient("I" + std::to_string(j), rng() % 8, 0, 1.0));
+    }
+    std::vector<Dish*> menu;
+    for (int d = 0; d < 16; d++) {
+        menu.push_back(scenarioDish(d, scenario.seed));  // the last is on no station
+    }
+    manager.setVerboseRouting(scenario.verbose);
+    manager.setRoutingMode(scenario.mode);
+    manager.setWorkerThreads(threads);
+
+    std::ostringstream seen;
+    for (int round = 0; round < 3; round++) {
+        for (int q = 0; q < 120; q++) {
+            manager.addDishToQueue(menu[rng() % 16]);
+        }
+        {
+            CaptureCout trace;
+            manager.processAllDishes();
+            manager.advanceSimulatedTime(2);
+            seen << trace.text();
+        }
+        for (KitchenStation* station : roster) {
+            if (rng() % 3 == 0) {
+                station->replenishStationIngredients(Ingredient("I" + std::to_string(rng() % 7), 1 + rng() % 4, 0, 1.0));
+            }
+        }
+    }
+    seen << "QUEUE" << queuedNames(manager) << "\nSTOCK";
+    for (KitchenStation* station : roster) {
+        seen << "|";
+        for (const Ingredient& ingredient : station->getIngredientsStock()) {
+            seen << ingredient.name << ingredient.quantity << ",";
+        }
+        seen << station->getBusyUntil();
+    }
+    seen << "\nBACKUP";
+    for (const Ingredient& ingredient : manager.getBackupIngredients()) {
+        seen << ingredient.name << ingredient.quantity << ",";
+    }
+    StationManager::RoutingStats stats = manager.getRoutingStats();
+    seen << "\nSTATS " << stats.dishes_prepared << " " << stats.failed_probes << " " << stats.latest_finish << " "
+         << stats.total_latency << " " << stats.backup_draws << " " << stats.queue_failures << "\n";
+    for (int d = 0; d < 16; d++) {
+        for (const StationManager::RouteCandidate& candidate : manager.getRouteCandidates("Dish " + letterId(d))) {
+            seen << candidate.station->getName() << ":" << candidate.hits << "/" << candidate.misses << " ";
+        }
+    }
+    deleteStations(manager);
+    for (Dish* dish : menu) {
+        delete dish;
+    }
+    return seen.str();
+}
+
+// A parallel pass must be indistinguishable from the serial one: the same
+// trace, outcomes, stock, backup, statistics and route records, in every
+// routing mode, verbose or not.
+void checkParallelMatchesSerial() {
+    const StationManager::RoutingMode modes[] = {StationManager::ROSTER_ORDER, StationManager::ADAPTIVE,
+                                                 StationManager::EARLIEST_FINISH};
+    for (unsigned seed = 1; seed <= 6; seed++) {
+        for (bool verbose : {false, true}) {
+            for (StationManager::RoutingMode mode : modes) {
+                Scenario scenario{seed, mode, verbose};
+                std::string serial = runScenario(scenario, 1);
+                for (int threads : {2, 3, 8}) {
+                    check(runScenario(scenario, threads) == serial,
+                          "seed " + std::to_string(seed) + " mode " + std::to_string(mode) + " verbose " +
+                              std::to_string(verbose) + " threads " + std::to_string(threads));
+                }
+            }
+        }
+    }
+}
+
+// Eight stations, forty dishes, a little backup: the statistics and what is
+// left queued after two passes, plus the trace (or its length when quiet).
+std::string runSmallKitchen(int threads, bool quiet) {
+    StationManager manager;
+    for (int i = 0; i < 8; i++) {
+        manager.addStation(new KitchenStation("S" + std::to_string(i)));
+    }
+    for (int d = 0; d < 8; d++) {
+        std::string ingredient = "I" + std::to_string(d % 3);
+        manager.assignDishToStation("S" + std::to_string(d),
+                                    newAppetizer("Dish " + letterId(d), {Ingredient(ingredient, 2, 2, 1.0)}));
+        manager.replenishIngredientAtStation("S" + std::to_string(d), Ingredient(ingredient, 3 + d, 0, 1.0));
+    }
+    manager.addBackupIngredients({Ingredient("I1", 5, 0, 1.0)});
+    manager.setWorkerThreads(threads);
+    std::vector<Dish*> orders;
+    for (int i = 0; i < 40; i++) {
+        int d = (i * 5) % 8;
+        orders.push_back(newAppetizer("Dish " + letterId(d), {Ingredient("I" + std::to_string(d % 3), 2, 2, 1.0)}));
+        manager.addDishToQueue(orders.back());
+    }
+    std::string trace;
+    {
+        CaptureCout capture;
+        if (quiet) {
+            std::cout.setstate(std::ios::badbit);
+        }
+        manager.processAllDishes();
+        manager.processAllDishes();
+        std::cout.clear();
+        trace = capture.text();
+    }
+    StationManager::RoutingStats stats = manager.getRoutingStats();
+    std::ostringstream seen;
+    seen << stats.dishes_prepared << " " << stats.failed_probes << " " << stats.backup_draws << " "
+         << stats.queue_failures << " queue" << queuedNames(manager);
+    seen << "\n" << (quiet ? std::to_string(trace.size()) : trace);
+    deleteStations(manager);
+    for (Dish* order : orders) {
+        delete order;
+    }
+    return seen.str();
+}
+
+// Random adds and removes against a plain vector: the top is always the
+// entry that comes first under Compare, and draining the heap sorts it.
+template <class Compare>
+void checkHeapOrder(const std::string& order) {
+    BinaryHeap<int, Compare> heap;
+    std::vector<int> model;
+    Compare before;
+    std::mt19937 rng(19);
+    for (int round = 0; round < 20000; round++) {
+        if (model.empty() || rng() % 3 != 0) {
+            int entry = static_cast<int>(rng() % 100);
+            heap.add(entry);
+            model.push_back(entry);
+        } else {
+            std::vector<int>::iterator first = std::min_element(model.begin(), model.end(), before);
+            check(heap.peekTop() == *first, order + ": the top comes first");
+            model.erase(first);
+            heap.remove();
+        }
+    }
+    check(heap.size() == model.size(), order + ": size counts the entries");
+    std::sort(model.begin(), model.end(), before);
+    std::vector<int> drained;
+    for (; !heap.isEmpty(); heap.remove()) {
+        drained.push_back(heap.peekTop());
+    }
+    check(drained == model, order + ": draining the heap sorts it");
+}
+
+void checkBinaryHeap() {
+    BinaryHeap<int> heap;
+    check(heap.isEmpty() && !heap.remove(), "a new heap is empty");
+    bool threw = false;
+    try {
+        heap.peekTop();
+    } catch (const PrecondViolatedExcep&) {
+        threw = true;
+    }
+    check(threw, "peekTop on an empty heap throws");
+    heap.add(2);
+    heap.add(1);
+    heap.clear();
+    check(heap.isEmpty() && heap.entries().empty(), "clear empties the heap");
+    checkHeapOrder<std::less<int>>("min-heap");
+    checkHeapOrder<std::greater<int>>("max-heap");
+}
+
+// Four producers and four consumers share a small ring: every entry comes
+// out exactly once, and each producer's entries in the order it pushed them.
+void checkQueueHandsOutEachEntryOnce() {
+    MpmcQueue<long> queue(64);
+    const int producers = 4;
+    const int consumers = 4;
+    const long per_producer = 20000;
+    std::vector<std::vector<long>> taken(consumers);
+    std::atomic<long> popped(0);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            for (long i = 0; i < per_producer; i++) {
+                while (!queue.tryPush(p * per_producer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&, c] {
+            long entry;
+            while (popped.load() < producers * per_producer) {
+                if (queue.tryPop(entry)) {
+                    taken[c].push_back(entry);
+                    popped++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    std::vector<int> times_seen(producers * per_producer, 0);
+    bool in_order = true;
+    for (const std::vector<long>& entries : taken) {
+        std::vector<long> last(producers, -1);
+        for (long entry : entries) {
+            times_seen[entry]++;
+            in_order = in_order && entry > last[entry / per_producer];
+            last[entry / per_producer] = entry;
+        }
+    }
+    check(in_order, "each consumer sees a producer's entries in order");
+    check(std::count(times_seen.begin(), times_seen.end(), 1) == producers * per_producer, "every entry once");
+    long entry;
+    check(queue.isEmpty() && !queue.tryPop(entry), "the queue is empty afterwards");
+}
+
+void checkQueueReserve() {
+    MpmcQueue<int> queue(3);
+    check(queue.capacity() == 4, "capacity rounds up to a power of two");
+    for (int i = 0; i < 4; i++) {
+        queue.tryPush(i);
+    }
+    check(!queue.tryPush(9), "a full queue refuses a push");
+    int entry = -1;
+    check(queue.tryPop(entry) && entry == 0 && queue.tryPush(4), "a pop makes room");
+    queue.reserve(100);
+    check(queue.capacity() == 128 && queue.size() == 4, "reserve grows the queue and keeps its entries");
+    std::vector<int> kept;
+    queue.forEach([&kept](int item) { kept.push_back(item); });
+    check(kept == std::vector<int>({1, 2, 3, 4}), "reserve keeps the order");
+}
+
+// A station that makes dish "D" from one ingredient "I": `needed` of it per
+// dish, with `stock` in stock.
+KitchenStation* oneDishStation(int needed, int stock) {
+    KitchenStation* station = new KitchenStation("S");
+    station->assignDishToStation(newAppetizer("D", {Ingredient("I", needed, 1, 1.0)}));
+    if (stock > 0) {
+        station->replenishStationIngredients(Ingredient("I", stock, 0, 1.0));
+    }
+    return station;
+}
+
+// Three threads add dishes while three others prepare them.
+void checkManagerProducersAndConsumers() {
+    CaptureCout quiet;
+    StationManager manager;
+    KitchenStation* station = oneDishStation(1, 1000000);
+    manager.addStation(station);
+    Dish* order = newAppetizer("D", {Ingredient("I", 1, 1, 1.0)});
+    const int producers = 3;
+    const int per_producer = 3000;
+    std::atomic<int> prepared(0);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < per_producer; i++) {
+                manager.addDishToQueue(order);
+            }
+        });
+    }
+    for (int c = 0; c < 3; c++) {
+        threads.emplace_back([&] {
+            while (prepared.load() < producers * per_producer) {
+                if (manager.getDishQueueSize() > 0 && manager.prepareNextDish()) {
+                    prepared++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    check(manager.getDishQueueSize() == 0, "every dish was taken");
+    check(manager.getRoutingStats().dishes_prepared == producers * per_producer, "every dish was prepared");
+    deleteStations(manager);
+    delete order;
+}
+
+// A full queue of dishes that cannot be made: passes put them back without
+// waiting for room, a try to add one more is refused, and adding one anyway
+// grows the queue.
+void checkFullQueue(int threads) {
+    CaptureCout quiet;
+    StationManager manager;
+    manager.setWorkerThreads(threads);
+    KitchenStation* station = oneDishStation(100000, 0);
+    manager.addStation(station);
+    Dish* order = newAppetizer("D", {Ingredient("I", 100000, 1, 1.0)});
+    const size_t capacity = StationManager::DISH_QUEUE_CAPACITY;
+    for (size_t i = 0; i < capacity; i++) {
+        manager.addDishToQueue(order);
+    }
+    check(!manager.tryAddDishToQueue(order), "a full queue refuses tryAddDishToQueue");
+    check(!manager.tryAddDishToQueue(nullptr), "tryAddDishToQueue refuses a null dish");
+    check(!manager.prepareNextDish() && manager.getDishQueueSize() == capacity, "a failed dish goes back");
+    manager.processAllDishes();
+    check(manager.getDishQueueSize() == capacity, "a failed pass puts every dish back");
+    std::thread producer([&] { manager.addDishToQueue(order); });
+    producer.join();
+    check(manager.getDishQueueSize() == capacity + 1, "addDishToQueue grows a full queue");
+    check(manager.tryAddDishToQueue(order), "the grown queue has room");
+    station->replenishStationIngredients(Ingredient("I", 100000 * int(capacity + 2), 0, 1.0));
+    manager.processAllDishes();
+    check(manager.getDishQueueSize() == 0, "every dish is made once there is stock");
+    deleteStations(manager);
+    delete order;
+}
+
+// clearDishQueue from one thread while others add dishes and route them
+// under a heap discipline. No dish can be made, so every one is freed by a
+// clear, exactly once (run under SANITIZE=address,undefined to see it).
+void checkClearWhileRouting() {
+    CaptureCout quiet;
+    StationManager manager;
+    KitchenStation* station = oneDishStation(100000, 1);
+    manager.addStation(station);
+    station->setAtomicStock(true);
+    manager.setQueueDiscipline(StationManager::SHORTEST_PREP_FIRST);
+    manager.setRetryParking(true);
+    std::atomic<int> adding(2);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < 2; p++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 2000; i++) {
+                manager.addDishToQueue(newAppetizer("D", {Ingredient("I", 100000, 1, 1.0)}, 1 + i % 7));
+            }
+            adding--;
+        });
+    }
+    threads.emplace_back([&] {
+        while (adding.load() > 0) {
+            manager.prepareNextDish();
+        }
+    });
+    threads.emplace_back([&] {
+        while (adding.load() > 0) {
+            manager.replenishIngredientAtStation("S", Ingredient("I", 1, 0, 1.0));
+            std::this_thread::yield();
+        }
+    });
+    while (adding.load() > 0) {
+        manager.clearDishQueue();
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    manager.clearDishQueue();
+    check(manager.getRoutingStats().dishes_prepared == 0, "no dish was made");
+    check(manager.getDishQueueSize() == 0 && manager.getParkedDishCount() == 0, "the last clear leaves nothing");
+    deleteStations(manager);
+}
+
+// One thread queues more dishes than the queue starts with, then processes
+// them: nothing else runs to free a slot.
+void checkOneThreadOverfillsQueue() {
+    CaptureCout quiet;
+    StationManager manager;
+    manager.addStation(oneDishStation(1, 1000000));
+    std::vector<Dish*> orders;
+    const int count = int(StationManager::DISH_QUEUE_CAPACITY) + 904;
+    for (int i = 0; i < count; i++) {
+        orders.push_back(newAppetizer("D", {Ingredient("I", 1, 1, 1.0)}));
+        manager.addDishToQueue(orders.back());
+    }
+    check(manager.getDishQueueSize() == size_t(count), "every dish is queued");
+    manager.processAllDishes();
+    check(manager.getDishQueueSize() == 0 && manager.getRoutingStats().dishes_prepared == count,
+          "every dish is prepared");
+    deleteStations(manager);
+    for (Dish* order : orders) {
+        delete order;
+    }
+}
+
+// Producers outrun a consumer, so the queue grows while it is in use. One
+// producer only tries, and counts what was refused.
+void checkQueueGrowsWhileInUse() {
+    CaptureCout quiet;
+    StationManager manager;
+    manager.addStation(oneDishStation(1, 1000000));
+    Dish* order = newAppetizer("D", {Ingredient("I", 1, 1, 1.0)});
+    const int producers = 4;
+    const int per_producer = 3000;
+    std::atomic<int> prepared(0);
+    std::atomic<int> refused(0);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; i++) {
+                if (p > 0) {
+                    manager.addDishToQueue(order);
+                } else if (!manager.tryAddDishToQueue(order)) {
+                    refused++;
+                }
+            }
+        });
+    }
+    threads.emplace_back([&] {
+        while (prepared.load() + refused.load() < producers * per_producer) {
+            if (manager.getDishQueueSize() > 0 && manager.prepareNextDish()) {
+                prepared++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    check(manager.getDishQueueSize() == 0, "every queued dish was taken");
+    check(manager.getRoutingStats().dishes_prepared == prepared.load(), "every taken dish was prepared");
+    deleteStations(manager);
+    delete order;
+}
+
+// A station that makes every dish in `names`, which need no ingredients.
+KitchenStation* stationFor(const std::string& names) {
+    KitchenStation* station = new KitchenStation("S");
+    for (char name : names) {
+        station->assignDishToStation(newAppetizer(std::string(1, name), {}));
+    }
+    return station;
+}
+
+// Prepares the queue one dish at a time and returns the dishes in the order
+// they were taken: each is the one gone from the queue afterwards.
+std::string takenNames(StationManager& manager) {
+    std::string taken;
+    std::queue<Dish*> waiting = manager.getDishQueue();
+    std::set<Dish*> before;
+    for (; !waiting.empty(); waiting.pop()) {
+        before.insert(waiting.front());
+    }
+    while (manager.prepareNextDish()) {
+        std::set<Dish*> after;
+        for (waiting = manager.getDishQueue(); !waiting.empty(); waiting.pop()) {
+            after.insert(waiting.front());
+        }
+        for (Dish* dish : before) {
+            if (after.count(dish) == 0) {
+                taken += " " + dish->getName();
+            }
+        }
+        before.swap(after);
+    }
+    return taken;
+}
+
+// Shorter prep first, ties in arrival order; a dish that fails goes behind
+// the dishes it tied with, and a pass tries each dish once.
+void checkShortestPrepFirst() {
+    CaptureCout quiet;
+    StationManager manager;
+    manager.addStation(stationFor("abcdexy"));
+    std::vector<Dish*> orders = {newAppetizer("a", {}, 5), newAppetizer("b", {}, 3), newAppetizer("c", {}, 5),
+                                 newAppetizer("d", {}, 1), newAppetizer("e", {}, 3)};
+    // the dishes queued before the switch are taken in the new order too
+    manager.addDishToQueue(orders[0]);
+    manager.addDishToQueue(orders[1]);
+    manager.setQueueDiscipline(StationManager::SHORTEST_PREP_FIRST);
+    check(manager.getQueueDiscipline() == StationManager::SHORTEST_PREP_FIRST, "the discipline is set");
+    for (size_t i = 2; i < orders.size(); i++) {
+        manager.addDishToQueue(orders[i]);
+    }
+    check(queuedNames(manager) == " d b e a c", "getDishQueue lists the dishes as they will be taken");
+    check(takenNames(manager) == " d b e a c", "taken by prep time, ties in arrival order");
+
+    // "z" has no station, so it fails
+    orders.push_back(newAppetizer("z", {}, 2));
+    orders.push_back(newAppetizer("y", {}, 2));
+    orders.push_back(newAppetizer("x", {}, 4));
+    manager.addDishToQueue(orders[5]);
+    manager.addDishToQueue(orders[6]);
+    manager.addDishToQueue(orders[7]);
+    check(!manager.prepareNextDish() && queuedNames(manager) == " y z x", "a failed dish goes behind its ties");
+    manager.processAllDishes();
+    check(manager.getRoutingStats().queue_failures == 2 && queuedNames(manager) == " z",
+          "a pass tries the failed dish once");
+    manager.clearDishQueue();
+    deleteStations(manager);
+    for (size_t i = 0; i < 5; i++) {
+        delete orders[i];
+    }
+    delete orders[6];
+    delete orders[7];
+}
+
+// Earlier deadline first, ties in arrival order. A dish added without a
+// deadline is due at NO_DEADLINE, after every dish that has one; FIFO
+// ignores deadlines.
+void checkEarliestDeadlineFirst() {
+    CaptureCout quiet;
+    StationManager manager;
+    manager.addStation(stationFor("abcdefg"));
+    manager.setQueueDiscipline(StationManager::EARLIEST_DEADLINE_FIRST);
+    std::vector<Dish*> orders;
+    for (char name : std::string("abcdefg")) {
+        orders.push_back(newAppetizer(std::string(1, name), {}));
+    }
+    manager.addDishToQueue(orders[0], 30);
+    manager.addDishToQueue(orders[1], 10);
+    manager.addDishToQueue(orders[2]);
+    manager.addDishToQueue(orders[3], 10);
+    check(manager.tryAddDishToQueue(orders[4], 20), "tryAddDishToQueue takes a deadline");
+    check(manager.tryAddDishToQueue(orders[5]), "and defaults to none");
+    manager.addDishToQueue(orders[6], StationManager::NO_DEADLINE - 1);
+    check(queuedNames(manager) == " b d e a g c f", "getDishQueue lists the dishes as they will be taken");
+    check(takenNames(manager) == " b d e a g c f", "taken by deadline, ties in arrival order");
+
+    manager.setQueueDiscipline(StationManager::FIFO);
+    manager.addDishToQueue(orders[0], 30);
+    manager.addDishToQueue(orders[1], 10);
+    manager.addDishToQueue(orders[2]);
+    check(takenNames(manager) == " a b c", "FIFO takes them in arrival order");
+    deleteStations(manager);
+    for (Dish* order : orders) {
+        delete order;
+    }
+}
+
+// Paella, with or without saffron: the station only makes the one with it.
+Dish* newPaella(bool saffron) {
+    std::vector<Ingredient> ingredients = {Ingredient("Rice", 1, 1, 1.0)};
+    if (saffron) {
+        ingredients.push_back(Ingredient("Saffron", 1, 1, 1.0));
+    }
+    return newAppetizer("Paella", ingredients, 5);
+}
+
+// A dish that fails is parked until stock it lacked comes in, whether from
+// a restock, a backup ingredient or a station restocked directly.
+void checkParkingWakesOnStock(int threads) {
+    CaptureCout trace;
+    KitchenStation* station = new KitchenStation("S");
+    station->assignDishToStation(newPaella(true));
+    station->replenishStationIngredients(Ingredient("Rice", 100, 0, 1.0));
+    {
+        StationManager manager;
+        manager.addStation(station);
+        manager.setWorkerThreads(threads);
+        manager.setRetryParking(true);
+        Dish* order = newPaella(false);
+        manager.addDishToQueue(order);
+        manager.processAllDishes();
+        check(manager.getParkedDishCount() == 1 && manager.getDishQueueSize() == 1, "a failed dish is parked");
+        check(manager.getDishQueue().size() == 1 && manager.getDishQueue().front() == order,
+              "getDishQueue lists parked dishes");
+        long probes = manager.getRoutingStats().failed_probes;
+        trace.clear();
+        manager.processAllDishes();
+        check(countOf(trace.text(), "PREPARING") == 0 && manager.getRoutingStats().failed_probes == probes,
+              "a pass skips a parked dish");
+        check(!manager.prepareNextDish(), "prepareNextDish skips a parked dish");
+        manager.replenishIngredientAtStation("S", Ingredient("Rice", 5, 0, 1.0));
+        check(manager.getParkedDishCount() == 1, "stock the dish did not lack does not wake it");
+        manager.addBackupIngredient(Ingredient("Saffron", 3, 0, 1.0));
+        check(manager.getParkedDishCount() == 0 && manager.getDishQueueSize() == 1, "a backup ingredient wakes it");
+        trace.clear();
+        manager.processAllDishes();
+        check(countOf(trace.text(), "PREPARING") == 1 && manager.getParkedDishCount() == 1,
+              "a woken dish is tried once, and parked again");
+        station->replenishStationIngredients(Ingredient("Saffron", 1, 0, 1.0));
+        check(manager.getParkedDishCount() == 0, "restocking the station directly wakes it");
+        check(manager.prepareNextDish() && manager.getDishQueueSize() == 0, "the woken dish is prepared");
+        manager.setRetryParking(false);
+        delete order;
+    }
+    // the station outlives the manager it notified
+    station->replenishStationIngredients(Ingredient("Saffron", 1, 0, 1.0));
+    delete station;
+}
+
+// With a backoff, a parked dish is also retried after that many ticks, then
+// after twice as many.
+void checkParkingBackoff() {
+    CaptureCout trace;
+    StationManager manager;
+    KitchenStation* station = new KitchenStation("S");
+    station->assignDishToStation(newPaella(true));
+    station->replenishStationIngredients(Ingredient("Rice", 100, 0, 1.0));
+    manager.addStation(station);
+    manager.setRetryParking(true);
+    manager.setRetryBackoff(10);
+    manager.addDishToQueue(newPaella(false));
+    manager.processAllDishes();
+    manager.advanceSimulatedTime(9);
+    manager.processAllDishes();
+    check(manager.getParkedDishCount() == 1, "not retried before the backoff");
+    trace.clear();
+    manager.advanceSimulatedTime(1);
+    manager.processAllDishes();
+    check(countOf(trace.text(), "PREPARING") == 1 && manager.getParkedDishCount() == 1,
+          "retried once the backoff has passed");
+    manager.advanceSimulatedTime(19);
+    manager.processAllDishes();
+    trace.clear();
+    manager.advanceSimulatedTime(1);
+    manager.processAllDishes();
+    check(countOf(trace.text(), "PREPARING") == 1, "the next retry waits twice as long");
+    manager.setRetryParking(false);
+    check(manager.getParkedDishCount() == 0 && manager.getDishQueueSize() == 1,
+          "turning parking off puts parked dishes back");
+    trace.clear();
+    manager.processAllDishes();
+    check(countOf(trace.text(), "PREPARING") == 1, "and the next pass tries them");
+    manager.setRetryParking(true);
+    manager.processAllDishes();
+    manager.clearDishQueue();
+    check(manager.getParkedDishCount() == 0 && manager.getDishQueueSize() == 0, "clearDishQueue drops parked dishes");
+    deleteStations(manager);
+}
+
+// Parking under a heap discipline, and a dish no station makes, which no
+// restock can help and so is not parked.
+void checkParkingOtherQueues() {
+    CaptureCout quiet;
+    StationManager manager;
+    KitchenStation* station = new KitchenStation("S");
+    station->assignDishToStation(newPaella(true));
+    station->replenishStationIngredients(Ingredient("Rice", 100, 0, 1.0));
+    manager.addStation(station);
+    manager.setRetryParking(true);
+    manager.setQueueDiscipline(StationManager::SHORTEST_PREP_FIRST);
+    Dish* order = newPaella(false);
+    manager.addDishToQueue(order);
+    manager.processAllDishes();
+    check(manager.getParkedDishCount() == 1, "a heap-ordered dish is parked");
+    station->replenishStationIngredients(Ingredient("Saffron", 1, 0, 1.0));
+    check(manager.prepareNextDish(), "and woken by a restock");
+    delete order;
+    manager.addDishToQueue(newAppetizer("Nothing", {}));
+    manager.processAllDishes();
+    check(manager.getParkedDishCount() == 0 && manager.getDishQueueSize() == 1, "a dish with no station is not parked");
+    manager.clearDishQueue();
+    manager.setRetryParking(false);
+    deleteStations(manager);
+}
+
+// Sends std::cout to a string, like CaptureCout, and runs an action the
+// first time the text contains cue: a hook into the middle of a pass.
+class CueCout : public std::stringbuf {
+public:
+    CueCout(const std::string& cue, std::function<void()> action)
+        : cue_(cue), action_(action), old_(std::cout.rdbuf(this)) {}
+    ~CueCout() { std::cout.rdbuf(old_); }
+
+protected:
+    std::streamsize xsputn(const char* text, std::streamsize count) override {
+        std::streamsize written = std::stringbuf::xsputn(text, count);
+        if (action_ && str().find(cue_) != std::string::npos) {
+            std::function<void()> action = std::move(action_);
+            action_ = nullptr;
+            action();
+        }
+        return written;
+    }
+
+private:
+    std::string cue_;
+    std::function<void()> action_;
+    std::streambuf* old_;
+};
+
+// A pass takes the dishes queued when it starts. Parked dishes hold queue
+// slots but are not among them, so neither a dish added during the pass nor
+// parked dishes a restock wakes during it are tried until the next pass.
+void checkPassLeavesLateDishes(StationManager::QueueDiscipline discipline) {
+    StationManager manager;
+    KitchenStation* station = new KitchenStation("S");
+    station->assignDishToStation(newPaella(true));
+    station->assignDishToStation(newAppetizer("Soup", {Ingredient("Rice", 1, 1, 1.0)}, 1));
+    station->replenishStationIngredients(Ingredient("Rice", 100, 0, 1.0));
+    manager.addStation(station);
+    manager.setRetryParking(true);
+    manager.setQueueDiscipline(discipline);
+    Dish* paella = newPaella(false);
+    Dish* soup = newAppetizer("Soup", {Ingredient("Rice", 1, 1, 1.0)}, 1);
+    std::string trace;
+    {
+        CaptureCout quiet;
+        for (int i = 0; i < 3; i++) {
+            manager.addDishToQueue(paella);
+        }
+        manager.processAllDishes();
+    }
+    check(manager.getParkedDishCount() == 3, "three dishes are parked");
+    {
+        CueCout hook("PREPARING", [&] {
+            manager.addDishToQueue(soup);
+            station->replenishStationIngredients(Ingredient("Saffron", 10, 0, 1.0));
+        });
+        manager.addDishToQueue(soup);
+        manager.addDishToQueue(soup);
+        manager.processAllDishes();
+        trace = hook.str();
+    }
+    check(countOf(trace, "PREPARING") == 2, "only the two dishes queued at the start are tried");
+    check(manager.getParkedDishCount() == 0 && manager.getDishQueueSize() == 4,
+          "the late dish and the woken ones wait for the next pass");
+    {
+        CaptureCout quiet;
+        manager.processAllDishes();
+    }
+    check(manager.getDishQueueSize() == 0, "the next pass makes them");
+    manager.setRetryParking(false);
+    deleteStations(manager);
+    delete paella;
+    delete soup;
+}
+
+// What a station's stock should be, kept the plain way: a vector in the
+// order ingredients were first stocked, searched by name, an entry dropped
+// when it runs out. Recipes hold no ingredient twice.
+class StockModel {
+public:
+    void restock(const Ingredient& ingredient) {
+        Ingredient* stocked = find(ingredient.name);
+        if (stocked == nullptr) {
+            stock_.push_back(ingredient);
+        } else {
+            stocked->quantity += ingredient.quantity;
+        }
+    }
+
+    bool canMake(const std::vector<Ingredient>& recipe) {
+        for (const Ingredient& ingredient : recipe) {
+            Ingredient* stocked = find(ingredient.name);
+            if (stocked == nullptr || stocked->quantity < ingredient.required_quantity) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool make(const std::vector<Ingredient>& recipe) {
+        if (!canMake(recipe)) {
+            return false;
+        }
+        for (const Ingredient& ingredient : recipe) {
+            if (find(ingredient.name)->quantity < ingredient.quantity) {
+                return false;
+            }
+        }
+        for (const Ingredient& ingredient : recipe) {
+            Ingredient* stocked = find(ingredient.name);
+            stocked->quantity -= ingredient.required_quantity;
+            if (stocked->quantity == 0) {
+                stock_.erase(stock_.begin() + (stocked - stock_.data()));
+            }
+        }
+        return true;
+    }
+
+    bool matches(const std::vector<Ingredient>& stock) const {
+        if (stock.size() != stock_.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < stock.size(); i++) {
+            if (stock[i].name != stock_[i].name || stock[i].quantity != stock_[i].quantity) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    std::vector<Ingredient> stock_;
+
+    Ingredient* find(const std::string& name) {
+        for (Ingredient& stocked : stock_) {
+            if (stocked.name == name) {
+                return &stocked;
+            }
+        }
+        return nullptr;
+    }
+};
+
+// Random restocks, checks, preparations and recipe changes on a station
+// and on the model: the compiled recipes must stay bound to the right stock
+// entries as entries run out and come back.
+void checkStockMatchesModel() {
+    const char* ingredient_names[] = {"Salt", "Flour", "Egg", "Milk", "Beef", "Rice"};
+    const char* dish_names[] = {"Soup", "Stew", "Pie", "Cake"};
+    std::mt19937 rng(11);
+    auto randomRecipe = [&] {
+        std::vector<Ingredient> recipe;
+        int count = rng() % 4;
+        int first = rng() % 6;
+        for (int i = 0; i < count; i++) {
+            recipe.push_back(Ingredient(ingredient_names[(first + i) % 6], rng() % 3, rng() % 3, 1.0));
+        }
+        return recipe;
+    };
+    int mismatches = 0;
+    for (int round = 0; round < 2000; round++) {
+        KitchenStation station("K");
+        StockModel model;
+        Dish* dishes[4];
+        for (int d = 0; d < 4; d++) {
+            dishes[d] = newAppetizer(dish_names[d], randomRecipe());
+            station.assignDishToStation(dishes[d]);
+        }
+        for (int step = 0; step < 200; step++) {
+            int d = rng() % 4;
+            int kind = rng() % 10;
+            if (kind < 4) {
+                Ingredient ingredient(ingredient_names[rng() % 6], rng() % 4, 1, 1.0);
+                station.replenishStationIngredients(ingredient);
+                model.restock(ingredient);
+            } else if (kind < 6) {
+                mismatches += station.canCompleteOrder(dish_names[d]) != model.canMake(dishes[d]->getIngredients());
+            } else if (kind < 9) {
+                mismatches += station.prepareDish(dish_names[d]) != model.make(dishes[d]->getIngredients());
+            } else {
+                dishes[d]->setIngredients(randomRecipe());
+            }
+            mismatches += !model.matches(station.getIngredientsStock());
+        }
+    }
+    check(mismatches == 0, "the station agrees with the model");
+}
+
+// getIngredientsStock lists atomic stock from its counters, by position,
+// including after an ingredient ran out and was dropped before the switch
+// (it gets a counter again, at 0, as a dish uses it, but is not listed).
+void checkAtomicStockListing() {
+    KitchenStation station("Grill");
+    station.assignDishToStation(newAppetizer("Toast", {Ingredient("Bread", 1, 1, 1.0)}));
+    station.assignDishToStation(newAppetizer("Soup", {Ingredient("Broth", 2, 2, 1.0), Ingredient("Salt", 1, 1, 1.0)}));
+    station.replenishStationIngredients(Ingredient("Bread", 1, 0, 1.0));
+    station.replenishStationIngredients(Ingredient("Broth", 5, 0, 1.0));
+    station.replenishStationIngredients(Ingredient("Salt", 3, 0, 1.0));
+    station.prepareDish("Toast");
+    station.setAtomicStock(true);
+    station.prepareDish("Soup");
+    station.replenishStationIngredients(Ingredient("Salt", 4, 0, 1.0));
+    std::vector<Ingredient> stock = station.getIngredientsStock();
+    check(stock.size() == 2 && stock[0].name == "Broth" && stock[0].quantity == 3 && stock[1].name == "Salt"
+              && stock[1].quantity == 6,
+          "the listing shows the counters, not those at zero");
+    station.setAtomicStock(false);
+    check(station.getIngredientsStock().size() == 2 && station.getIngredientsStock()[1].quantity == 6,
+          "and so does the map once they are copied back");
+}
+
+// Cooks take Soup (A, 2 B) and Stew (B, C) from an atomic station while a
+// restocker adds B: every unit is accounted for, and none goes below zero.
+void checkAtomicStockConserved() {
+    int wrong = 0;
+    for (int round = 0; round < 20; round++) {
+        KitchenStation station("Grill");
+        station.assignDishToStation(newAppetizer("Soup", {Ingredient("A", 1, 1, 1.0), Ingredient("B", 2, 2, 1.0)}));
+        station.assignDishToStation(newAppetizer("Stew", {Ingredient("B", 1, 1, 1.0), Ingredient("C", 1, 1, 1.0)}));
+        station.replenishStationIngredients(Ingredient("A", 500, 1, 1.0));
+        station.replenishStationIngredients(Ingredient("B", 500, 1, 1.0));
+        station.replenishStationIngredients(Ingredient("C", 300, 1, 1.0));
+        station.setAtomicStock(true);
+        SymbolId soup = SymbolTable::find("Soup");
+        SymbolId stew = SymbolTable::find("Stew");
+        std::atomic<long> soups(0);
+        std::atomic<long> stews(0);
+        std::atomic<long> restocked(0);
+        std::atomic<int> failures(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 5; t++) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 400; i++) {
+                    SymbolId dish = (t + i) % 2 ? soup : stew;
+                    KitchenStation::ConsumeStatus status = station.tryConsume(dish).status;
+                    if (status == KitchenStation::PREPARED) {
+                        (dish == soup ? soups : stews)++;
+                    } else if (status != KitchenStation::INSUFFICIENT_INGREDIENT) {
+                        failures++;
+                    }
+                    station.canCompleteOrder(dish);
+                    station.getStockQuantity(SymbolTable::find("B"));
+                }
+            });
+        }
+        threads.emplace_back([&] {
+            for (int i = 0; i < 100; i++) {
+                station.replenishStationIngredients(Ingredient("B", 3, 1, 1.0));
+                restocked += 3;
+            }
+        });
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        long a = station.getStockQuantity(SymbolTable::find("A"));
+        long b = station.getStockQuantity(SymbolTable::find("B"));
+        long c = station.getStockQuantity(SymbolTable::find("C"));
+        wrong += failures.load() > 0;
+        wrong += a != 500 - soups || b != 500 + restocked - 2 * soups - stews || c != 300 - stews;
+        station.setAtomicStock(false);
+        wrong += station.getStockQuantity(SymbolTable::find("B")) != b;
+        for (const Ingredient& stocked : station.getIngredientsStock()) {
+            wrong += stocked.quantity <= 0;
+        }
+    }
+    check(wrong == 0, "every unit is accounted for");
+}
+
+// A new ingredient can be stocked while stock is atomic; entries that ran
+// out are dropped when it is turned off.
+void checkAtomicStockNewIngredient() {
+    KitchenStation station("Pass");
+    station.assignDishToStation(newAppetizer("Toast", {Ingredient("Bread", 1, 1, 1.0)}));
+    station.setAtomicStock(true);
+    check(!station.prepareDish("Toast"), "nothing to make toast with");
+    station.replenishStationIngredients(Ingredient("Salt", 1, 1, 1.0));
+    station.replenishStationIngredients(Ingredient("Bread", 1, 1, 1.0));
+    check(station.canCompleteOrder("Toast") && station.prepareDish("Toast"), "toast once bread is stocked");
+    check(station.getIngredientsStock().size() == 1 && station.getStockQuantity(SymbolTable::find("Bread")) == 0,
+          "a counter at zero is not listed");
+    station.setAtomicStock(false);
+    check(station.getIngredientsStock().size() == 1, "and drops it when turned off");
+}
+
+// Two paellas at a station that has rice but has never stocked saffron,
+// which it must draw from the backup store. Returns what was made and
+// what is left, at the station and in the backup store.
+std::string runSaffronTopUp(bool atomic) {
+    CaptureCout quiet;
+    StationManager manager;
+    KitchenStation* station = new KitchenStation("S");
+    station->assignDishToStation(newPaella(true));
+    station->replenishStationIngredients(Ingredient("Rice", 10, 0, 1.0));
+    manager.addStation(station);
+    station->setAtomicStock(atomic);
+    manager.addBackupIngredient(Ingredient("Saffron", 3, 0, 1.0));
+    Dish* order = newPaella(true);
+    manager.addDishToQueue(order);
+    manager.addDishToQueue(order);
+    manager.processAllDishes();
+    station->setAtomicStock(false);
+    std::ostringstream outcome;
+    outcome << manager.getRoutingStats().dishes_prepared << " made, " << manager.getDishQueueSize() << " queued;";
+    for (const Ingredient& ingredient : station->getIngredientsStock()) {
+        outcome << " " << ingredient.name << " " << ingredient.quantity;
+    }
+    outcome << "; backup";
+    for (const Ingredient& ingredient : manager.getBackupIngredients()) {
+        outcome << " " << ingredient.name << " " << ingredient.quantity;
+    }
+    deleteStations(manager);
+    delete order;
+    return outcome.str();
+}
+
+// A backup top-up of an ingredient the station has never stocked works the
+// same with atomic stock as without.
+void checkAtomicTopUpMatchesPlain() {
+    std::string plain = runSaffronTopUp(false);
+    check(plain.find("2 made, 0 queued") == 0, "the plain station makes both paellas: " + plain);
+    check(runSaffronTopUp(true) == plain, "the atomic station ends the same: " + plain);
+}
+
+// Routing, with backup draws and parking on, while three threads restock an
+// atomic station on the roster: every restock reaches the parked dishes.
+void checkRoutingWhileRestocking() {
+    CaptureCout quiet;
+    StationManager manager;
+    KitchenStation* station = new KitchenStation("S");
+    Dish* stew = newAppetizer("Stew", {Ingredient("Meat", 2, 2, 1.0), Ingredient("Carrot", 1, 1, 1.0)});
+    station->assignDishToStation(stew);
+    station->replenishStationIngredients(Ingredient("Meat", 1, 0, 1.0));
+    station->replenishStationIngredients(Ingredient("Carrot", 1000, 0, 1.0));
+    manager.addStation(station);
+    manager.setRetryParking(true);
+    station->setAtomicStock(true);
+    std::vector<Dish*> orders;
+    for (int i = 0; i < 400; i++) {
+        orders.push_back(new Appetizer(*static_cast<Appetizer*>(stew)));
+    }
+    std::atomic<bool> done(false);
+    std::vector<std::thread> restockers;
+    for (int t = 0; t < 3; t++) {
+        restockers.emplace_back([&] {
+            while (!done.load()) {
+                station->replenishStationIngredients(Ingredient("Meat", 1, 0, 1.0));
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (size_t i = 0; i < orders.size(); i++) {
+        manager.addDishToQueue(orders[i]);
+        if (i % 10 == 9) {
+            manager.processAllDishes();
+        }
+    }
+    done = true;
+    for (std::thread& restocker : restockers) {
+        restocker.join();
+    }
+    station->replenishStationIngredients(Ingredient("Meat", 2000, 0, 1.0));
+    check(manager.getParkedDishCount() == 0, "a restock wakes every parked dish");
+    manager.processAllDishes();
+    check(manager.getDishQueueSize() == 0 && manager.getRoutingStats().dishes_prepared == long(orders.size()),
+          "every dish is prepared");
+    manager.setRetryParking(false);
+    deleteStations(manager);
+    for (Dish* order : orders) {
+        delete order;
+    }
+}
+
+// Four threads reserve from one backup store for their own stations and
+// commit or abort in turn: the store ends down by exactly what was
+// committed.
+void checkBackupReservationsFromThreads() {
+    StationManager manager;
+    manager.addBackupIngredient(Ingredient("Salt", 2000, 0, 1.0));
+    manager.addBackupIngredient(Ingredient("Oil", 2000, 0, 1.0));
+    Dish* dish = newAppetizer("Fry", {Ingredient("Salt", 1, 1, 1.0), Ingredient("Oil", 2, 2, 1.0)});
+    std::atomic<int> committed(0);
+    std::atomic<int> empty(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&] {
+            KitchenStation station("Fryer");
+            StationManager::BackupReservation reservation;
+            for (int i = 0; i < 250; i++) {
+                if (!manager.reserveBackupIngredients(&station, dish, reservation)) {
+                    empty++;
+                } else if (i % 2 == 0) {
+                    manager.commitBackupReservation(reservation);
+                    committed++;
+                } else {
+                    manager.abortBackupReservation(reservation);
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    std::vector<Ingredient> backup = manager.getBackupIngredients();
+    check(empty.load() == 0, "every reservation finds stock");
+    check(backup.size() == 2 && backup[0].quantity == 2000 - committed.load()
+              && backup[1].quantity == 2000 - 2 * committed.load(),
+          "the store is down by what was committed");
+    delete dish;
+}
+
+// An entry a commit used up stays in the store until the last open
+// reservation ends, so an abort meanwhile puts its stock back in place.
+void checkBackupAbortInPlace() {
+    StationManager manager;
+    manager.addBackupIngredient(Ingredient("Salt", 1, 0, 1.0));
+    manager.addBackupIngredient(Ingredient("Oil", 1, 0, 1.0));
+    KitchenStation station("Fryer");
+    Dish* salted = newAppetizer("Chips", {Ingredient("Salt", 1, 1, 1.0)});
+    Dish* fried = newAppetizer("Fry", {Ingredient("Oil", 1, 1, 1.0)});
+    StationManager::BackupReservation salt;
+    StationManager::BackupReservation oil;
+    check(manager.reserveBackupIngredients(&station, salted, salt)
+              && manager.reserveBackupIngredients(&station, fried, oil),
+          "both are reserved");
+    StationManager::BackupReservation again;
+    check(!manager.reserveBackupIngredients(&station, salted, again), "reserved stock cannot be reserved again");
+    manager.commitBackupReservation(oil);
+    check(manager.getBackupIngredients().size() == 2, "a used-up entry stays while a reservation is open");
+    manager.abortBackupReservation(salt);
+    std::vector<Ingredient> backup = manager.getBackupIngredients();
+    check(backup.size() == 1 && backup[0].name == "Salt" && backup[0].quantity == 1,
+          "the abort puts the salt back, and the oil goes once none is open");
+    delete salted;
+    delete fried;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            g_filter = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter TEXT]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    run("linked_list/insert_remove/pool", checkInsertRemove<LinkedList<int>>);
+    run("linked_list/insert_remove/heap", checkInsertRemove<LinkedList<int, HeapNodeAllocator<int>>>);
+    run("linked_list/cursor_follows_edits", checkCursorFollowsEdits<LinkedList<int>>);
+    run("linked_list/relink", checkRelinks<LinkedList<int>>);
+    run("linked_list/bulk_edits", checkBulkEdits<LinkedList<int>>);
+    run("unrolled_list/insert_remove", checkInsertRemove<UnrolledLinkedList<int, 4>>);
+    run("unrolled_list/cursor_follows_edits", checkCursorFollowsEdits<UnrolledLinkedList<int, 4>>);
+    run("unrolled_list/relink", checkRelinks<UnrolledLinkedList<int, 4>>);
+    run("unrolled_list/bulk_edits", checkBulkEdits<UnrolledLinkedList<int, 4>>);
+    run("intrusive_list/insert_remove", checkInsertRemove<IntrusiveInts>);
+    run("intrusive_list/cursor_follows_edits", checkCursorFollowsEdits<IntrusiveInts>);
+    run("intrusive_list/relink", checkRelinks<IntrusiveInts>);
+    run("intrusive_list/bulk_edits", checkBulkEdits<IntrusiveInts>);
+    run("intrusive_list/remove_entry", checkIntrusiveRemoveEntry);
+    run("node_pool/slab_reuse", checkSlabReuse);
+    run("node_pool/cross_thread_free", checkCrossThreadFree);
+    run("symbols/growth", checkSymbolGrowth);
+    run("symbols/from_threads", checkSymbolsFromThreads);
+    run("flat_hash_map/wrapped_erase", checkFlatMapWrappedErase);
+    run("flat_hash_map/compaction", checkFlatMapCompaction);
+    run("flat_hash_map/reinsert_order", checkFlatMapReinsertOrder);
+    run("roster/const_reads_from_threads", checkRosterReadsFromThreads);
+    run("roster/concurrent_list_appends", checkConcurrentListAppends);
+    run("roster/lock_free_mirror", checkRosterMirror);
+    run("roster/append_stations", checkAppendStations);
+    run("roster/name_index", checkNameIndex);
+    run("roster/dish_index", checkDishIndex);
+    run("routing/adaptive_move_to_front", checkAdaptiveMoveToFront);
+    run("routing/earliest_finish", checkEarliestFinish);
+    run("routing/inventory_cost_weighs_demand", checkInventoryCostWeighsDemand);
+    run("parallel_pass/matches_serial", checkParallelMatchesSerial);
+    run("parallel_pass/small_kitchen", [] {
+        std::string serial = runSmallKitchen(1, false);
+        check(serial.find("Successfully prepared Dish a.") != std::string::npos, "the serial pass traces its dishes");
+        for (int threads : {2, 4}) {
+            check(runSmallKitchen(threads, false) == serial, "traced, threads " + std::to_string(threads));
+        }
+    });
+    run("parallel_pass/quiet_trace", [] {
+        std::string serial = runSmallKitchen(1, true);
+        check(serial.substr(serial.find('\n')) == "\n0", "nothing is traced while std::cout is failed");
+        for (int threads : {2, 4}) {
+            check(runSmallKitchen(threads, true) == serial, "quiet, threads " + std::to_string(threads));
+        }
+    });
+    run("binary_heap/order", checkBinaryHeap);
+    run("dish_queue/mpmc_each_entry_once", checkQueueHandsOutEachEntryOnce);
+    run("dish_queue/mpmc_reserve", checkQueueReserve);
+    run("dish_queue/producers_and_consumers", checkManagerProducersAndConsumers);
+    run("dish_queue/full/serial", [] { checkFullQueue(1); });
+    run("dish_queue/full/threads_4", [] { checkFullQueue(4); });
+    run("dish_queue/one_thread_overfills", checkOneThreadOverfillsQueue);
+    run("dish_queue/clear_while_routing", checkClearWhileRouting);
+    run("dish_queue/grows_while_in_use", checkQueueGrowsWhileInUse);
+    run("queue_discipline/shortest_prep_first", checkShortestPrepFirst);
+    run("queue_discipline/earliest_deadline_first", checkEarliestDeadlineFirst);
+    run("parking/wakes_on_stock/serial", [] { checkParkingWakesOnStock(1); });
+    run("parking/wakes_on_stock/threads_4", [] { checkParkingWakesOnStock(4); });
+    run("parking/backoff", checkParkingBackoff);
+    run("parking/other_queues", checkParkingOtherQueues);
+    run("parking/pass_leaves_late_dishes/fifo", [] { checkPassLeavesLateDishes(StationManager::FIFO); });
+    run("parking/pass_leaves_late_dishes/shortest_prep", [] {
+        checkPassLeavesLateDishes(StationManager::SHORTEST_PREP_FIRST);
+    });
+    run("station/stock_matches_model", checkStockMatchesModel);
+    run("atomic_stock/listing", checkAtomicStockListing);
+    run("atomic_stock/conserved", checkAtomicStockConserved);
+    run("atomic_stock/new_ingredient", checkAtomicStockNewIngredient);
+    run("atomic_stock/top_up_matches_plain", checkAtomicTopUpMatchesPlain);
+    run("atomic_stock/routing_while_restocking", checkRoutingWhileRestocking);
+    run("backup/reservations_from_threads", checkBackupReservationsFromThreads);
+    run("backup/abort_in_place", checkBackupAbortInPlace);
+    run("roster/snapshot_isolation", checkSnapshotIsolation);
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
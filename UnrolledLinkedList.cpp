@@ -0,0 +1,845 @@
+/** ADT list: unrolled (chunked) linked list implementation.
+
+ Implementation file for UnrolledNode, UnrolledListIterator and UnrolledLinkedList.
+ @file UnrolledLinkedList.cpp */
+
+#include "UnrolledLinkedList.hpp"  // Header file
+#include <new>
+#include <string>
+
+
+/************* NODE ************/
+
+
+//default constructor
+template<class T, int NodeCapacity>
+UnrolledNode<T, NodeCapacity>::UnrolledNode() : count_(0), next_(nullptr)
+{
+}  // end default constructor
+
+
+//destructor
+template<class T, int NodeCapacity>
+UnrolledNode<T, NodeCapacity>::~UnrolledNode()
+{
+   for (int i = 0; i < count_; i++)
+      slot(i)->~T();
+}  // end destructor
+
+
+template<class T, int NodeCapacity>
+int UnrolledNode<T, NodeCapacity>::getCount() const
+{
+   return count_;
+}  // end getCount
+
+
+template<class T, int NodeCapacity>
+bool UnrolledNode<T, NodeCapacity>::isFull() const
+{
+   return count_ == NodeCapacity;
+}  // end isFull
+
+
+template<class T, int NodeCapacity>
+const T& UnrolledNode<T, NodeCapacity>::getItem(int index) const
+{
+   return *slot(index);
+}  // end getItem
+
+
+template<class T, int NodeCapacity>
+T& UnrolledNode<T, NodeCapacity>::getItem(int index)
+{
+   return *slot(index);
+}  // end getItem
+
+
+template<class T, int NodeCapacity>
+UnrolledNode<T, NodeCapacity>* UnrolledNode<T, NodeCapacity>::getNext() const
+{
+   return next_;
+}  // end getNext
+
+
+template<class T, int NodeCapacity>
+void UnrolledNode<T, NodeCapacity>::setNext(UnrolledNode<T, NodeCapacity>* next_node_ptr)
+{
+   next_ = next_node_ptr;
+}  // end setNext
+
+
+/** @post an entry built from args is at index; later entries shift up by one */
+template<class T, int NodeCapacity>
+template<class... Args>
+void UnrolledNode<T, NodeCapacity>::insertAt(int index, Args&&... args)
+{
+   // Build the entry first so a throwing constructor leaves the node untouched
+   T new_entry(std::forward<Args>(args)...);
+   if (index == count_)
+   {
+      new (slot(count_)) T(std::move(new_entry));
+   }
+   else
+   {
+      new (slot(count_)) T(std::move(*slot(count_ - 1)));
+      for (int i = count_ - 1; i > index; i--)
+         *slot(i) = std::move(*slot(i - 1));
+      *slot(index) = std::move(new_entry);
+   }  // end if
+   count_++;
+}  // end insertAt
+
+
+/** @post the entry at index is destroyed; later entries shift down by one */
+template<class T, int NodeCapacity>
+void UnrolledNode<T, NodeCapacity>::removeAt(int index)
+{
+   for (int i = index; i < count_ - 1; i++)
+      *slot(i) = std::move(*slot(i + 1));
+   slot(count_ - 1)->~T();
+   count_--;
+}  // end removeAt
+
+
+/** @post entries [from, getCount()) are moved, in order, to the end of other */
+template<class T, int NodeCapacity>
+void UnrolledNode<T, NodeCapacity>::moveTailTo(int from, UnrolledNode<T, NodeCapacity>& other)
+{
+   for (int i = from; i < count_; i++)
+   {
+      new (other.slot(other.count_)) T(std::move(*slot(i)));
+      other.count_++;
+      slot(i)->~T();
+   }  // end for
+   count_ = from;
+}  // end moveTailTo
+
+
+template<class T, int NodeCapacity>
+T* UnrolledNode<T, NodeCapacity>::slot(int index)
+{
+   return std::launder(reinterpret_cast<T*>(&items_[index]));
+}  // end slot
+
+
+template<class T, int NodeCapacity>
+const T* UnrolledNode<T, NodeCapacity>::slot(int index) const
+{
+   return std::launder(reinterpret_cast<const T*>(&items_[index]));
+}  // end slot
+
+
+
+/************* ITERATOR ************/
+
+
+template<class T, int NodeCapacity, bool IsConst>
+UnrolledListIterator<T, NodeCapacity, IsConst>::UnrolledListIterator() : node_ptr_(nullptr), index_(0)
+{
+}  // end default constructor
+
+
+template<class T, int NodeCapacity, bool IsConst>
+UnrolledListIterator<T, NodeCapacity, IsConst>::UnrolledListIterator(UnrolledNode<T, NodeCapacity>* node_ptr, int index)
+   : node_ptr_(node_ptr), index_(index)
+{
+}  // end constructor
+
+
+template<class T, int NodeCapacity, bool IsConst>
+typename UnrolledListIterator<T, NodeCapacity, IsConst>::reference
+UnrolledListIterator<T, NodeCapacity, IsConst>::operator*() const
+{
+   return node_ptr_->getItem(index_);
+}  // end operator*
+
+
+template<class T, int NodeCapacity, bool IsConst>
+typename UnrolledListIterator<T, NodeCapacity, IsConst>::pointer
+UnrolledListIterator<T, NodeCapacity, IsConst>::operator->() const
+{
+   return &node_ptr_->getItem(index_);
+}  // end operator->
+
+
+template<class T, int NodeCapacity, bool IsConst>
+UnrolledListIterator<T, NodeCapacity, IsConst>& UnrolledListIterator<T, NodeCapacity, IsConst>::operator++()
+{
+   index_++;
+   if (index_ == node_ptr_->getCount())
+   {
+      node_ptr_ = node_ptr_->getNext();
+      index_ = 0;
+   }  // end if
+   return *this;
+}  // end operator++
+
+
+template<class T, int NodeCapacity, bool IsConst>
+UnrolledListIterator<T, NodeCapacity, IsConst> UnrolledListIterator<T, NodeCapacity, IsConst>::operator++(int)
+{
+   UnrolledListIterator<T, NodeCapacity, IsConst> previous = *this;
+   ++(*this);
+   return previous;
+}  // end operator++
+
+
+template<class T, int NodeCapacity, bool IsConst>
+bool UnrolledListIterator<T, NodeCapacity, IsConst>::operator==(const UnrolledListIterator<T, NodeCapacity, IsConst>& rhs) const
+{
+   return node_ptr_ == rhs.node_ptr_ && index_ == rhs.index_;
+}  // end operator==
+
+
+template<class T, int NodeCapacity, bool IsConst>
+bool UnrolledListIterator<T, NodeCapacity, IsConst>::operator!=(const UnrolledListIterator<T, NodeCapacity, IsConst>& rhs) const
+{
+   return !(*this == rhs);
+}  // end operator!=
+
+
+template<class T, int NodeCapacity, bool IsConst>
+UnrolledNode<T, NodeCapacity>* UnrolledListIterator<T, NodeCapacity, IsConst>::getNode() const
+{
+   return node_ptr_;
+}  // end getNode
+
+
+template<class T, int NodeCapacity, bool IsConst>
+int UnrolledListIterator<T, NodeCapacity, IsConst>::getIndex() const
+{
+   return index_;
+}  // end getIndex
+
+
+
+/************* LIST ************/
+
+
+// constructor
+template<class T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>::UnrolledLinkedList()
+   : head_ptr_(nullptr), tail_ptr_(nullptr), item_count_(0), cursor_ptr_(nullptr), cursor_prev_(nullptr),
+     cursor_first_(0)
+{
+}  // end default constructor
+
+
+// copy constructor
+template<class T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>::UnrolledLinkedList(const UnrolledLinkedList<T, NodeCapacity>& a_list)
+   : UnrolledLinkedList()
+{
+   try
+   {
+      for (const T& entry : a_list)
+         insertAt(item_count_, entry);
+   }
+   catch (...)
+   {
+      clear();
+      throw;
+   }  // end try
+}  // end copy constructor
+
+
+// move constructor
+template<class T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>::UnrolledLinkedList(UnrolledLinkedList<T, NodeCapacity>&& a_list) noexcept
+   : UnrolledLinkedList()
+{
+   swap(a_list);
+}  // end move constructor
+
+
+// destructor
+template<class T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>::~UnrolledLinkedList()
+{
+   clear();
+}  // end destructor
+
+
+// copy assignment: copy first, then swap, so a throwing copy leaves this list unchanged
+template<class T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>& UnrolledLinkedList<T, NodeCapacity>::operator=(const UnrolledLinkedList<T, NodeCapacity>& a_list)
+{
+   if (this != &a_list)
+   {
+      UnrolledLinkedList<T, NodeCapacity> copy(a_list);
+      swap(copy);
+   }  // end if
+   return *this;
+}  // end operator=
+
+
+// move assignment
+template<class T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>& UnrolledLinkedList<T, NodeCapacity>::operator=(UnrolledLinkedList<T, NodeCapacity>&& a_list) noexcept
+{
+   if (this != &a_list)
+   {
+      clear();
+      swap(a_list);
+   }  // end if
+   return *this;
+}  // end operator=
+
+
+template<class T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::swap(UnrolledLinkedList<T, NodeCapacity>& a_list) noexcept
+{
+   std::swap(head_ptr_, a_list.head_ptr_);
+   std::swap(tail_ptr_, a_list.tail_ptr_);
+   std::swap(item_count_, a_list.item_count_);
+   std::swap(cursor_ptr_, a_list.cursor_ptr_);
+   std::swap(cursor_prev_, a_list.cursor_prev_);
+   std::swap(cursor_first_, a_list.cursor_first_);
+}  // end swap
+
+
+/**@return true if list is empty - item_count_ == 0 */
+template<class T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::isEmpty() const
+{
+   return item_count_ == 0;
+}  // end isEmpty
+
+
+/**@return the number of items in the list - item_count_ */
+template<class T, int NodeCapacity>
+int UnrolledLinkedList<T, NodeCapacity>::getLength() const
+{
+   return item_count_;
+}  // end getLength
+
+
+template<class T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::insert(int position, const T& new_entry)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_);
+   if (able_to_insert)
+      insertAt(position, new_entry);
+
+   return able_to_insert;
+}  // end insert
+
+
+template<class T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::insert(int position, T&& new_entry)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_);
+   if (able_to_insert)
+      insertAt(position, std::move(new_entry));
+
+   return able_to_insert;
+}  // end insert
+
+
+template<class T, int NodeCapacity>
+template<class... Args>
+bool UnrolledLinkedList<T, NodeCapacity>::emplace(int position, Args&&... args)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_);
+   if (able_to_insert)
+      insertAt(position, std::forward<Args>(args)...);
+
+   return able_to_insert;
+}  // end emplace
+
+
+template<class T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::pushBack(const T& new_entry)
+{
+   insertAt(item_count_, new_entry);
+}  // end pushBack
+
+
+template<class T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::pushBack(T&& new_entry)
+{
+   insertAt(item_count_, std::move(new_entry));
+}  // end pushBack
+
+
+// Range insert: the entries are packed into nodes of their own first, so a
+// throwing copy leaves this list unchanged, then the nodes are spliced in.
+template<class T, int NodeCapacity>
+template<class InputIterator, class>
+bool UnrolledLinkedList<T, NodeCapacity>::insert(int position, InputIterator first, InputIterator last)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_);
+   if (able_to_insert)
+   {
+      UnrolledLinkedList<T, NodeCapacity> chunk;
+      for (; first != last; ++first)
+         chunk.pushBack(*first);
+      spliceListAt(position, chunk);
+   }  // end if
+
+   return able_to_insert;
+}  // end insert
+
+
+template<class T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::insert(int position, std::initializer_list<T> entries)
+{
+   return insert(position, entries.begin(), entries.end());
+}  // end insert
+
+
+template<class T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::append(UnrolledLinkedList<T, NodeCapacity>&& a_list)
+{
+   if (this != &a_list)
+      spliceListAt(item_count_, a_list);
+}  // end append
+
+
+/**
+ @post entry at position is deleted, if any. List order is retained
+ @return true if there is an entry at position to be deleted, false otherwise */
+template<class T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::remove(int position)
+{
+   bool able_to_remove = (position >= 0) && (position < item_count_);
+   if (!able_to_remove)
+      return false;
+
+   int offset = 0;
+   NodeType* node_ptr = locate(position, offset);
+   node_ptr->removeAt(offset);
+   item_count_--;
+   if (cursor_ptr_ != node_ptr && cursor_first_ > position)
+      cursor_first_--;
+
+   // Keep nodes at least half full: pull the next node in when both fit in one
+   NodeType* next_ptr = node_ptr->getNext();
+   if (next_ptr != nullptr && node_ptr->getCount() + next_ptr->getCount() <= NodeCapacity
+       && node_ptr->getCount() < NodeCapacity / 2)
+   {
+      next_ptr->moveTailTo(0, *node_ptr);
+      node_ptr->setNext(next_ptr->getNext());
+      if (tail_ptr_ == next_ptr)
+         tail_ptr_ = node_ptr;
+      if (cursor_ptr_ == next_ptr)
+         resetCursor();
+      else if (cursor_prev_ == next_ptr)
+         cursor_prev_ = node_ptr;
+      delete next_ptr;
+   }  // end if
+
+   // Only an empty tail can remain; unlink it
+   if (node_ptr->getCount() == 0)
+   {
+      if (node_ptr == head_ptr_)
+      {
+         head_ptr_ = nullptr;
+         tail_ptr_ = nullptr;
+      }
+      else
+      {
+         // locate() left the cursor on node_ptr, so its predecessor is usually known
+         NodeType* prev_ptr = head_ptr_;
+         if (cursor_ptr_ == node_ptr && cursor_prev_ != nullptr)
+            prev_ptr = cursor_prev_;
+         while (prev_ptr->getNext() != node_ptr)
+            prev_ptr = prev_ptr->getNext();
+         prev_ptr->setNext(nullptr);
+         tail_ptr_ = prev_ptr;
+
+         // Keep the cursor at the end of the list, where the next access likely is
+         cursor_ptr_ = prev_ptr;
+         cursor_prev_ = nullptr;
+         cursor_first_ = item_count_ - prev_ptr->getCount();
+      }  // end if
+      if (cursor_ptr_ == node_ptr)
+         resetCursor();
+      delete node_ptr;
+   }  // end if
+
+   return true;
+}  // end remove
+
+
+/**@post the list is empty and item_count_ == 0*/
+template<class T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::clear()
+{
+   while (head_ptr_ != nullptr)
+   {
+      NodeType* next_ptr = head_ptr_->getNext();
+      delete head_ptr_;
+      head_ptr_ = next_ptr;
+   }  // end while
+   tail_ptr_ = nullptr;
+   item_count_ = 0;
+   resetCursor();
+}  // end clear
+
+
+template<class T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::moveToFront(int position)
+{
+   bool able_to_move = (position >= 0) && (position < item_count_);
+   if (able_to_move)
+      rotateRight(0, position);
+
+   return able_to_move;
+}  // end moveToFront
+
+
+template<class T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::moveAfter(int position, int target_position)
+{
+   bool able_to_move = (position >= 0) && (position < item_count_) &&
+                       (target_position >= 0) && (target_position < item_count_) &&
+                       (position != target_position);
+   if (able_to_move)
+   {
+      if (target_position < position)
+         rotateRight(target_position + 1, position);
+      else
+         rotateLeft(position, target_position);
+   }  // end if
+
+   return able_to_move;
+}  // end moveAfter
+
+
+template<class T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::swapEntries(int position_a, int position_b)
+{
+   bool able_to_swap = (position_a >= 0) && (position_a < item_count_) &&
+                       (position_b >= 0) && (position_b < item_count_);
+   if (able_to_swap && position_a != position_b)
+   {
+      using std::swap;
+      if (position_b < position_a)
+         swap(position_a, position_b);
+      T& entry_a = getEntry(position_a);
+      swap(entry_a, getEntry(position_b));
+   }  // end if
+
+   return able_to_swap;
+}  // end swapEntries
+
+
+template<class T, int NodeCapacity>
+template<class Predicate>
+int UnrolledLinkedList<T, NodeCapacity>::moveToFrontIf(Predicate pred)
+{
+   int position = 0;
+   for (const T& entry : *this)
+   {
+      if (pred(entry))
+      {
+         rotateRight(0, position);
+         return position;
+      }  // end if
+      position++;
+   }  // end for
+
+   return -1;
+}  // end moveToFrontIf
+
+
+/**
+ @return data item found at position. If position is not a valid position < item_count_
+ throws  PrecondViolatedExcep */
+template<class T, int NodeCapacity>
+const T& UnrolledLinkedList<T, NodeCapacity>::getEntry(int position) const
+{
+   bool able_to_get = (position >= 0) && (position < item_count_);
+   if (!able_to_get)
+   {
+      std::string message = "getEntry() called with an empty list or ";
+      message = message + "invalid position.";
+      throw(PrecondViolatedExcep(message));
+   }  // end if
+
+   int offset = 0;
+   NodeType* node_ptr = locate(position, offset);
+   return node_ptr->getItem(offset);
+}  // end getEntry
+
+
+template<class T, int NodeCapacity>
+T& UnrolledLinkedList<T, NodeCapacity>::getEntry(int position)
+{
+   if ((position < 0) || (position >= item_count_))
+   {
+      // the const lookup throws the same exception
+      const UnrolledLinkedList<T, NodeCapacity>& self = *this;
+      self.getEntry(position);
+   }  // end if
+
+   int offset = 0;
+   NodeType* node_ptr = locate(position, offset);
+   return node_ptr->getItem(offset);
+}  // end getEntry
+
+
+template<class T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::NodeType* UnrolledLinkedList<T, NodeCapacity>::getHeadNode() const
+{
+   return head_ptr_;
+}  // end getHeadNode
+
+
+template<class T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::iterator UnrolledLinkedList<T, NodeCapacity>::begin()
+{
+   return iterator(head_ptr_, 0);
+}  // end begin
+
+
+template<class T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::const_iterator UnrolledLinkedList<T, NodeCapacity>::begin() const
+{
+   return const_iterator(head_ptr_, 0);
+}  // end begin
+
+
+template<class T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::const_iterator UnrolledLinkedList<T, NodeCapacity>::cbegin() const
+{
+   return const_iterator(head_ptr_, 0);
+}  // end cbegin
+
+
+template<class T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::iterator UnrolledLinkedList<T, NodeCapacity>::end()
+{
+   return iterator();
+}  // end end
+
+
+template<class T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::const_iterator UnrolledLinkedList<T, NodeCapacity>::end() const
+{
+   return const_iterator();
+}  // end end
+
+
+template<class T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::const_iterator UnrolledLinkedList<T, NodeCapacity>::cend() const
+{
+   return const_iterator();
+}  // end cend
+
+
+
+/************* PROTECTED METHODS ************/
+
+
+// Finds the node holding position and leaves the cursor on it.
+template<class T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::NodeType* UnrolledLinkedList<T, NodeCapacity>::locate(int position, int& offset)
+{
+   NodeType* prev_ptr = nullptr;
+   int first = 0;
+   NodeType* node_ptr = seek(position, prev_ptr, first);
+   cursor_ptr_ = node_ptr;
+   cursor_prev_ = prev_ptr;
+   cursor_first_ = first;
+   offset = position - first;
+   return node_ptr;
+}  // end locate
+
+
+// Finds the node holding position without moving the cursor.
+template<class T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::NodeType* UnrolledLinkedList<T, NodeCapacity>::locate(int position, int& offset) const
+{
+   NodeType* prev_ptr = nullptr;
+   int first = 0;
+   NodeType* node_ptr = seek(position, prev_ptr, first);
+   offset = position - first;
+   return node_ptr;
+}  // end locate
+
+
+// Walks to the node holding position, starting from the cursor when it is not past position.
+template<class T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::NodeType* UnrolledLinkedList<T, NodeCapacity>::seek(int position, NodeType*& prev_ptr, int& first) const
+{
+   NodeType* node_ptr = head_ptr_;
+   prev_ptr = nullptr;
+   first = 0;  // list position of node_ptr's first entry
+   if (cursor_ptr_ != nullptr && cursor_first_ <= position)
+   {
+      node_ptr = cursor_ptr_;
+      prev_ptr = cursor_prev_;
+      first = cursor_first_;
+   }  // end if
+
+   while (position - first >= node_ptr->getCount())
+   {
+      first += node_ptr->getCount();
+      prev_ptr = node_ptr;
+      node_ptr = node_ptr->getNext();
+   }  // end while
+   return node_ptr;
+}  // end seek
+
+
+// Places a new entry built from args at position, splitting a full node in two.
+template<class T, int NodeCapacity>
+template<class... Args>
+void UnrolledLinkedList<T, NodeCapacity>::insertAt(int position, Args&&... args)
+{
+   NodeType* node_ptr = nullptr;
+   int offset = 0;
+   if (head_ptr_ == nullptr)
+   {
+      node_ptr = new NodeType();
+      head_ptr_ = node_ptr;
+      tail_ptr_ = node_ptr;
+   }
+   else if (position == item_count_)
+   {
+      // Appends go straight to the tail; a full tail gets a fresh node after
+      // it rather than a split, so a roster built by appends packs its nodes
+      if (tail_ptr_->isFull())
+      {
+         NodeType* new_node_ptr = new NodeType();
+         tail_ptr_->setNext(new_node_ptr);
+         cursor_ptr_ = new_node_ptr;
+         cursor_prev_ = tail_ptr_;
+         cursor_first_ = item_count_;
+         tail_ptr_ = new_node_ptr;
+      }  // end if
+      node_ptr = tail_ptr_;
+      offset = tail_ptr_->getCount();
+   }
+   else
+   {
+      node_ptr = locate(position, offset);
+   }  // end if
+
+   if (node_ptr->isFull())
+   {
+      // Split: the upper half of the entries moves to a new node after this one
+      NodeType* new_node_ptr = new NodeType();
+      node_ptr->moveTailTo(NodeCapacity / 2, *new_node_ptr);
+      new_node_ptr->setNext(node_ptr->getNext());
+      node_ptr->setNext(new_node_ptr);
+      if (tail_ptr_ == node_ptr)
+         tail_ptr_ = new_node_ptr;
+      if (cursor_ptr_ == node_ptr)
+         resetCursor();
+      else if (cursor_prev_ == node_ptr)
+         cursor_prev_ = new_node_ptr;
+
+      if (offset > NodeCapacity / 2)
+      {
+         node_ptr = new_node_ptr;
+         offset -= NodeCapacity / 2;
+      }  // end if
+   }  // end if
+
+   node_ptr->insertAt(offset, std::forward<Args>(args)...);
+   item_count_++;
+   if (cursor_ptr_ != nullptr && cursor_ptr_ != node_ptr && cursor_first_ > position)
+      cursor_first_++;
+}  // end insertAt
+
+
+// Moves a_list's whole chain into this list at position.
+template<class T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::spliceListAt(int position, UnrolledLinkedList<T, NodeCapacity>& a_list)
+{
+   if (a_list.isEmpty())
+      return;
+
+   if (head_ptr_ == nullptr)
+   {
+      swap(a_list);
+      return;
+   }  // end if
+
+   if (position == 0)
+   {
+      a_list.tail_ptr_->setNext(head_ptr_);
+      head_ptr_ = a_list.head_ptr_;
+   }
+   else
+   {
+      // The chain goes after the entry at position - 1; entries following it
+      // in the same node move to a node of their own behind the chain
+      int offset = 0;
+      NodeType* node_ptr = locate(position - 1, offset);
+      offset++;
+      if (offset < node_ptr->getCount())
+      {
+         NodeType* rest_ptr = new NodeType();
+         node_ptr->moveTailTo(offset, *rest_ptr);
+         rest_ptr->setNext(node_ptr->getNext());
+         node_ptr->setNext(rest_ptr);
+         if (tail_ptr_ == node_ptr)
+            tail_ptr_ = rest_ptr;
+      }  // end if
+      a_list.tail_ptr_->setNext(node_ptr->getNext());
+      node_ptr->setNext(a_list.head_ptr_);
+      if (tail_ptr_ == node_ptr)
+         tail_ptr_ = a_list.tail_ptr_;
+   }  // end if
+
+   item_count_ += a_list.item_count_;
+   resetCursor();
+
+   a_list.head_ptr_ = nullptr;
+   a_list.tail_ptr_ = nullptr;
+   a_list.item_count_ = 0;
+   a_list.resetCursor();
+}  // end spliceListAt
+
+
+// Carries the entry at `to` forward from `from`, swapping it through each slot.
+template<class T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::rotateRight(int from, int to)
+{
+   if (from == to)
+      return;
+
+   using std::swap;
+   T carry = std::move(getEntry(to));
+   int offset = 0;
+   NodeType* node_ptr = locate(from, offset);
+   iterator slot_it(node_ptr, offset);
+   for (int position = from; position <= to; position++, ++slot_it)
+      swap(carry, *slot_it);
+}  // end rotateRight
+
+
+// Carries the entry at `from` backward from `to`: shifts (from, to] down one slot.
+template<class T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::rotateLeft(int from, int to)
+{
+   if (from == to)
+      return;
+
+   int offset = 0;
+   NodeType* node_ptr = locate(from, offset);
+   iterator slot_it(node_ptr, offset);
+   T carry = std::move(*slot_it);
+   iterator next_it = slot_it;
+   ++next_it;
+   for (int position = from; position < to; position++, ++slot_it, ++next_it)
+      *slot_it = std::move(*next_it);
+   *slot_it = std::move(carry);
+}  // end rotateLeft
+
+
+template<class T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::resetCursor()
+{
+   cursor_ptr_ = nullptr;
+   cursor_prev_ = nullptr;
+   cursor_first_ = 0;
+}  // end resetCursor
+
+
+//  End of implementation file.
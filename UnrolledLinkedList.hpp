@@ -0,0 +1,241 @@
+/** ADT list: unrolled (chunked) linked list implementation.
+    Each node stores up to NodeCapacity entries in a contiguous array, so a
+    scan touches one node per NodeCapacity entries instead of one per entry.
+    Offers the same positional interface as LinkedList (insert, remove,
+    getEntry, getLength, iteration) and can stand in for it as the base of
+    StationManager.
+    @file UnrolledLinkedList.hpp */
+
+#ifndef UNROLLED_LINKED_LIST_
+#define UNROLLED_LINKED_LIST_
+
+#include "PrecondViolatedExcep.hpp"
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+template<class T, int NodeCapacity>
+class UnrolledNode
+{
+public:
+   UnrolledNode();  //default constructor: no entries, no next node
+   ~UnrolledNode(); //destroys the entries held by the node
+
+   UnrolledNode(const UnrolledNode<T, NodeCapacity>&) = delete;
+   UnrolledNode<T, NodeCapacity>& operator=(const UnrolledNode<T, NodeCapacity>&) = delete;
+
+   /**@return number of entries held - at most NodeCapacity */
+   int getCount() const;
+
+   /**@return true if the node holds NodeCapacity entries */
+   bool isFull() const;
+
+   /**@pre 0 <= index < getCount()
+      @return the entry at index within this node */
+   const T& getItem(int index) const;
+   T& getItem(int index);
+
+   /**@return next_*/
+   UnrolledNode<T, NodeCapacity>* getNext() const;
+
+   /** @post sets next_ to next_node_ptr */
+   void setNext(UnrolledNode<T, NodeCapacity>* next_node_ptr);
+
+   /** @pre !isFull() and 0 <= index <= getCount()
+       @post an entry built from args is at index; later entries shift up by one */
+   template<class... Args>
+   void insertAt(int index, Args&&... args);
+
+   /** @pre 0 <= index < getCount()
+       @post the entry at index is destroyed; later entries shift down by one */
+   void removeAt(int index);
+
+   /** @post entries [from, getCount()) are moved, in order, to the end of other */
+   void moveTailTo(int from, UnrolledNode<T, NodeCapacity>& other);
+
+private:
+   typename std::aligned_storage<sizeof(T), alignof(T)>::type items_[NodeCapacity];
+   int count_;                            // number of constructed entries
+   UnrolledNode<T, NodeCapacity>* next_;  // Pointer to next node
+
+   T* slot(int index);
+   const T* slot(int index) const;
+}; // end UnrolledNode
+
+
+// Forward iterator over an unrolled chain. IsConst selects const access to items.
+template<class T, int NodeCapacity, bool IsConst>
+class UnrolledListIterator
+{
+public:
+   typedef std::forward_iterator_tag iterator_category;
+   typedef T value_type;
+   typedef std::ptrdiff_t difference_type;
+   typedef typename std::conditional<IsConst, const T*, T*>::type pointer;
+   typedef typename std::conditional<IsConst, const T&, T&>::type reference;
+
+   UnrolledListIterator(); // past-the-end iterator
+   UnrolledListIterator(UnrolledNode<T, NodeCapacity>* node_ptr, int index);
+
+   // a modifiable iterator converts to a const one
+   template<bool OtherConst, class = typename std::enable_if<IsConst && !OtherConst>::type>
+   UnrolledListIterator(const UnrolledListIterator<T, NodeCapacity, OtherConst>& other)
+      : node_ptr_(other.getNode()), index_(other.getIndex()) {}
+
+   reference operator*() const;
+   pointer operator->() const;
+   UnrolledListIterator<T, NodeCapacity, IsConst>& operator++();   // pre-increment
+   UnrolledListIterator<T, NodeCapacity, IsConst> operator++(int); // post-increment
+
+   bool operator==(const UnrolledListIterator<T, NodeCapacity, IsConst>& rhs) const;
+   bool operator!=(const UnrolledListIterator<T, NodeCapacity, IsConst>& rhs) const;
+
+   UnrolledNode<T, NodeCapacity>* getNode() const;
+   int getIndex() const;
+
+private:
+   UnrolledNode<T, NodeCapacity>* node_ptr_;
+   int index_;  // position within node_ptr_
+}; // end UnrolledListIterator
+
+
+template<class T, int NodeCapacity = 16>
+class UnrolledLinkedList
+{
+   static_assert(NodeCapacity >= 2, "an unrolled node must hold at least two entries");
+
+public:
+   typedef UnrolledNode<T, NodeCapacity> NodeType;
+   typedef UnrolledListIterator<T, NodeCapacity, false> iterator;
+   typedef UnrolledListIterator<T, NodeCapacity, true> const_iterator;
+
+   UnrolledLinkedList(); // constructor
+   UnrolledLinkedList(const UnrolledLinkedList<T, NodeCapacity>& a_list); // copy constructor
+   UnrolledLinkedList(UnrolledLinkedList<T, NodeCapacity>&& a_list) noexcept; // move constructor
+   virtual ~UnrolledLinkedList(); // destructor
+
+   UnrolledLinkedList<T, NodeCapacity>& operator=(const UnrolledLinkedList<T, NodeCapacity>& a_list);
+   UnrolledLinkedList<T, NodeCapacity>& operator=(UnrolledLinkedList<T, NodeCapacity>&& a_list) noexcept;
+   void swap(UnrolledLinkedList<T, NodeCapacity>& a_list) noexcept;
+
+   /**@return true if list is empty - item_count_ == 0 */
+   bool isEmpty() const;
+
+   /**@return the number of items in the list - item_count_ */
+   int getLength() const;
+
+   /**
+    @param position indicating point of insertion
+    @param new_entry to be inserted in list
+    @post new_entry is added at position in list (the entry previously at that position is now at position+1)
+    @return true if valid position (0 <= position <= item_count_) */
+   bool insert(int position, const T& new_entry);
+   bool insert(int position, T&& new_entry);
+
+   /** Same as insert, but the entry is built in place from args. */
+   template<class... Args>
+   bool emplace(int position, Args&&... args);
+
+   /** Bulk operations, matching LinkedList. pushBack fills the tail node in
+       place; append relinks a_list's nodes after the tail without copying. */
+   void pushBack(const T& new_entry);
+   void pushBack(T&& new_entry);
+
+   template<class InputIterator, class = typename std::iterator_traits<InputIterator>::iterator_category>
+   bool insert(int position, InputIterator first, InputIterator last);
+   bool insert(int position, std::initializer_list<T> entries);
+
+   void append(UnrolledLinkedList<T, NodeCapacity>&& a_list);
+
+   /**
+    @param position indicating point of deletion
+    @post entry at position is deleted, if any. List order is retained
+    @return true if there is an entry at position to be deleted, false otherwise */
+   bool remove(int position);
+
+   /**@post the list is empty and item_count_ == 0*/
+   void clear();
+
+   /** Reordering operations, matching LinkedList. Entries shift inside the
+       existing nodes; no node is allocated or freed.
+       @return true if the positions are valid (see LinkedList) */
+   bool moveToFront(int position);
+   bool moveAfter(int position, int target_position);
+   bool swapEntries(int position_a, int position_b);
+
+   /** Moves the first entry satisfying pred to the front.
+       @return the entry's former position, or -1 if no entry satisfies pred */
+   template<class Predicate>
+   int moveToFrontIf(Predicate pred);
+
+   /**
+    @param position indicating the position of the data to be retrieved
+    @return data item found at position. If position is not a valid position < item_count_
+            throws  PrecondViolatedExcep */
+   const T& getEntry(int position) const;
+   T& getEntry(int position);
+
+   /**@return the first node of the chain; entries are getItem(0..getCount()-1) of each node */
+   NodeType* getHeadNode() const;
+
+   iterator begin();
+   const_iterator begin() const;
+   const_iterator cbegin() const;
+   iterator end();
+   const_iterator end() const;
+   const_iterator cend() const;
+
+protected:
+   NodeType* head_ptr_;  // Pointer to first node in the chain
+   NodeType* tail_ptr_;  // Pointer to last node, so appends do not walk the chain
+   int item_count_;      // Current count of list items
+
+   // Cached node last located by the non-const locate() and the list position
+   // of its first entry, so positional access in increasing order resumes from
+   // there. cursor_prev_ is the node before it, or nullptr if it is the head or
+   // not known, so removing the cursor's node rarely walks the chain to find
+   // its predecessor. Const lookups only read it, as in LinkedList.
+   NodeType* cursor_ptr_;
+   NodeType* cursor_prev_;
+   int cursor_first_;
+
+   // Finds the node holding position.
+   // @pre 0 <= position < item_count_
+   // @param offset set to position's index inside the returned node
+   // @post the cursor refers to the returned node
+   NodeType* locate(int position, int& offset);
+
+   // Same as above, leaving the cursor where it is
+   NodeType* locate(int position, int& offset) const;
+
+   // The walk behind both: from the cursor when it is not past position,
+   // else from the head. Sets first to the list position of the returned
+   // node's first entry and prev_ptr to the node before it, if known.
+   NodeType* seek(int position, NodeType*& prev_ptr, int& first) const;
+
+   // Places a new entry built from args at position.
+   // @pre 0 <= position <= item_count_
+   template<class... Args>
+   void insertAt(int position, Args&&... args);
+
+   // Moves a_list's whole chain into this list, splitting the node that holds
+   // position when the chain goes into its middle.
+   // @pre 0 <= position <= item_count_ and a_list is not this list
+   // @post a_list's entries are at position .. and a_list is empty
+   void spliceListAt(int position, UnrolledLinkedList<T, NodeCapacity>& a_list);
+
+   // @pre 0 <= from <= to < item_count_
+   // @post the entry at `to` is at `from`; entries [from, to) moved up by one
+   void rotateRight(int from, int to);
+
+   // @pre 0 <= from <= to < item_count_
+   // @post the entry at `from` is at `to`; entries (from, to] moved down by one
+   void rotateLeft(int from, int to);
+
+   void resetCursor();
+}; // end UnrolledLinkedList
+
+#include "UnrolledLinkedList.cpp"
+#endif
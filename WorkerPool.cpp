@@ -0,0 +1,83 @@
+/**
+ * @file WorkerPool.cpp
+ * @brief Implementation of the worker thread pool.
+ *
+ * @date December 1, 2024
+ * @author kufunei
+ */
+
+#include "WorkerPool.hpp"
+
+// Default Constructor
+WorkerPool::WorkerPool() : task_(nullptr), generation_(0), running_(0), stopping_(false) {
+}
+
+// Destructor
+WorkerPool::~WorkerPool() {
+    resize(0);
+}
+
+// Stops the current threads and starts the requested number
+void WorkerPool::resize(int threads) {
+    if (threads < 0) {
+        threads = 0;
+    }
+    if (static_cast<size_t>(threads) == threads_.size()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> hold(lock_);
+        stopping_ = true;
+    }
+    started_.notify_all();
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+    threads_.clear();
+    stopping_ = false;
+    for (int worker = 1; worker <= threads; worker++) {
+        threads_.emplace_back(&WorkerPool::workLoop, this, worker, generation_);
+    }
+}
+
+int WorkerPool::size() const {
+    return static_cast<int>(threads_.size());
+}
+
+// Runs a task on every thread, the caller's included
+void WorkerPool::run(const std::function<void(int)>& task) {
+    if (threads_.empty()) {
+        task(0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> hold(lock_);
+        task_ = &task;
+        running_ = static_cast<int>(threads_.size());
+        generation_++;
+    }
+    started_.notify_all();
+    task(0);
+    std::unique_lock<std::mutex> hold(lock_);
+    finished_.wait(hold, [this] { return running_ == 0; });
+    task_ = nullptr;
+}
+
+// helper: sleeps until a run starts, takes part in it, and reports back
+void WorkerPool::workLoop(int worker, unsigned long seen) {
+    std::unique_lock<std::mutex> hold(lock_);
+    while (true) {
+        started_.wait(hold, [this, seen] { return stopping_ || generation_ != seen; });
+        if (stopping_) {
+            return;
+        }
+        seen = generation_;
+        const std::function<void(int)>& task = *task_;
+        hold.unlock();
+        task(worker);
+        hold.lock();
+        if (--running_ == 0) {
+            finished_.notify_one();
+        }
+    }
+}
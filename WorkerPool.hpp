@@ -0,0 +1,73 @@
+/**
+ * @file WorkerPool.hpp
+ * @brief A fixed set of threads that run one task together, repeatedly.
+ *
+ * The threads are started once and sleep between runs, so a caller that
+ * hands work out many times (StationManager::processAllDishes) does not pay
+ * for starting and joining threads on every call.
+ *
+ * @date December 1, 2024
+ * @author kufunei
+ */
+
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool {
+public:
+    /**
+     * Default Constructor
+     * @post: The pool has no threads; run() only uses the calling thread.
+     */
+    WorkerPool();
+
+    /**
+     * Destructor
+     * @pre: No run() is in progress.
+     * @post: Every thread of the pool has been stopped and joined.
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @param threads The number of threads to keep; 0 stops them all.
+     * @pre: No run() is in progress.
+     * @post: The pool has that many threads, sleeping until the next run().
+     */
+    void resize(int threads);
+
+    /**
+     * @return: The number of threads in the pool.
+     */
+    int size() const;
+
+    /**
+     * Runs task(worker) on every thread of the pool, as workers 1 to size(),
+     * and on the calling thread as worker 0.
+     * @post: Every call of task has returned.
+     */
+    void run(const std::function<void(int)>& task);
+
+private:
+    std::vector<std::thread> threads_;
+    std::mutex lock_;
+    std::condition_variable started_;   // a run began, or the pool stops
+    std::condition_variable finished_;  // the last pool thread of a run returned
+    const std::function<void(int)>* task_;
+    unsigned long generation_;  // number of runs so far
+    int running_;               // pool threads still in the current run
+    bool stopping_;
+
+    // helper: the loop of pool thread `worker`, which has seen `seen` runs
+    void workLoop(int worker, unsigned long seen);
+};
+
+#endif // WORKERPOOL_HPP
@@ -113,6 +113,7 @@ Can comment out test cases below
     station_manager.addDishToQueue(grill_chicken);
     station_manager.addDishToQueue(beef_well);
 
+    station_manager.setVerboseRouting(true);
     station_manager.processAllDishes();
 
     return 0;  